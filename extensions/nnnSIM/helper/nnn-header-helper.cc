@@ -25,6 +25,7 @@
 
 #include <iomanip>
 #include "nnn-header-helper.h"
+#include "../utils/nnn-pdu-type-tag.h"
 
 NS_LOG_COMPONENT_DEFINE ("nnn.HeaderHelper");
 
@@ -32,53 +33,62 @@ namespace ns3
 {
   namespace nnn
   {
-    NNN_PDU_TYPE
-    HeaderHelper::GetNNNHeaderType (Ptr<const Packet> packet)
+    namespace
     {
-      // Our header ID is of 32 bits
-      uint8_t type[4];
-      uint32_t read = packet->CopyData (type, 4);
+      PDUTypeTag
+      Classify (Ptr<const Packet> packet)
+      {
+	PDUTypeTag tag;
+	if (packet->PeekPacketTag (tag))
+	  return tag;
 
-      if (read != 4) throw UnknownHeaderException();
+	// PacketId (32 bits), TTL (16 bits) and Version (16 bits) of the
+	// CommonHeader, little endian as Buffer::Iterator writes them
+	uint8_t common[8];
+	uint32_t read = packet->CopyData (common, 8);
 
-      // Convert the bytes to a 32 bit unsigned integer
-      uint32_t retval = 0;
-      retval |= type[3];
-      retval <<= 8;
-      retval |= type[2];
-      retval <<= 8;
-      retval |= type[1];
-      retval <<= 8;
-      retval |= type[0];
+	if (read != 8) throw UnknownHeaderException();
 
-      NS_LOG_DEBUG (*packet);
+	uint32_t id = common[0] | (common[1] << 8) | (common[2] << 16) | (uint32_t (common[3]) << 24);
+	uint16_t version = common[6] | (common[7] << 8);
 
-      switch (retval)
-      {
-	case 0:
-	  return NULL_NNN;
-	case 1:
-	  return SO_NNN;
-	case 2:
-	  return DO_NNN;
-	case 3:
-	  return DU_NNN;
-	case 4:
-	  return EN_NNN;
-	case 5:
-	  return OEN_NNN;
-	case 6:
-	  return AEN_NNN;
-	case 7:
-	  return REN_NNN;
-	case 8:
-	  return DEN_NNN;
-	case 9:
-	  return INF_NNN;
+	NS_LOG_DEBUG ("PDU type " << id << " version " << version << " read from packet " << packet->GetUid ());
+
+	if (id > INF_NNN)
+	  throw UnknownHeaderException();
+
+	tag = PDUTypeTag (static_cast<NNN_PDU_TYPE> (id), version);
+	packet->AddPacketTag (tag);
+	return tag;
       }
+    }
 
-      NS_LOG_DEBUG (*packet);
-      throw UnknownHeaderException();
+    NNN_PDU_TYPE
+    HeaderHelper::GetNNNHeaderType (Ptr<const Packet> packet)
+    {
+      return Classify (packet).GetType ();
+    }
+
+    uint16_t
+    HeaderHelper::GetNNNHeaderVersion (Ptr<const Packet> packet)
+    {
+      return Classify (packet).GetVersion ();
+    }
+
+    Ptr<Packet>
+    HeaderHelper::TagNNNHeader (Ptr<Packet> packet, Ptr<const NNNPDU> pdu)
+    {
+      PDUTypeTag tag;
+      packet->RemovePacketTag (tag);
+      packet->AddPacketTag (PDUTypeTag (static_cast<NNN_PDU_TYPE> (pdu->GetPacketId ()), pdu->GetVersion ()));
+      return packet;
+    }
+
+    void
+    HeaderHelper::UntagNNNHeader (Ptr<Packet> packet)
+    {
+      PDUTypeTag tag;
+      packet->RemovePacketTag (tag);
     }
   } // namespace nnn
 } // namespace ns3
@@ -47,8 +47,36 @@ namespace ns3
     class HeaderHelper
     {
     public:
+      /**
+       * \brief Get the PDU type of a 3N wire packet
+       *
+       * Uses the PDUTypeTag of the packet if it has one. Otherwise the type
+       * and version are read from the first bytes of the packet in one go,
+       * and the packet is tagged with them
+       */
       static NNN_PDU_TYPE
       GetNNNHeaderType (Ptr<const Packet> packet);
+
+      /**
+       * \brief Get the version in the CommonHeader of a 3N wire packet
+       */
+      static uint16_t
+      GetNNNHeaderVersion (Ptr<const Packet> packet);
+
+      /**
+       * \brief Tag a packet just encoded from a PDU with its type and version
+       *
+       * Replaces any PDUTypeTag the payload of the PDU carried
+       */
+      static Ptr<Packet>
+      TagNNNHeader (Ptr<Packet> packet, Ptr<const NNNPDU> pdu);
+
+      /**
+       * \brief Remove the PDUTypeTag of a packet about to be decoded, so it
+       * does not stay on the payload
+       */
+      static void
+      UntagNNNHeader (Ptr<Packet> packet);
     };
 
     /**
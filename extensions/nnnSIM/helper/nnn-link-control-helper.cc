@@ -22,8 +22,6 @@
 
 #include <ns3-dev/ns3/assert.h>
 #include <ns3-dev/ns3/names.h>
-#include <ns3-dev/ns3/point-to-point-net-device.h>
-#include <ns3-dev/ns3/point-to-point-channel.h>
 #include <ns3-dev/ns3/channel.h>
 #include <ns3-dev/ns3/log.h>
 
@@ -42,44 +40,9 @@ namespace ns3
     LinkControlHelper::FailLink (Ptr<Node> node1, Ptr<Node> node2)
     {
       NS_LOG_FUNCTION (node1 << node2);
-
-      NS_ASSERT (node1 != 0);
-      NS_ASSERT (node2 != 0);
-
-      Ptr<nnn::L3Protocol> ndn1 = node1->GetObject<nnn::L3Protocol> ();
-      Ptr<nnn::L3Protocol> ndn2 = node2->GetObject<nnn::L3Protocol> ();
-
-      NS_ASSERT (ndn1 != 0);
-      NS_ASSERT (ndn2 != 0);
-
-      for (uint32_t faceId = 0; faceId < ndn1->GetNFaces (); faceId++)
-	{
-	  Ptr<nnn::NetDeviceFace> ndFace = ndn1->GetFace (faceId)->GetObject<nnn::NetDeviceFace> ();
-	  if (ndFace == 0) continue;
-
-	  Ptr<PointToPointNetDevice> nd1 = ndFace->GetNetDevice ()->GetObject<PointToPointNetDevice> ();
-	  if (nd1 == 0) continue;
-
-	  Ptr<Channel> channel = nd1->GetChannel ();
-	  if (channel == 0) continue;
-
-	  Ptr<PointToPointChannel> ppChannel = DynamicCast<PointToPointChannel> (channel);
-
-	  Ptr<NetDevice> nd2 = ppChannel->GetDevice (0);
-	  if (nd2->GetNode () == node1)
-	    nd2 = ppChannel->GetDevice (1);
-
-	  if (nd2->GetNode () == node2)
-	    {
-	      Ptr<nnn::Face> face1 = ndn1->GetFaceByNetDevice (nd1);
-	      Ptr<nnn::Face> face2 = ndn2->GetFaceByNetDevice (nd2);
-
-	      face1->SetUp (false);
-	      face2->SetUp (false);
-	      break;
-	    }
-	}
+      SetLinkUp (node1, node2, false);
     }
+
     void
     LinkControlHelper::FailLinkByName (const std::string &node1, const std::string &node2)
     {
@@ -90,7 +53,18 @@ namespace ns3
     LinkControlHelper::UpLink (Ptr<Node> node1, Ptr<Node> node2)
     {
       NS_LOG_FUNCTION (node1 << node2);
+      SetLinkUp (node1, node2, true);
+    }
 
+    void
+    LinkControlHelper::UpLinkByName (const std::string &node1, const std::string &node2)
+    {
+      UpLink (Names::Find<Node> (node1), Names::Find<Node> (node2));
+    }
+
+    void
+    LinkControlHelper::SetLinkUp (Ptr<Node> node1, Ptr<Node> node2, bool up)
+    {
       NS_ASSERT (node1 != 0);
       NS_ASSERT (node2 != 0);
 
@@ -100,41 +74,34 @@ namespace ns3
       NS_ASSERT (ndn1 != 0);
       NS_ASSERT (ndn2 != 0);
 
-      // iterate over all faces to find the right one
+      // iterate over all faces to find the right one, PointToPointNetDevice
+      // and FlexPointToPointNetDevice alike
       for (uint32_t faceId = 0; faceId < ndn1->GetNFaces (); faceId++)
 	{
 	  Ptr<nnn::NetDeviceFace> ndFace = ndn1->GetFace (faceId)->GetObject<nnn::NetDeviceFace> ();
 	  if (ndFace == 0) continue;
 
-	  Ptr<PointToPointNetDevice> nd1 = ndFace->GetNetDevice ()->GetObject<PointToPointNetDevice> ();
+	  Ptr<NetDevice> nd1 = ndFace->GetNetDevice ();
 	  if (nd1 == 0) continue;
 
 	  Ptr<Channel> channel = nd1->GetChannel ();
-	  if (channel == 0) continue;
-
-	  Ptr<PointToPointChannel> ppChannel = DynamicCast<PointToPointChannel> (channel);
+	  if (channel == 0 || channel->GetNDevices () != 2) continue;
 
-	  Ptr<NetDevice> nd2 = ppChannel->GetDevice (0);
+	  Ptr<NetDevice> nd2 = channel->GetDevice (0);
 	  if (nd2->GetNode () == node1)
-	    nd2 = ppChannel->GetDevice (1);
+	    nd2 = channel->GetDevice (1);
 
 	  if (nd2->GetNode () == node2)
 	    {
 	      Ptr<nnn::Face> face1 = ndn1->GetFaceByNetDevice (nd1);
 	      Ptr<nnn::Face> face2 = ndn2->GetFaceByNetDevice (nd2);
 
-	      face1->SetUp (true);
-	      face2->SetUp (true);
+	      face1->SetUp (up);
+	      face2->SetUp (up);
 	      break;
 	    }
 	}
     }
 
-    void
-    LinkControlHelper::UpLinkByName (const std::string &node1, const std::string &node2)
-    {
-      UpLink (Names::Find<Node> (node1), Names::Find<Node> (node2));
-    }
-
   } /* namespace nnn */
 } /* namespace ns3 */
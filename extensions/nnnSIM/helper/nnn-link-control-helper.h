@@ -45,6 +45,14 @@ namespace ns3
 
       static void
       UpLinkByName (const std::string &node1, const std::string &node2);
+
+    private:
+      /**
+       * @brief Bring up or down the Faces of both nodes on the point-to-point
+       * link between them
+       */
+      static void
+      SetLinkUp (Ptr<Node> node1, Ptr<Node> node2, bool up);
     };
 
   } /* namespace nnn */
@@ -18,6 +18,7 @@
  */
 
 #include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/trace-source-accessor.h>
 
 #include "nnn-names-container.h"
 
@@ -27,10 +28,27 @@ namespace ns3
 {
   namespace nnn
   {
+    NS_OBJECT_ENSURE_REGISTERED (NamesContainer);
+
+    TypeId
+    NamesContainer::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::NamesContainer")
+	  .SetParent<Object> ()
+	  .SetGroupName ("Nnn")
+	  .AddConstructor<NamesContainer> ()
+	  .AddTraceSource ("Entries", "Number of 3N names", MakeTraceSourceAccessor (&NamesContainer::m_entries))
+	  .AddTraceSource ("Bytes", "Approximate memory held by the 3N names", MakeTraceSourceAccessor (&NamesContainer::m_bytes))
+	  ;
+      return tid;
+    }
+
     NamesContainer::NamesContainer ()
     : renewName (MakeNullCallback <void> ())
     , hasNoName (MakeNullCallback <void> ())
     , defaultRenewal (Seconds(30))
+    , m_entries (0)
+    , m_bytes (0)
     {
     }
 
@@ -76,6 +94,7 @@ namespace ns3
 
 	  // We need to save the lease and renewal time in absolute time
 	  container.insert(NamesContainerEntry(name, lease_expire, lease_expire - defaultRenewal, fixed));
+	  UpdateSize ();
 	  if (!fixed)
 	    {
 	      // The Schedulers are in relative time
@@ -90,6 +109,7 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
       container.erase(nameEntry);
+      UpdateSize ();
     }
 
     void
@@ -102,6 +122,7 @@ namespace ns3
 	  NamesContainerEntry tmp = findEntry (name);
 
 	  container.erase(tmp);
+	  UpdateSize ();
 	}
     }
 
@@ -193,6 +214,29 @@ namespace ns3
       return container.size();
     }
 
+    void
+    NamesContainer::UpdateSize ()
+    {
+      // Entry and its 3N name, plus about three pointers of links for
+      // each of the two indexes
+      static const uint64_t entryBytes = sizeof (NamesContainerEntry) + sizeof (NNNAddress) + 6 * sizeof (void *);
+
+      m_entries = container.size ();
+      m_bytes = m_entries * entryBytes;
+    }
+
+    uint32_t
+    NamesContainer::GetEntries () const
+    {
+      return m_entries;
+    }
+
+    uint64_t
+    NamesContainer::GetBytes () const
+    {
+      return m_bytes;
+    }
+
     bool
     NamesContainer::isEmpty()
     {
@@ -27,6 +27,7 @@
 #include <ns3-dev/ns3/object.h>
 #include <ns3-dev/ns3/simulator.h>
 #include <ns3-dev/ns3/simple-ref-count.h>
+#include <ns3-dev/ns3/traced-value.h>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -75,6 +76,13 @@ namespace ns3
       typedef names_set::index<address>::type names_set_by_name;
       typedef names_set::index<lease>::type names_set_by_lease;
 
+      /**
+       * \brief Interface ID
+       *
+       * \return interface ID
+       */
+      static TypeId GetTypeId ();
+
       NamesContainer();
 
       virtual
@@ -143,9 +151,30 @@ namespace ns3
       void
       printByLease ();
 
+      /**
+       * \brief Current value of the Entries trace source
+       */
+      uint32_t
+      GetEntries () const;
+
+      /**
+       * \brief Current value of the Bytes trace source
+       */
+      uint64_t
+      GetBytes () const;
+
     private:
+      /**
+       * \brief Refresh the Entries and Bytes trace sources after a 3N name
+       * was added or removed
+       */
+      void
+      UpdateSize ();
+
       names_set container;         ///< \brief Internal structure holding the 3N names
       Time defaultRenewal;         ///< \brief Default negative default time to fire renewal callback
+      TracedValue<uint32_t> m_entries; ///< \brief Number of 3N names
+      TracedValue<uint64_t> m_bytes;   ///< \brief Approximate memory held by the 3N names
 
       Callback<void> renewName;    ///< \brief Renewal callback
       Callback<void> hasNoName;    ///< \brief Enroll callback - done when container is empty
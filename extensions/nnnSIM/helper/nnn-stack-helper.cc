@@ -78,7 +78,7 @@ namespace ns3
       m_nnnFactory.                    SetTypeId ("ns3::nnn::L3Protocol");
       m_nnnforwardingstrategyFactory.  SetTypeId ("ns3::nnn::ForwardingStrategy");
       m_nnstFactory.                   SetTypeId ("ns3::nnn::NNST");
-      m_nnptFactory.                   SetTypeId ("ns3::nnn::NNPT");
+      m_nnptFactory.                   SetTypeId ("ns3::nnn::nnpt::Ordered");
       m_contentStoreFactory.           SetTypeId ("ns3::ndn::cs::Lru");
       m_fibFactory.                    SetTypeId ("ns3::nnn::fib::Default");
       m_pitFactory.                    SetTypeId ("ns3::nnn::pit::Persistent");
@@ -179,6 +179,42 @@ namespace ns3
 	m_fibFactory.Set (attr4, StringValue (value4));
     }
 
+    void
+    NNNStackHelper::SetNnst (const std::string &nnstClass,
+                             const std::string &attr1, const std::string &value1,
+                             const std::string &attr2, const std::string &value2,
+                             const std::string &attr3, const std::string &value3,
+                             const std::string &attr4, const std::string &value4)
+    {
+      m_nnstFactory.SetTypeId (nnstClass);
+      if (attr1 != "")
+	m_nnstFactory.Set (attr1, StringValue (value1));
+      if (attr2 != "")
+	m_nnstFactory.Set (attr2, StringValue (value2));
+      if (attr3 != "")
+	m_nnstFactory.Set (attr3, StringValue (value3));
+      if (attr4 != "")
+	m_nnstFactory.Set (attr4, StringValue (value4));
+    }
+
+    void
+    NNNStackHelper::SetNnpt (const std::string &nnptClass,
+                             const std::string &attr1, const std::string &value1,
+                             const std::string &attr2, const std::string &value2,
+                             const std::string &attr3, const std::string &value3,
+                             const std::string &attr4, const std::string &value4)
+    {
+      m_nnptFactory.SetTypeId (nnptClass);
+      if (attr1 != "")
+	m_nnptFactory.Set (attr1, StringValue (value1));
+      if (attr2 != "")
+	m_nnptFactory.Set (attr2, StringValue (value2));
+      if (attr3 != "")
+	m_nnptFactory.Set (attr3, StringValue (value3));
+      if (attr4 != "")
+	m_nnptFactory.Set (attr4, StringValue (value4));
+    }
+
     Ptr<FaceContainer>
     NNNStackHelper::InstallAll () const
     {
@@ -280,6 +316,7 @@ namespace ns3
       nnn->AggregateObject (m_contentStoreFactory.Create<ndn::ContentStore> ());
 
       // Create and aggregate forwarding strategy
+      // The strategy aggregates the Limits to the Faces as they are added
       nnn->AggregateObject (m_nnnforwardingstrategyFactory.Create<ForwardingStrategy> ());
 
       // Aggregate L3Protocol on node
@@ -446,7 +483,7 @@ namespace ns3
 	  Ptr<Limits> limits = face->GetObject<Limits> ();
 	  if (limits == 0)
 	    {
-	      NS_FATAL_ERROR ("Limits are enabled, but the selected forwarding strategy does not support limits. Please revise your scenario");
+	      NS_FATAL_ERROR ("Limits are enabled, but the \"Limit\" attribute of the forwarding strategy names no Limits class. Please revise your scenario");
 	      exit (1);
 	    }
 
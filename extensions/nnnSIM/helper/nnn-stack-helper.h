@@ -132,6 +132,29 @@ namespace ns3
               const std::string &attr3 = "", const std::string &value3 = "",
               const std::string &attr4 = "", const std::string &value4 = "");
 
+      /**
+       * @brief Set NNST class and its attributes (MaxSize for example)
+       * @param nnstClass string, representing class of NNST
+       */
+      void
+      SetNnst (const std::string &nnstClass,
+               const std::string &attr1 = "", const std::string &value1 = "",
+               const std::string &attr2 = "", const std::string &value2 = "",
+               const std::string &attr3 = "", const std::string &value3 = "",
+               const std::string &attr4 = "", const std::string &value4 = "");
+
+      /**
+       * @brief Set NNPT class and its attributes (MaxSize for example)
+       * @param nnptClass string, representing class of NNPT
+       * ("ns3::nnn::nnpt::Ordered", the default, or "ns3::nnn::nnpt::Hashed")
+       */
+      void
+      SetNnpt (const std::string &nnptClass,
+               const std::string &attr1 = "", const std::string &value1 = "",
+               const std::string &attr2 = "", const std::string &value2 = "",
+               const std::string &attr3 = "", const std::string &value3 = "",
+               const std::string &attr4 = "", const std::string &value4 = "");
+
       typedef Callback< Ptr<NetDeviceFace>, Ptr<Node>, Ptr<L3Protocol>, Ptr<NetDevice> > NetDeviceFaceCreateCallback;
 
       /**
@@ -166,6 +189,11 @@ namespace ns3
       /**
        * @brief Enable Interest limits (disabled by default)
        *
+       * Faces get the Limits class given by the "Limit" attribute of the forwarding
+       * strategy, which has to be set (e.g. ns3::nnn::Limits::Window). Use
+       * ns3::nnn::Limits::Mobility for limits that adapt to handoffs, buffered PDUs
+       * and NNST status
+       *
        * @param enable           Enable or disable limits
        * @param avgRtt           Average RTT
        * @param avgData Average size of contentObject packets (including all headers)
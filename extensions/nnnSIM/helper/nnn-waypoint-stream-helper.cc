@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-stream-helper.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-stream-helper.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-stream-helper.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ns3-dev/ns3/assert.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/node-list.h>
+
+#include "nnn-waypoint-stream-helper.h"
+
+#include "../utils/mobility/nnn-waypoint-stream-mobility-model.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.WaypointStreamHelper");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    WaypointStreamHelper::WaypointStreamHelper (const std::string &filename)
+    : m_trace (Create<WaypointTrace> (filename))
+    {
+    }
+
+    void
+    WaypointStreamHelper::Install () const
+    {
+      for (uint32_t i = 0; i < m_trace->GetNNodes (); i++)
+	{
+	  const waypoint::FileNode &entry = m_trace->GetNode (i);
+	  if (entry.m_node >= NodeList::GetNNodes ())
+	    {
+	      NS_LOG_WARN ("Trace node " << entry.m_node << " does not exist in the simulation");
+	      continue;
+	    }
+	  Install (NodeList::GetNode (entry.m_node), entry.m_node);
+	}
+    }
+
+    void
+    WaypointStreamHelper::Install (const NodeContainer &c) const
+    {
+      for (uint32_t i = 0; i < c.GetN (); i++)
+	{
+	  Install (c.Get (i), i);
+	}
+    }
+
+    void
+    WaypointStreamHelper::Install (Ptr<Node> node, uint32_t traceNode) const
+    {
+      NS_ASSERT (node != 0);
+
+      const waypoint::FileNode *entry = m_trace->FindNode (traceNode);
+      if (entry == 0)
+	{
+	  NS_LOG_WARN ("Node " << traceNode << " is not in the waypoint trace");
+	  return;
+	}
+
+      Ptr<WaypointStreamMobilityModel> model = node->GetObject<WaypointStreamMobilityModel> ();
+      if (model == 0)
+	{
+	  NS_ASSERT_MSG (node->GetObject<MobilityModel> () == 0,
+	                 "Node " << node->GetId () << " already has a different mobility model");
+	  model = CreateObject<WaypointStreamMobilityModel> ();
+	  node->AggregateObject (model);
+	}
+
+      model->SetTrace (m_trace, *entry);
+    }
+  } // namespace nnn
+} // namespace ns3
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-stream-helper.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-stream-helper.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-stream-helper.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_WAYPOINT_STREAM_HELPER_H_
+#define NNN_WAYPOINT_STREAM_HELPER_H_
+
+#include <string>
+
+#include <ns3-dev/ns3/node-container.h>
+#include <ns3-dev/ns3/ptr.h>
+
+#include "../utils/mobility/nnn-waypoint-trace.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * \ingroup nnn-helpers
+     * \brief Installs WaypointStreamMobilityModel from a compiled waypoint file
+     *
+     * Drop in replacement for ns3::Ns2MobilityHelper when the ns-2 trace has
+     * been compiled with random/ns2-waypoint-compiler. The file is mapped
+     * once and shared by all the installed models.
+     */
+    class WaypointStreamHelper
+    {
+    public:
+      /**
+       * \param filename Compiled waypoint file
+       */
+      WaypointStreamHelper (const std::string &filename);
+
+      /**
+       * \brief Install on the nodes of the NodeList, node i of the trace
+       * goes to the node with id i (same as Ns2MobilityHelper::Install)
+       */
+      void
+      Install () const;
+
+      /**
+       * \brief Install on the nodes of the container, node i of the trace
+       * goes to the i-th node of the container
+       */
+      void
+      Install (const NodeContainer &c) const;
+
+      /**
+       * \brief Install the waypoints of trace node traceNode on node
+       */
+      void
+      Install (Ptr<Node> node, uint32_t traceNode) const;
+
+    private:
+      Ptr<WaypointTrace> m_trace;
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* NNN_WAYPOINT_STREAM_HELPER_H_ */
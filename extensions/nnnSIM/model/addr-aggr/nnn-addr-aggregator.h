@@ -31,10 +31,12 @@ namespace ns3
     class NNNAddrEntry : public Object
     {
     public:
+      // One trie per PIT incoming face is too small to pay for slab pages
       typedef nnnSIM::trie_with_policy<
 	  NNNAddress,
 	  nnnSIM::smart_pointer_payload_traits<NNNAddrEntry>,
-	  nnnSIM::counting_policy_traits
+	  nnnSIM::counting_policy_traits,
+	  nnnSIM::trie_heap_allocator
 	  > trie;
 
       struct PtrNNNComp
@@ -148,6 +150,23 @@ namespace ns3
 	return (m_addresses.find(addr) != m_addresses.end());
       }
 
+      typedef std::set<Ptr<NNNAddress>, PtrNNNComp>::const_iterator label_iterator;
+
+      /**
+       * \brief Iterate over the last labels stored for the sector, without copies
+       */
+      label_iterator
+      LabelsBegin () const
+      {
+	return m_addresses.begin ();
+      }
+
+      label_iterator
+      LabelsEnd () const
+      {
+	return m_addresses.end ();
+      }
+
       trie::iterator
       to_iterator () { return item_; }
 
@@ -165,14 +184,16 @@ namespace ns3
     protected nnnSIM::trie_with_policy<
     NNNAddress,
     nnnSIM::smart_pointer_payload_traits<NNNAddrEntry>,
-    nnnSIM::counting_policy_traits
+    nnnSIM::counting_policy_traits,
+    nnnSIM::trie_heap_allocator
     >
     {
     public:
       typedef nnnSIM::trie_with_policy<
 	  NNNAddress,
 	  nnnSIM::smart_pointer_payload_traits<NNNAddrEntry>,
-	  nnnSIM::counting_policy_traits
+	  nnnSIM::counting_policy_traits,
+	  nnnSIM::trie_heap_allocator
       > super;
 
       struct PtrNNNComp
@@ -231,6 +252,25 @@ namespace ns3
       Ptr<const NNNAddrEntry>
       Next (Ptr<const NNNAddrEntry> from) const;
 
+      /**
+       * \brief Call visitor (sector, label) for every aggregated 3N name
+       *
+       * Unlike GetTotalDestinations, no complete 3N names are created
+       */
+      template<class Visitor>
+      void
+      VisitDestinations (Visitor &visitor) const
+      {
+	for (Ptr<const NNNAddrEntry> tmp = Begin (); tmp != End (); tmp = Next (tmp))
+	  {
+	    const NNNAddress &sector = *tmp->GetSector ();
+	    for (NNNAddrEntry::label_iterator i = tmp->LabelsBegin (); i != tmp->LabelsEnd (); ++i)
+	      {
+		visitor (sector, **i);
+	      }
+	  }
+      }
+
     private:
       uint16_t m_totaladdr;
       uint16_t m_totaldest;
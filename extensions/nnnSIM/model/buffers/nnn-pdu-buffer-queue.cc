@@ -27,6 +27,7 @@ namespace ns3
   {
 
     PDUQueue::PDUQueue ()
+    : m_bytes (0)
     {
     }
 
@@ -46,6 +47,7 @@ namespace ns3
       std::queue<std::pair<Time, Ptr<Packet> > > empty;
 
       std::swap(buffer, empty);
+      m_bytes = 0;
     }
 
     Ptr<Packet>
@@ -53,6 +55,7 @@ namespace ns3
     {
       Ptr<Packet> tmp = buffer.front ().second;
       buffer.pop();
+      m_bytes -= tmp->GetSize ();
       return tmp;
     }
 
@@ -60,24 +63,25 @@ namespace ns3
     PDUQueue::push (Ptr<Packet> pdu, Time retx)
     {
       buffer.push (std::make_pair((Simulator::Now () + retx), pdu));
+      m_bytes += pdu->GetSize ();
     }
 
     void
     PDUQueue::pushSO (Ptr<const SO> so_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromSO(so_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDO (Ptr<const DO> do_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromDO(do_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     void
     PDUQueue::pushDU (Ptr<const DU> du_p, Time retx)
     {
-      buffer.push(std::make_pair((Simulator::Now () + retx), Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM)));
+      push (Wire::FromDU(du_p, Wire::WIRE_FORMAT_NNNSIM), retx);
     }
 
     std::queue<std::pair<Time, Ptr<Packet> > >
@@ -92,5 +96,11 @@ namespace ns3
       return buffer.size();
     }
 
+    uint32_t
+    PDUQueue::GetBytes () const
+    {
+      return m_bytes;
+    }
+
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -64,8 +64,15 @@ namespace ns3
       uint
       size ();
 
+      /**
+       * \brief Bytes of all the PDUs in the queue, as they were encoded
+       */
+      uint32_t
+      GetBytes () const;
+
     private:
       std::queue<std::pair<Time,Ptr<Packet> > > buffer;
+      uint32_t m_bytes; ///< \brief Bytes of all the PDUs in buffer
     };
 
   } /* namespace nnn */
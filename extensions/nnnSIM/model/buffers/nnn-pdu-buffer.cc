@@ -34,17 +34,31 @@ namespace ns3
       static TypeId tid = TypeId ("ns3::nnn::PacketBuffer")
         	.SetParent<Object> ()
 		.AddConstructor<PDUBuffer> ()
+		.AddTraceSource ("Buffered", "Number of PDUs held for all the NNNAddresses",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_buffered))
+		.AddTraceSource ("Entries", "Number of NNNAddresses with a queue",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_entries))
+		.AddTraceSource ("Bytes", "Approximate memory held by the queues and their PDUs",
+		                 MakeTraceSourceAccessor (&PDUBuffer::m_bytes))
 		;
       return tid;
     }
 
     PDUBuffer::PDUBuffer ()
     : m_retx (MilliSeconds (50))
+    , m_buffered (0)
+    , m_entries (0)
+    , m_bytes (0)
+    , m_pduBytes (0)
     {
     }
 
     PDUBuffer::PDUBuffer (Time retx)
     : m_retx (retx)
+    , m_buffered (0)
+    , m_entries (0)
+    , m_bytes (0)
+    , m_pduBytes (0)
     {
     }
 
@@ -68,6 +82,7 @@ namespace ns3
 	      NS_LOG_INFO("New buffer for : " << addr);
 
 	      result.first->set_payload(Create<PDUQueue> ());
+	      UpdateSize ();
 	    }
 	}
     }
@@ -89,7 +104,14 @@ namespace ns3
 
       if (item != super::end ())
 	{
+	  if (item->payload () != 0)
+	    {
+	      m_buffered -= item->payload ()->size ();
+	      m_pduBytes -= item->payload ()->GetBytes ();
+	    }
+
 	  super::erase(item);
+	  UpdateSize ();
 	}
     }
 
@@ -111,7 +133,7 @@ namespace ns3
     bool
     PDUBuffer::DestinationExists (Ptr<NNNAddress> addr)
     {
-      DestinationExists (*addr);
+      return DestinationExists (*addr);
     }
 
     void
@@ -128,7 +150,11 @@ namespace ns3
 	  NS_LOG_INFO("PushPDU SO, found " << addr << " inserting");
 	  Ptr<PDUQueue> tmp = item->payload();
 
+	  uint32_t before = tmp->GetBytes ();
 	  tmp->pushSO(so_p, m_retx);
+	  m_buffered++;
+	  m_pduBytes += tmp->GetBytes () - before;
+	  UpdateSize ();
 	}
     }
 
@@ -152,7 +178,11 @@ namespace ns3
 	  NS_LOG_INFO("PushPDU DO, found " << addr << " inserting");
 	  Ptr<PDUQueue> tmp = item->payload();
 
+	  uint32_t before = tmp->GetBytes ();
 	  tmp->pushDO(do_p, m_retx);
+	  m_buffered++;
+	  m_pduBytes += tmp->GetBytes () - before;
+	  UpdateSize ();
 	}
     }
 
@@ -176,7 +206,11 @@ namespace ns3
 	  NS_LOG_INFO("PushPDU DU, found " << addr << " inserting");
 	  Ptr<PDUQueue> tmp = item->payload();
 
+	  uint32_t before = tmp->GetBytes ();
 	  tmp->pushDU(du_p, m_retx);
+	  m_buffered++;
+	  m_pduBytes += tmp->GetBytes () - before;
+	  UpdateSize ();
 	}
     }
 
@@ -297,5 +331,35 @@ namespace ns3
     {
       return m_retx;
     }
+
+    uint32_t
+    PDUBuffer::GetBuffered () const
+    {
+      return m_buffered;
+    }
+
+    void
+    PDUBuffer::UpdateSize ()
+    {
+      // Trie node, queue and 3N name for each destination, a queue slot
+      // and a Packet for each PDU, plus the encoded PDUs themselves
+      static const uint64_t destinationBytes = sizeof (super::parent_trie) + sizeof (PDUQueue) + sizeof (NNNAddress);
+      static const uint64_t pduBytes = sizeof (std::pair<Time, Ptr<Packet> >) + sizeof (Packet);
+
+      m_entries = super::getPolicy ().size ();
+      m_bytes = m_entries * destinationBytes + m_buffered * pduBytes + m_pduBytes;
+    }
+
+    uint32_t
+    PDUBuffer::GetEntries () const
+    {
+      return m_entries;
+    }
+
+    uint64_t
+    PDUBuffer::GetBytes () const
+    {
+      return m_bytes;
+    }
   } /* namespace nnn */
 } /* namespace ns3 */
@@ -178,14 +178,43 @@ namespace ns3
       uint
       QueueSize (Ptr<NNNAddress> addr);
 
+      /**
+       *  \brief get the number of PDUs held for all the NNNAddresses
+       */
+      uint32_t
+      GetBuffered () const;
+
       void
       SetReTX (Time rtx);
 
       Time
       GetReTX () const;
 
+      /**
+       * \brief Current value of the Entries trace source
+       */
+      uint32_t
+      GetEntries () const;
+
+      /**
+       * \brief Current value of the Bytes trace source
+       */
+      uint64_t
+      GetBytes () const;
+
     private:
+      /**
+       * \brief Refresh the Entries and Bytes trace sources after a
+       * destination or a PDU was added or removed
+       */
+      void
+      UpdateSize ();
+
       Time m_retx;
+      TracedValue<uint32_t> m_buffered; ///< \brief Number of PDUs held for all the NNNAddresses
+      TracedValue<uint32_t> m_entries;  ///< \brief Number of NNNAddresses with a queue
+      TracedValue<uint64_t> m_bytes;    ///< \brief Approximate memory held by the queues and their PDUs
+      uint64_t m_pduBytes;              ///< \brief Bytes of the encoded PDUs held for all the NNNAddresses
     };
 
     std::ostream& operator<< (std::ostream& os, const PDUBuffer &buffer);
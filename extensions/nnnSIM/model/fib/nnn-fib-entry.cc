@@ -36,6 +36,7 @@ namespace ll = boost::lambda;
 
 #include "nnn-fib.h"
 #include "nnn-fib-entry.h"
+#include "nnn-fib-impl.h"
 
 NS_LOG_COMPONENT_DEFINE ("nnn.fib.Entry");
 
@@ -185,6 +186,17 @@ namespace ns3
 	return m_faces.get<i_nth> () [skip];
       }
 
+      void
+      Entry::RemoveFace (const Ptr<Face> &face)
+      {
+	m_faces.erase (face);
+
+	// Keep the Face index of the FIB in step
+	Ptr<FibImpl> fib = DynamicCast<FibImpl> (m_fib);
+	if (fib != 0)
+	  fib->Unindex (this, face);
+      }
+
       Ptr<Fib>
       Entry::GetFib ()
       {
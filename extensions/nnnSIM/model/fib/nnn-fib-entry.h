@@ -333,10 +333,7 @@ namespace ns3
 	 * @brief Remove record associated with `face`
 	 */
 	void
-	RemoveFace (const Ptr<Face> &face)
-	{
-	  m_faces.erase (face);
-	}
+	RemoveFace (const Ptr<Face> &face);
 
 	/**
 	 * @brief Get pointer to access FIB, to which this entry is added
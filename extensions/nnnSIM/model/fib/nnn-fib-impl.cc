@@ -71,6 +71,7 @@ namespace ns3
       void
       FibImpl::DoDispose (void)
       {
+	m_faceIndex.clear ();
 	clear ();
 	Object::DoDispose ();
       }
@@ -124,6 +125,7 @@ namespace ns3
 
 	    super::modify (result.first,
 			   ll::bind (&Entry::AddOrUpdateRoutingMetric, ll::_1, face, metric));
+	    m_faceIndex[face->GetId ()].insert (result.first->payload ());
 
 	    if (result.second)
 	      {
@@ -150,6 +152,10 @@ namespace ns3
 	    NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	    //this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (fibEntry->payload ());
 
+	    Ptr<Entry> entry = fibEntry->payload ();
+	    for (FaceMetricContainer::type::iterator it = entry->m_faces.begin (); it != entry->m_faces.end (); ++it)
+	      Unindex (entry, it->GetFace ());
+
 	    super::erase (fibEntry);
 	  }
 	// else do nothing
@@ -197,29 +203,43 @@ namespace ns3
 		       ll::bind (&Entry::RemoveFace, ll::_1, face));
       }
 
+      void
+      FibImpl::Unindex (Ptr<Entry> entry, Ptr<Face> face)
+      {
+	face_index::iterator idx = m_faceIndex.find (face->GetId ());
+	if (idx == m_faceIndex.end ())
+	  return;
+
+	idx->second.erase (entry);
+	if (idx->second.empty ())
+	  m_faceIndex.erase (idx);
+      }
+
       void
       FibImpl::RemoveFromAll (Ptr<Face> face)
       {
 	NS_LOG_FUNCTION (this);
 
-	Ptr<Entry> entry = Begin ();
-	while (entry != End ())
+	face_index::iterator idx = m_faceIndex.find (face->GetId ());
+	if (idx == m_faceIndex.end ())
+	  return;
+
+	// Only the entries that use the Face need to be visited
+	std::set<Ptr<Entry> > entries;
+	entries.swap (idx->second);
+	m_faceIndex.erase (idx);
+
+	for (std::set<Ptr<Entry> >::iterator it = entries.begin (); it != entries.end (); ++it)
 	  {
+	    Ptr<Entry> entry = *it;
 	    entry->RemoveFace (face);
 	    if (entry->m_faces.size () == 0)
 	      {
-		Ptr<Entry> nextEntry = Next (entry);
-
 		// notify forwarding strategy about soon be removed FIB entry
 		NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 		//this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
 
 		super::erase (StaticCast<EntryImpl> (entry)->to_iterator ());
-		entry = nextEntry;
-	      }
-	    else
-	      {
-		entry = Next (entry);
 	      }
 	  }
       }
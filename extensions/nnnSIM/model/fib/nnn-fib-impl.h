@@ -25,6 +25,9 @@
 
 #include "nnn-fib.h"
 
+#include <map>
+#include <set>
+
 #include <ns3-dev/ns3/name.h>
 #include <ns3-dev/ns3/ndnSIM/utils/trie/trie-with-policy.h>
 #include <ns3-dev/ns3/ndnSIM/utils/trie/counting-policy.h>
@@ -150,6 +153,19 @@ namespace ns3
 	 */
 	void
 	RemoveFace (super::parent_trie &item, Ptr<Face> face);
+
+	/**
+	 * @brief Drop the entry from the index of the Face, once the Face is no longer one of its next hops
+	 */
+	void
+	Unindex (Ptr<Entry> entry, Ptr<Face> face);
+
+	friend class Entry;
+
+      private:
+	typedef std::map<uint32_t, std::set<Ptr<Entry> > > face_index;
+
+	face_index m_faceIndex; ///< @brief Entries using a Face, by Face id, so RemoveFromAll only visits those
       };
 
     } // namespace fib
@@ -42,6 +42,8 @@
 #include "../../helper/nnn-names-container.h"
 #include "../../helper/nnn-face-container.h"
 #include "../buffers/nnn-pdu-buffer.h"
+#include "../../utils/nnn-limits.h"
+#include "../../utils/mobility/nnn-handoff-predictor.h"
 #include "../addr-aggr/nnn-addr-aggregator.h"
 #include "../../helper/nnn-header-helper.h"
 
@@ -67,12 +69,14 @@
 #include <ns3-dev/ns3/log.h>
 #include <ns3-dev/ns3/node.h>
 #include <ns3-dev/ns3/object-base.h>
+#include <ns3-dev/ns3/object-factory.h>
 #include <ns3-dev/ns3/ptr.h>
 #include <ns3-dev/ns3/simulator.h>
 #include <ns3-dev/ns3/string.h>
 #include <ns3-dev/ns3/type-id.h>
 #include <ns3-dev/ns3/trace-source-accessor.h>
 #include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/uinteger.h>
 
 #include <sys/types.h>
 #include <unistd.h>
@@ -248,6 +252,30 @@ namespace ns3
 	                 MakeTimeAccessor (&ForwardingStrategy::GetRetxTimer, &ForwardingStrategy::SetRetxTimer),
 	                 MakeTimeChecker ())
 
+	  .AddAttribute ("AwaitingResponseMaxSize",
+	                 "Maximum number of 3N names waiting for a lease acknowledgement (Only in use if Produce3Nnames is used). If 0, limit is not enforced",
+	                 UintegerValue (0),
+	                 MakeUintegerAccessor (&ForwardingStrategy::GetAwaitingResponseMaxSize, &ForwardingStrategy::SetAwaitingResponseMaxSize),
+	                 MakeUintegerChecker<uint32_t> ())
+
+	  .AddAttribute ("CompactSignalling",
+	                 "Send the EN, AEN, REN, DEN, OEN and INF PDUs this node creates as version B_NNN, with compact PoA lists and names. Nodes decode both versions",
+	                 BooleanValue (false),
+	                 MakeBooleanAccessor (&ForwardingStrategy::m_compactSignalling),
+	                 MakeBooleanChecker ())
+
+	  .AddAttribute ("BufferMigration",
+	                 "When a node leaving this access router predicts its next sector in the DEN, tunnel the PDUs for it to that sector instead of buffering them here",
+	                 BooleanValue (false),
+	                 MakeBooleanAccessor (&ForwardingStrategy::m_bufferMigration),
+	                 MakeBooleanChecker ())
+
+	  .AddAttribute ("Limit",
+	                 "Limits class aggregated to every non application Face added (e.g. ns3::nnn::Limits::Mobility). If empty, Faces are not limited",
+	                 StringValue (""),
+	                 MakeStringAccessor (&ForwardingStrategy::m_limitsClass),
+	                 MakeStringChecker ())
+
 	  .AddTraceSource ("Got3NName", "Traces when the forwarding strategy has a 3N name",
 			   MakeTraceSourceAccessor (&ForwardingStrategy::m_got3Nname))
 
@@ -263,9 +291,9 @@ namespace ns3
     ForwardingStrategy::ForwardingStrategy ()
     : m_awaiting_response    (Create<NNST> ())
     , m_faces                (Create<FaceContainer> ())
-    , m_node_names           (Create<NamesContainer> ())
-    , m_leased_names         (Create<NamesContainer> ())
-    , m_node_pdu_buffer      (Create<PDUBuffer> ())
+    , m_node_names           (CreateObject<NamesContainer> ())
+    , m_leased_names         (CreateObject<NamesContainer> ())
+    , m_node_pdu_buffer      (CreateObject<PDUBuffer> ())
     , m_producedNameNumber   (0)
     , m_sent_ren             (false)
     , m_on_ren_oen           (false)
@@ -275,6 +303,11 @@ namespace ns3
 	  MakeCallback (&ForwardingStrategy::Enroll, this)
       );
 
+      // Limits on the Faces react to PDUs held for moving nodes
+      if (!m_node_pdu_buffer->TraceConnectWithoutContext ("Buffered",
+	  MakeCallback (&ForwardingStrategy::NotifyBufferOccupancy, this)))
+	NS_FATAL_ERROR ("Could not connect to the \"Buffered\" trace source of the PDUBuffer");
+
       // This forces the seconds to be printed in non-scientific notation
       NS_LOG_INFO (std::fixed);
     }
@@ -306,6 +339,12 @@ namespace ns3
       return m_node_names->findNewestName();
     }
 
+    uint16_t
+    ForwardingStrategy::GetSignallingVersion () const
+    {
+      return m_compactSignalling ? B_NNN : A_NNN;
+    }
+
     Ptr<NNNAddress>
     ForwardingStrategy::produce3NName ()
     {
@@ -376,6 +415,18 @@ namespace ns3
       return m_node_pdu_buffer->GetReTX();
     }
 
+    void
+    ForwardingStrategy::SetAwaitingResponseMaxSize (uint32_t maxSize)
+    {
+      m_awaiting_response->SetMaxSize (maxSize);
+    }
+
+    uint32_t
+    ForwardingStrategy::GetAwaitingResponseMaxSize () const
+    {
+      return m_awaiting_response->GetMaxSize ();
+    }
+
     void
     ForwardingStrategy::flushBuffer(Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName)
     {
@@ -395,10 +446,9 @@ namespace ns3
 	  uint32_t do_flush = 0;
 	  uint32_t du_flush = 0;
 
-	  std::pair<Ptr<Face>, Address> closestSector;
+	  const nnst::FaceMetric *closestSector;
 
 	  Ptr<Face> outFace;
-	  Address destAddr;
 
 	  while (!addrQueue.empty())
 	    {
@@ -417,13 +467,19 @@ namespace ns3
 		  do_o_orig->SetName(newName);
 
 		  // Find where to send the SO
-		  closestSector = m_nnst->ClosestSectorFaceInfo(newName, 0);
+		  closestSector = m_nnst->ClosestSectorNextHop(*newName, 0);
+
+		  if (closestSector == 0)
+		    {
+		      NS_LOG_INFO ("On (" << myAddr << ") no route to (" << *newName << "), dropping DO");
+		      m_dropDOs (do_o_orig, face);
+		      break;
+		    }
 
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
+		  outFace = closestSector->GetFace ();
 
 		  // Send the created DO PDU
-		  outFace->SendDO(do_o_orig, destAddr);
+		  outFace->SendDO(do_o_orig, closestSector->GetAddress ());
 		  // Log the DO sending
 		  m_outDOs(do_o_orig, outFace);
 		  do_flush++;
@@ -443,13 +499,19 @@ namespace ns3
 		    du_o_orig->SetSrcName(newName);
 
 		  // Find where to send the DU
-		  closestSector = m_nnst->ClosestSectorFaceInfo(du_o_orig->GetDstNamePtr(), 0);
+		  closestSector = m_nnst->ClosestSectorNextHop(du_o_orig->GetDstName(), 0);
+
+		  if (closestSector == 0)
+		    {
+		      NS_LOG_INFO ("On (" << myAddr << ") no route to (" << du_o_orig->GetDstName() << "), dropping DU");
+		      m_dropDUs (du_o_orig, face);
+		      break;
+		    }
 
-		  outFace = closestSector.first;
-		  destAddr = closestSector.second;
+		  outFace = closestSector->GetFace ();
 
 		  // Send the created DU PDU
-		  outFace->SendDU(du_o_orig, destAddr);
+		  outFace->SendDU(du_o_orig, closestSector->GetAddress ());
 		  // Log the DU sending
 		  m_outDUs(du_o_orig, outFace);
 		  du_flush++;
@@ -472,6 +534,246 @@ namespace ns3
 	}
     }
 
+    void
+    ForwardingStrategy::MigrateBuffer (Ptr<Face> face, Ptr<DEN> den_p)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      NNNAddress myAddr = GetNode3NName ();
+      Ptr<NNNAddress> leavingAddr = Create<NNNAddress> (den_p->GetName ());
+      NNNAddress nextSector = den_p->GetNextSector ();
+
+      if (m_node_names->foundName (den_p->GetNextSectorPtr ()))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") (" << *leavingAddr << ") is predicted to attach here, buffering");
+	  m_node_pdu_buffer->AddDestination (leavingAddr);
+	  return;
+	}
+
+      const nnst::FaceMetric *closestSector = m_nnst->ClosestSectorNextHop (nextSector, 0);
+
+      if (closestSector == 0)
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") no route to (" << nextSector << "), dropping DEN");
+	  m_dropDENs (den_p, face);
+
+	  // The access router the node left holds its PDUs as if there was no prediction
+	  if (leavingAddr->getSectorName () == myAddr)
+	    {
+	      PropagateDEN (den_p, *leavingAddr);
+	      m_node_pdu_buffer->AddDestination (leavingAddr);
+	    }
+	  return;
+	}
+
+      // Only the access router the node left tunnels, the rest route the DEN
+      if (leavingAddr->getSectorName () == myAddr)
+	{
+	  m_migrations[*leavingAddr] = nextSector;
+	  Simulator::Schedule (m_3n_lease_time, &ForwardingStrategy::EndMigration, this, *leavingAddr);
+	}
+
+      Ptr<Face> outFace = closestSector->GetFace ();
+
+      // The DEN goes first, so the PDUs find the buffer ready
+      if (outFace->SendDEN (den_p, closestSector->GetAddress ()))
+	m_outDENs (den_p, outFace);
+      else
+	m_dropDENs (den_p, outFace);
+
+      // Anything already held for the node follows
+      if (m_node_pdu_buffer->DestinationExists (leavingAddr))
+	{
+	  std::queue<Ptr<Packet> > addrQueue = m_node_pdu_buffer->PopQueue (leavingAddr);
+	  m_node_pdu_buffer->RemoveDestination (leavingAddr);
+
+	  while (!addrQueue.empty ())
+	    {
+	      Migrate (*leavingAddr, addrQueue.front ());
+	      addrQueue.pop ();
+	    }
+	}
+    }
+
+    bool
+    ForwardingStrategy::MigrateDO (const NNNAddress &addr, Ptr<const DO> do_p)
+    {
+      if (m_migrations.find (addr) == m_migrations.end ())
+	return false;
+
+      if (!Migrate (addr, Wire::FromDO (do_p)))
+	{
+	  // No route to the predicted sector, hold the DO here instead
+	  m_node_pdu_buffer->AddDestination (addr);
+	  m_node_pdu_buffer->PushDO (addr, do_p);
+	}
+      return true;
+    }
+
+    bool
+    ForwardingStrategy::MigrateDU (const NNNAddress &addr, Ptr<const DU> du_p)
+    {
+      if (m_migrations.find (addr) == m_migrations.end ())
+	return false;
+
+      if (!Migrate (addr, Wire::FromDU (du_p)))
+	{
+	  // No route to the predicted sector, hold the DU here instead
+	  m_node_pdu_buffer->AddDestination (addr);
+	  m_node_pdu_buffer->PushDU (addr, du_p);
+	}
+      return true;
+    }
+
+    bool
+    ForwardingStrategy::Migrate (const NNNAddress &addr, Ptr<Packet> pdu)
+    {
+      NS_LOG_FUNCTION (this << addr);
+
+      std::map<NNNAddress, NNNAddress>::iterator migration = m_migrations.find (addr);
+      if (migration == m_migrations.end ())
+	return false;
+
+      const nnst::FaceMetric *closestSector = m_nnst->ClosestSectorNextHop (migration->second, 0);
+
+      if (closestSector == 0)
+	{
+	  NS_LOG_INFO ("On (" << GetNode3NName () << ") no route to (" << migration->second << "), not migrating PDU for (" << addr << ")");
+	  return false;
+	}
+
+      NS_LOG_INFO ("On (" << GetNode3NName () << ") migrating PDU for (" << addr << ") to (" << migration->second << ")");
+
+      // The encoded PDU travels as the payload of a DU to the predicted sector
+      Ptr<DU> du_o = Create<DU> ();
+      du_o->SetSrcName (GetNode3NName ());
+      du_o->SetDstName (migration->second);
+      du_o->SetLifetime (m_3n_lifetime);
+      du_o->SetPayload (pdu);
+      du_o->SetPDUPayloadType (NNN_NNN);
+
+      Ptr<Face> outFace = closestSector->GetFace ();
+
+      if (outFace->SendDU (du_o, closestSector->GetAddress ()))
+	m_outDUs (du_o, outFace);
+      else
+	m_dropDUs (du_o, outFace);
+
+      return true;
+    }
+
+    void
+    ForwardingStrategy::EndMigration (NNNAddress addr)
+    {
+      NS_LOG_FUNCTION (this << addr);
+      m_migrations.erase (addr);
+    }
+
+    void
+    ForwardingStrategy::OnMigratedPDU (Ptr<Face> face, Ptr<DU> du_p)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      NNNAddress myAddr = GetNode3NName ();
+
+      if (!m_node_names->foundName (du_p->GetDstNamePtr ()))
+	{
+	  const nnst::FaceMetric *closestSector = m_nnst->ClosestSectorNextHop (du_p->GetDstName (), 0);
+
+	  if (closestSector == 0)
+	    {
+	      NS_LOG_INFO ("On (" << myAddr << ") no route to (" << du_p->GetDstName () << "), dropping migrated PDU");
+	      m_dropDUs (du_p, face);
+	      return;
+	    }
+
+	  Ptr<Face> outFace = closestSector->GetFace ();
+
+	  if (outFace->SendDU (du_p, closestSector->GetAddress ()))
+	    m_outDUs (du_p, outFace);
+	  else
+	    m_dropDUs (du_p, outFace);
+	  return;
+	}
+
+      Ptr<Packet> pdu = du_p->GetPayload ()->Copy ();
+      Ptr<NNNAddress> dest;
+      Ptr<DO> do_i;
+      Ptr<DU> du_i;
+
+      switch (HeaderHelper::GetNNNHeaderType (pdu))
+      {
+	case DO_NNN:
+	  do_i = wire::nnnSIM::DO::FromWire (pdu);
+	  dest = Create<NNNAddress> (do_i->GetName ());
+	  m_node_pdu_buffer->AddDestination (dest);
+	  m_node_pdu_buffer->PushDO (dest, do_i);
+	  break;
+	case DU_NNN:
+	  du_i = wire::nnnSIM::DU::FromWire (pdu);
+	  dest = Create<NNNAddress> (du_i->GetDstName ());
+	  m_node_pdu_buffer->AddDestination (dest);
+	  m_node_pdu_buffer->PushDU (dest, du_i);
+	  break;
+	default:
+	  NS_LOG_INFO ("Obtained unknown PDU");
+	  return;
+      }
+
+      NS_LOG_INFO ("On (" << myAddr << ") holding PDU for (" << *dest << ") migrated from (" << du_p->GetSrcName () << ")");
+
+      // The node may have arrived before its PDUs
+      if (m_nnpt->foundOldName (dest))
+	flushBuffer (face, dest, Create<NNNAddress> (m_nnpt->findPairedName (dest)));
+    }
+
+    Ptr<PDUBuffer>
+    ForwardingStrategy::GetPDUBuffer () const
+    {
+      return m_node_pdu_buffer;
+    }
+
+    Ptr<NamesContainer>
+    ForwardingStrategy::GetNodeNames () const
+    {
+      return m_node_names;
+    }
+
+    Ptr<NamesContainer>
+    ForwardingStrategy::GetLeasedNames () const
+    {
+      return m_leased_names;
+    }
+
+    void
+    ForwardingStrategy::NotifyBufferOccupancy (uint32_t oldValue, uint32_t newValue)
+    {
+      for (FaceContainer::Iterator i = m_faces->Begin (); i != m_faces->End (); ++i)
+	{
+	  Ptr<Limits> limits = (*i)->GetObject<Limits> ();
+	  if (limits != 0)
+	    limits->NotifyBufferOccupancy (newValue);
+	}
+    }
+
+    void
+    ForwardingStrategy::NotifyHandoff (Ptr<Face> face)
+    {
+      Ptr<Limits> limits = face->GetObject<Limits> ();
+      if (limits != 0)
+	limits->NotifyHandoff ();
+    }
+
+    Ptr<Limits>
+    ForwardingStrategy::GetEnforcedLimits (Ptr<Face> face) const
+    {
+      // Limits aggregated by anything else than the "Limit" attribute are not enforced
+      if (m_limitsClass.empty ())
+	return 0;
+
+      return face->GetObject<Limits> ();
+    }
+
     void
     ForwardingStrategy::OnEN (Ptr<Face> face, Ptr<EN> en_p)
     {
@@ -510,6 +812,7 @@ namespace ns3
 	  // Create an OEN PDU to respond
 	  Ptr<OEN> oen_p = Create<OEN> (produced3Nname);
 	  oen_p->SetLifetime(m_3n_lifetime);
+	  oen_p->SetVersion (GetSignallingVersion ());
 	  // Ensure that the lease time is set in the PDU
 	  // We send the lease out in absolute simulator time
 	  Time absoluteLease = Simulator::Now () + m_3n_lease_time;
@@ -636,6 +939,7 @@ namespace ns3
 			      NS_LOG_INFO ("(" << *registeredOldName << ") was not in our sector, creating INF PDU");
 			      Ptr<INF> inf_o = Create<INF> ();
 			      inf_o->SetLifetime(m_3n_lifetime);
+			      inf_o->SetVersion (GetSignallingVersion ());
 
 			      // Fill the necessary information
 			      inf_o->SetOldName (registeredOldName);
@@ -643,16 +947,23 @@ namespace ns3
 			      inf_o->SetRemainLease (m_nnpt->findNameExpireTime(registeredOldName));
 
 			      // Find where to send the INF
-			      std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (registeredOldName->getSectorName(), 0);
-
-			      Ptr<Face> outFace = tmp.first;
-			      Address destAddr = tmp.second;
-
-			      // Send the created INF PDU
-			      outFace->SendINF (inf_o, destAddr);
-
-			      // Log that the INF PDU was sent
-			      m_outINFs (inf_o, outFace);
+			      const nnst::FaceMetric *tmp = m_nnst->ClosestSectorNextHop (registeredOldName->getSectorName(), 0);
+
+			      if (tmp == 0)
+				{
+				  NS_LOG_INFO ("No route to (" << registeredOldName->getSectorName() << "), dropping INF");
+				  m_dropINFs (inf_o, face);
+				}
+			      else
+				{
+				  Ptr<Face> outFace = tmp->GetFace ();
+
+				  // Send the created INF PDU
+				  outFace->SendINF (inf_o, tmp->GetAddress ());
+
+				  // Log that the INF PDU was sent
+				  m_outINFs (inf_o, outFace);
+				}
 			    }
 
 			  // If we happen to be in the same subsector, the buffer will have something
@@ -735,6 +1046,7 @@ namespace ns3
 	  // Create an OEN PDU to respond
 	  Ptr<OEN> oen_p = Create<OEN> (produced3Nname->getName());
 	  oen_p->SetLifetime(m_3n_lifetime);
+	  oen_p->SetVersion (GetSignallingVersion ());
 	  // Ensure that the lease time is set in the PDU
 	  // We send the lease out in absolute simulator time
 	  Time absoluteLease = Simulator::Now () + m_3n_lease_time;
@@ -768,39 +1080,37 @@ namespace ns3
     }
 
     void
-    ForwardingStrategy::OnDEN (Ptr<Face> face, Ptr<DEN> den_p)
+    ForwardingStrategy::PropagateDEN (Ptr<DEN> den_p, const NNNAddress &leavingAddr)
     {
-      NS_LOG_FUNCTION (this << face->GetId ());
-
-      m_inDENs (den_p, face);
+      // The parents only buffer, they have no use for the prediction
+      if (den_p->HasNextSector ())
+	{
+	  den_p = Create<DEN> (*den_p);
+	  den_p->SetNextSector (NNNAddress ());
+	}
 
       NNNAddress myAddr = GetNode3NName ();
-      Ptr<NNNAddress> leavingAddr = Create<NNNAddress> (den_p->GetNamePtr ()->getName ());
-
-      NS_LOG_INFO ("On (" << myAddr << "), (" << *leavingAddr << ") is leaving");
 
       // If the DEN packet arrives at a node that is less than 2 hops away, then we
       // forward the DEN packet to the parent of this node
-      if (leavingAddr->distance (myAddr) <= 2 && leavingAddr->isSubSector (myAddr))
+      if (leavingAddr.distance (myAddr) <= 2 && leavingAddr.isSubSector (myAddr))
 	{
 	  NS_LOG_INFO ("We can still attempt to propagate DEN");
 	  // Now we forward the DEN information to the higher hierarchical nodes
-	  std::vector<std::pair<Ptr<Face>, Address> > hierarchicalFaces = m_nnst->OneHopParentSectorFaceInfo (myAddr, 0);
-	  std::vector<std::pair<Ptr<Face>, Address> >::iterator it;
+	  Ptr<nnst::Entry> parent;
+	  const nnst::FaceMetric *hop;
 
 	  Ptr<Face> outFace;
-	  Address destAddr;
 	  bool propagated = false;
 	  bool ok = false;
 
-	  for (it = hierarchicalFaces.begin (); it != hierarchicalFaces.end (); ++it)
+	  while ((hop = m_nnst->NextOneHop (myAddr, NNST::ONE_HOP_PARENT, 0, parent)) != 0)
 	    {
-	      outFace = it->first;
-	      destAddr = it->second;
+	      outFace = hop->GetFace ();
 
 	      NS_LOG_INFO ("Pushing DEN out Face " << *outFace);
 
-	      ok = outFace->SendDEN (den_p, destAddr);
+	      ok = outFace->SendDEN (den_p, hop->GetAddress ());
 
 	      if (ok)
 		{
@@ -819,12 +1129,45 @@ namespace ns3
 	{
 	  NS_LOG_INFO ("On (" << myAddr << ") we have left the sector and are too far, stopping propagation");
 	}
+    }
+
+    void
+    ForwardingStrategy::OnDEN (Ptr<Face> face, Ptr<DEN> den_p)
+    {
+      NS_LOG_FUNCTION (this << face->GetId ());
+
+      m_inDENs (den_p, face);
+
+      NNNAddress myAddr = GetNode3NName ();
+      Ptr<NNNAddress> leavingAddr = Create<NNNAddress> (den_p->GetNamePtr ()->getName ());
+
+      NS_LOG_INFO ("On (" << myAddr << "), (" << *leavingAddr << ") is leaving");
+
+      // A DEN with a predicted next sector that does not come from the leaving
+      // node itself is the access router it left migrating its buffer
+      if (den_p->HasNextSector () && leavingAddr->getSectorName () != myAddr)
+	{
+	  MigrateBuffer (face, den_p);
+	  return;
+	}
+
+      if (m_bufferMigration && den_p->HasNextSector () && !m_node_names->foundName (den_p->GetNextSectorPtr ()))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") (" << *leavingAddr << ") predicts (" << den_p->GetNextSector () << "), migrating");
+	  MigrateBuffer (face, den_p);
+	  NotifyHandoff (face);
+	  return;
+	}
+
+      PropagateDEN (den_p, *leavingAddr);
 
       NS_LOG_INFO ("Adding (" << *leavingAddr << ") to buffers");
 
       // We know the node sending the DEN is moving. His lease time will be maintained
       // All we need to do is tell the buffer to keep the packets to that destination
       m_node_pdu_buffer->AddDestination (leavingAddr);
+
+      NotifyHandoff (face);
     }
 
     void
@@ -842,49 +1185,24 @@ namespace ns3
 
       bool willUseName = false;
 
-      // Get a list of this node's PoAs
-      std::vector<Address> myPoas = GetAllPoANames (face);
-
-      // Set difference requires the vectors to be sorted. Must unfortunately be done.
-      // Create the sorted vector to be the size of myPoas
-      std::vector<Address> sorted_myPoas (myPoas.size ());
-      std::partial_sort_copy (myPoas.begin (), myPoas.end (), sorted_myPoas.begin (), sorted_myPoas.end ());
-
       // Get the list of PoAs in the OEN
-      std::vector<Address> oenPoas = oen_p->GetPoas ();
-
-      std::vector<Address> sorted_oenPoas (oenPoas.size ());
-      std::partial_sort_copy (oenPoas.begin (), oenPoas.end (), sorted_oenPoas.begin (), sorted_oenPoas.end ());
-
-      // Check differences
-      std::vector<Address> diff;
+      const std::vector<Address> &oenPoas = oen_p->GetPoas ();
 
-      // Check if there are any differences
-      std::set_difference(sorted_myPoas.begin (), sorted_myPoas.end (),
-                          sorted_oenPoas.begin (), sorted_oenPoas.end (),
-                          std::inserter(diff, diff.begin ()));
-
-      if (diff.size () != 0)
+      // Check if all our PoAs are in the OEN
+      if (!HasAllPoANames (oenPoas))
 	{
 	  NS_LOG_INFO ("We found discrepancies with the destination PoAs. This PDU is not for this node");
 
-
 	  NS_LOG_INFO ("Node PoAs -");
-	  for (int i = 0; i < myPoas.size (); i++ )
+	  for (int i = 0; i < m_node_poas.size (); i++ )
 	    {
-	      NS_LOG_INFO (i << ": " << myPoas[i]);
+	      NS_LOG_INFO (i << ": " << m_node_poas[i]);
 	    }
 	  NS_LOG_INFO ("Received PoAs -");
 	  for (int i = 0; i < oenPoas.size (); i++ )
 	    {
 	      NS_LOG_INFO (i << ": " << oenPoas[i]);
 	    }
-
-	  NS_LOG_INFO ("Difference in PoAs -");
-	  for (int i = 0; i < diff.size (); i ++)
-	    {
-	      NS_LOG_INFO (i << ": " << diff[i]);
-	    }
 	}
       else
 	{
@@ -926,10 +1244,11 @@ namespace ns3
 	      // Now create the AEN PDU to respond
 	      Ptr<AEN> aen_p = Create<AEN> (*obtainedName);
 	      aen_p->SetLifetime(m_3n_lifetime);
+	      aen_p->SetVersion (GetSignallingVersion ());
 	      // Ensure that the lease time is set right (continues to be in absolute simulator time)
 	      aen_p->SetLeasetime (lease);
 	      // Add the PoAs to the response PDU
-	      aen_p->AddPoa(myPoas);
+	      aen_p->AddPoa(GetAllPoANames (face));
 
 	      // Send the created AEN PDU
 	      face->SendAEN(aen_p);
@@ -950,6 +1269,8 @@ namespace ns3
 
       m_inINFs (inf_p, face);
 
+      NotifyHandoff (face);
+
       bool ok = false;
       bool routed = false;
       bool propagated = false;
@@ -961,24 +1282,47 @@ namespace ns3
 
       NNNAddress endSector = inf_p->GetOldNamePtr ()->getSectorName ();
 
+      // If the node did not attach where it predicted, the sector holding its
+      // PDUs learns where it went from the INF
+      std::map<NNNAddress, NNNAddress>::iterator migration = m_migrations.find (*oldName);
+      if (migration != m_migrations.end ())
+	{
+	  if (newName->getSectorName () != migration->second)
+	    {
+	      NS_LOG_INFO ("On (" << myAddr << ") (" << *oldName << ") did not attach to (" << migration->second << "), sending INF there");
+	      const nnst::FaceMetric *closestSector = m_nnst->ClosestSectorNextHop (migration->second, 0);
+
+	      if (closestSector == 0)
+		NS_LOG_INFO ("On (" << myAddr << ") no route to (" << migration->second << "), the migrated PDUs are not redirected");
+	      else if (closestSector->GetFace ()->SendINF (inf_p, closestSector->GetAddress ()))
+		m_outINFs (inf_p, closestSector->GetFace ());
+	    }
+
+	  m_migrations.erase (migration);
+	}
+
       if (myAddr != endSector)
 	{
 	  NS_LOG_INFO("On (" << myAddr << ") have not yet reached sector. Attempting to forward to (" << endSector << ")");
 
 	  // Roughly pick the next hop that would bring us closer to the endSector
-	  std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (endSector, 0);
+	  const nnst::FaceMetric *tmp = m_nnst->ClosestSectorNextHop (endSector, 0);
 
 	  // Just like with DEN, we need to inform our higher ups that things have changed in this sector
-	  std::vector<std::pair<Ptr<Face>, Address> > hierarchicalFaces = m_nnst->OneHopParentSectorFaceInfo (myAddr, 0);
-	  std::vector<std::pair<Ptr<Face>, Address> >::iterator it;
+	  Ptr<nnst::Entry> parent;
+	  const nnst::FaceMetric *hop;
 
 	  Ptr<Face> outFace;
 	  // First send out the routed Face
-	  Ptr<Face> routedFace = tmp.first;
-	  Address destAddr = tmp.second;
+	  Ptr<Face> routedFace;
+
+	  if (tmp != 0)
+	    routedFace = tmp->GetFace ();
+	  else
+	    NS_LOG_INFO ("On (" << myAddr << ") no route to (" << endSector << "), only trying parent sectors");
 
-	  if (routedFace != face)
-	    ok = routedFace->SendINF (inf_p, destAddr);
+	  if (routedFace != 0 && routedFace != face)
+	    ok = routedFace->SendINF (inf_p, tmp->GetAddress ());
 
 	  if (ok)
 	    {
@@ -993,22 +1337,21 @@ namespace ns3
 	  // Check how far we are from old Name
 	  if (oldName->distance (myAddr) <= 2)
 	    {
-	      for (it = hierarchicalFaces.begin (); it != hierarchicalFaces.end (); ++it)
+	      while ((hop = m_nnst->NextOneHop (myAddr, NNST::ONE_HOP_PARENT, 0, parent)) != 0)
 		{
 		  // Check the information for the hierarchical Faces
-		  outFace = it->first;
-		  destAddr = it->second;
+		  outFace = hop->GetFace ();
 
 		  // Should we stumble on a face that is how we got here, skip
 		  if (outFace == face)
 		    continue;
 
 		  // If we routed the INF already, skip this face
-		  if (routed && routedFace == outface)
+		  if (routed && routedFace == outFace)
 		    continue;
 
 		  // After all checks, start sending
-		  ok = outFace->SendINF (inf_p, destAddr);
+		  ok = outFace->SendINF (inf_p, hop->GetAddress ());
 
 		  if (ok)
 		    {
@@ -1107,6 +1450,13 @@ namespace ns3
 
       NS_LOG_INFO ("On (" << myAddr << ") got DU from (" << du_p->GetSrcName() << ") to (" << du_p->GetDstName() << ")");
 
+      // DUs carrying a 3N PDU are buffer migrations, not ICN traffic
+      if (du_p->GetPDUPayloadType () == NNN_NNN)
+	{
+	  OnMigratedPDU (face, du_p);
+	  return;
+	}
+
       //Give us a rw copy of the packet
       Ptr<Packet> icn_pdu = du_p->GetPayload ()->Copy ();
 
@@ -1300,11 +1650,12 @@ namespace ns3
 
       NS_LOG_INFO ("On (" << myAddr << ") processing DATA " << std::dec << data->GetName ().get (-1).toSeqNum ());
 
-      // Lookup PIT entry
-      Ptr<pit::Entry> pitEntry = m_pit->Lookup (*data);
+      // Lookup all the PIT entries the Data satisfies in one go
+      std::vector<Ptr<pit::Entry> > pitEntries;
+      m_pit->LookupAll (*data, pitEntries);
 
       // Using 3N, we allow all data to be cached - will probably need to be discussed
-      if (pitEntry != 0)
+      if (!pitEntries.empty ())
 	{
 	  // Add to content store
 	  m_contentStore->Add (data);
@@ -1323,16 +1674,15 @@ namespace ns3
 	  // We got Data without having solicited it, but it
 	}
 
-      while (pitEntry != 0)
+      for (size_t i = 0; i < pitEntries.size (); i++)
 	{
+	  Ptr<pit::Entry> pitEntry = pitEntries[i];
+
 	  // Do data plane performance measurements
 	  WillSatisfyPendingInterest (face, pitEntry);
 
 	  // Actually satisfy pending interest
 	  SatisfyPendingInterest (pdu, face, data, pitEntry);
-
-	  // Lookup another PIT entry
-	  pitEntry = m_pit->Lookup (*data);
 	}
     }
 
@@ -1348,6 +1698,10 @@ namespace ns3
 	{
 	  // NS_LOG_DEBUG ("Face: " << face->m_face);
 	  pitEntry->GetFibEntry ()->UpdateStatus (face->m_face, fib::FaceMetric::NDN_FIB_YELLOW);
+
+	  Ptr<Limits> limits = GetEnforcedLimits (face->m_face);
+	  if (limits != 0)
+	    limits->ReturnLimit ();
 	}
 
       m_timedOutInterests (pitEntry);
@@ -1359,6 +1713,19 @@ namespace ns3
       NS_LOG_FUNCTION (this << face->GetId ());
 
       m_faces->Add (face);
+
+      if (!face->isAppFace ())
+	{
+	  Address poa = face->GetAddress ();
+	  m_node_poas.insert (std::upper_bound (m_node_poas.begin (), m_node_poas.end (), poa), poa);
+
+	  if (!m_limitsClass.empty () && face->GetObject<Limits> () == 0)
+	    {
+	      ObjectFactory factory;
+	      factory.SetTypeId (m_limitsClass);
+	      face->AggregateObject (factory.Create<Limits> ());
+	    }
+	}
     }
 
     void
@@ -1367,6 +1734,13 @@ namespace ns3
       NS_LOG_FUNCTION (this << face->GetId ());
 
       m_faces->Remove (face);
+
+      if (!face->isAppFace ())
+	{
+	  std::vector<Address>::iterator it = std::lower_bound (m_node_poas.begin (), m_node_poas.end (), face->GetAddress ());
+	  if (it != m_node_poas.end () && *it == face->GetAddress ())
+	    m_node_poas.erase (it);
+	}
     }
 
     std::vector<Address>
@@ -1374,38 +1748,46 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this);
       // Vector to save the PoA names
-      std::vector<Address> poanames1;
-      std::vector<Address> poanames2;
-      // Get the total number of addresses we have
-      int totalFaces = m_faces->GetN ();
-      Ptr<Face> tmp;
-      Address tmpaddr;
+      std::vector<Address> poanames;
+      GetAllPoANames (face, poanames);
+      return poanames;
+    }
 
-      // Go through the Faces attached to the ForwardingStrategy
-      for (int i = 0; i < totalFaces; i++)
+    void
+    ForwardingStrategy::GetAllPoANames (Ptr<Face> face, std::vector<Address> &poanames) const
+    {
+      poanames.clear ();
+      poanames.reserve (m_node_poas.size ());
+
+      // The PoA name of the Face goes first, receivers use it as destination
+      bool skipped = true;
+      if (face != 0 && !face->isAppFace ())
 	{
-	  // Get a Face
-	  tmp = m_faces->Get (i);
+	  poanames.push_back (face->GetAddress ());
+	  skipped = false;
+	}
 
-	  // Check that the Face is not of type APPLICATION
-	  if (!tmp->isAppFace ())
+      for (std::vector<Address>::const_iterator it = m_node_poas.begin (); it != m_node_poas.end (); ++it)
+	{
+	  if (!skipped && *it == poanames[0])
 	    {
-	      if (face == tmp)
-		{
-		  tmpaddr = tmp->GetAddress ();
-		  poanames1.push_back (tmpaddr);
-		}
-	      else
-		poanames2.push_back (tmp->GetAddress ());
+	      skipped = true;
+	      continue;
 	    }
+	  poanames.push_back (*it);
 	}
+    }
 
-      for (int i = 0; i < poanames2.size (); i++)
+    bool
+    ForwardingStrategy::HasAllPoANames (const std::vector<Address> &poas) const
+    {
+      // Both lists hold one PoA per Face, a linear search is cheaper than sorting
+      for (std::vector<Address>::const_iterator it = m_node_poas.begin (); it != m_node_poas.end (); ++it)
 	{
-	  poanames1.push_back (poanames2[i]);
+	  if (std::find (poas.begin (), poas.end (), *it) == poas.end ())
+	    return false;
 	}
-
-      return poanames1;
+      return true;
     }
 
     void
@@ -1420,6 +1802,8 @@ namespace ns3
 	  bool ok = false;
 
 	  Ptr<Face> tmp;
+	  // Reused for every Face
+	  std::vector<Address> poanames;
 	  // Now transmit the EN through all Faces that are not of type APPLICATION
 	  for (int i = 0; i < m_faces->GetN (); i++)
 	    {
@@ -1431,12 +1815,13 @@ namespace ns3
 		  NS_LOG_INFO ("Sending out Face " << boost::cref(*tmp) << " with " << tmp->GetAddress ());
 
 		  // Obtain all the node's PoA names
-		  std::vector<Address> poanames = GetAllPoANames (tmp);
+		  GetAllPoANames (tmp, poanames);
 
 		  // Create the EN PDU to transmit
 		  Ptr<EN> en_o = Create<EN> ();
 		  // Set the lifetime for the EN PDU
 		  en_o->SetLifetime (m_3n_lifetime);
+		  en_o->SetVersion (GetSignallingVersion ());
 
 		  // Add all the PoA names we found
 		  for (int i = 0; i < poanames.size (); i++)
@@ -1474,6 +1859,8 @@ namespace ns3
 	{
 	  bool ok = false;
 	  Ptr<Face> tmp;
+	  // Reused for every Face
+	  std::vector<Address> poanames;
 	  // Now transmit the REN through all Faces that are not of type APPLICATION
 	  for (int i = 0; i < m_faces->GetN (); i++)
 	    {
@@ -1491,7 +1878,7 @@ namespace ns3
 	      // Check that the Face is not of type APPLICATION
 	      if (!tmp->isAppFace ())
 		{
-		  std::vector<Address> poanames = GetAllPoANames (tmp);
+		  GetAllPoANames (tmp, poanames);
 
 		  // Create the REN PDU to transmit
 		  Ptr<REN> ren_o = Create<REN> ();
@@ -1499,6 +1886,7 @@ namespace ns3
 
 		  // Set the lifetime for the REN PDU
 		  ren_o->SetLifetime (m_3n_lifetime);
+		  ren_o->SetVersion (GetSignallingVersion ());
 		  // Set the 3N name for the REN
 		  ren_o->SetName (*addr);
 		  // Write the expire time for the 3N name (Time within the simulator is absolute)
@@ -1547,6 +1935,15 @@ namespace ns3
 	  bool ok = false;
 
 	  Ptr<Face> tmp;
+	  // Reused for every Face
+	  std::vector<Address> poanames;
+
+	  // Tell the access router where we are heading, if we can tell
+	  Ptr<const NNNAddress> nextSector;
+	  Ptr<HandoffPredictor> predictor = GetObject<HandoffPredictor> ();
+	  if (predictor != 0)
+	    nextSector = predictor->PredictNextSector (GetNode3NNamePtr ()->getSectorName ());
+
 	  // Now transmit the DEN through all Faces that are not of type APPLICATION
 	  for (int i = 0; i < m_faces->GetN (); i++)
 	    {
@@ -1555,7 +1952,7 @@ namespace ns3
 	      // Check that the Face is not of type APPLICATION
 	      if (!tmp->isAppFace ())
 		{
-		  std::vector<Address> poanames = GetAllPoANames (tmp);
+		  GetAllPoANames (tmp, poanames);
 
 		  // Create the DEN PDU to transmit
 		  Ptr<DEN> den_o = Create<DEN> ();
@@ -1563,8 +1960,11 @@ namespace ns3
 
 		  // Set the lifetime for the DEN PDU
 		  den_o->SetLifetime (m_3n_lifetime);
+		  den_o->SetVersion (GetSignallingVersion ());
 		  // Set the 3N name for the DEN
 		  den_o->SetName (*addr);
+		  if (nextSector != 0)
+		    den_o->SetNextSector (*nextSector);
 		  // Add all the PoA names we found
 		  for (int i = 0; i < poanames.size (); i++)
 		    {
@@ -1772,27 +2172,390 @@ namespace ns3
 	  pitEntry->GetFibEntry ()->UpdateFaceRtt (inFace, Simulator::Now () - out->m_sendTime);
 	}
 
+      for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
+	  face != pitEntry->GetOutgoing ().end ();
+	  face ++)
+	{
+	  Ptr<Limits> limits = GetEnforcedLimits (face->m_face);
+	  if (limits != 0)
+	    limits->ReturnLimit ();
+	}
+
       m_satisfiedInterests (pitEntry);
     }
 
-    void
-    ForwardingStrategy::SatisfyPendingInterest (Ptr<NNNPDU> pdu,
-                                                Ptr<Face> inFace,
-                                                Ptr<const ndn::Data> data,
-                                                Ptr<pit::Entry> pitEntry)
+    bool
+    ForwardingStrategy::AlreadySentTo (const SentNextHops &sentTo, Ptr<Face> outFace,
+                                       const Address &destAddr, const NNNAddress &dst)
     {
-      NS_LOG_FUNCTION (this);
-      NNNAddress myAddr = GetNode3NName ();
-
-      NS_LOG_INFO ("On (" << myAddr << ") Satisfying pending Interests for " << data->GetName());
+      for (SentNextHops::const_iterator it = sentTo.begin (); it != sentTo.end (); ++it)
+	{
+	  if (it->get<0> () == outFace && it->get<1> () == destAddr && it->get<2> () == dst)
+	    return true;
+	}
+      return false;
+    }
+
+    bool
+    ForwardingStrategy::SkipSentNextHop (const SentNextHops &sentTo, Ptr<Face> incomingFace,
+                                         Ptr<Face> outFace, const Address &destAddr,
+                                         const NNNAddress &dst, bool &satisfied)
+    {
+      satisfied = false;
+      if (!AlreadySentTo (sentTo, outFace, destAddr, dst))
+	return false;
+
+      satisfied = incomingFace == outFace;
+      return true;
+    }
+
+    ForwardingStrategy::SatisfyState::SatisfyState (ForwardingStrategy *strategy, Ptr<Face> inFace,
+                                                    Ptr<const ndn::Data> data, Ptr<pit::Entry> pitEntry)
+    : m_strategy (strategy)
+    , m_myAddr (strategy->GetNode3NNamePtr ())
+    , m_inFace (inFace)
+    , m_data (data)
+    , m_pitEntry (pitEntry)
+    , m_icnPdu (ndn::Wire::FromData (data))
+    , m_incoming (0)
+    , m_sector (Create<NNNAddress> ())
+    , m_first (true)
+    , m_subSector (false)
+    , m_sentSomething (false)
+    {
+    }
+
+    void
+    ForwardingStrategy::SatisfyState::Reset (const pit::IncomingFace &incoming)
+    {
+      m_incoming = &incoming;
+      m_first = true;
+      m_subSector = false;
+      m_sentSomething = false;
+    }
+
+    void
+    ForwardingStrategy::SatisfyState::operator () (Ptr<const NNNAddress> dst)
+    {
+      m_strategy->SatisfyDestination (*this, dst);
+    }
+
+    void
+    ForwardingStrategy::SatisfyDestination (SatisfyState &state, Ptr<const NNNAddress> dst)
+    {
+      const pit::IncomingFace &incoming = *state.m_incoming;
+      const NNNAddress &myAddr = *state.m_myAddr;
+      const Ptr<Face> &inFace = state.m_inFace;
+      const Ptr<const ndn::Data> &data = state.m_data;
+      const Ptr<pit::Entry> &pitEntry = state.m_pitEntry;
+      const Ptr<Packet> &icn_pdu = state.m_icnPdu;
+      const Ptr<NULLp> &nullp_i = state.m_nullp;
+      bool wasNULL = nullp_i != 0;
+      const Ptr<SO> &so_i = state.m_so;
+      bool wasSO = so_i != 0;
+      const Ptr<DO> &do_i = state.m_do;
+      bool wasDO = do_i != 0;
+      const Ptr<DU> &du_i = state.m_du;
+      bool wasDU = du_i != 0;
+      SentNextHops &sentTo = state.m_sentTo;
+      bool &sentSomething = state.m_sentSomething;
+      bool ok = false;
+
+      NNNAddress sector = dst->getSectorName ();
+      NNNAddress newdst;
+
+      // Reset for each distinct 3N subsector
+      if (state.m_first || sector != *state.m_sector)
+	{
+	  *state.m_sector = sector;
+	  state.m_first = false;
+	  state.m_subSector = m_node_names->foundName (state.m_sector);
+	  sentSomething = false;
+	}
+
+      // If the aggregation is the same as the 3N Name the node is using, then
+      // everything aggregated is probably connected to it
+      if (state.m_subSector)
+	{
+	  NS_LOG_INFO ("We are satisfying Interests to nodes that are directly connected to us (" << *dst << "), continue");
+	}
+      // We are pushing to a different sector
+      else
+	{
+
+	  NS_LOG_INFO ("On (" << myAddr << ") satisfying for 3N names in different subsector (" << *state.m_sector << "), destination: (" << *dst << ")");
+	  if (sentSomething)
+	    {
+	      NS_LOG_INFO ("On (" << myAddr << "), we seem to have already sent to subsector (" << *state.m_sector << ") about to skip");
+	      return;
+	    }
+	}
+
+      // First check to see if we happen to be the destination
+      if (m_node_names->foundName(dst))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") We are the desired 3N named node destination");
+	  // This also happens to mean that we satisfying an Application - do not know if
+	  // this holds in future references
+	  if (wasNULL)
+	    ok = incoming.m_face->SendNULLp (nullp_i);
+	  else if (wasSO)
+	    ok = incoming.m_face->SendSO (so_i);
+	  else if (wasDO)
+	    ok = incoming.m_face->SendDO (do_i);
+	  else if (wasDU)
+	    ok = incoming.m_face->SendDU (du_i);
+
+	  // Something caused an error
+	  if (!ok)
+	    {
+	      // Log Data drops
+	      m_dropData (data, incoming.m_face);
+	      // Log the type of 3N Data transfer PDU that was dropped
+	      if (wasNULL)
+		m_dropNULLps (nullp_i, incoming.m_face);
+	      else if (wasSO)
+		m_dropSOs (so_i, incoming.m_face);
+	      else if (wasDO)
+		m_dropDOs (do_i, incoming.m_face);
+	      else if (wasDU)
+		m_dropDUs (du_i, incoming.m_face);
+
+	      NS_LOG_DEBUG ("Cannot satisfy data to " << *dst << " via "<< *incoming.m_face);
+	    }
+	  else
+	    {
+	      // Log that a Data PDU was sent
+	      DidSendOutData (inFace, incoming.m_face, data, pitEntry);
+
+	      if (wasNULL)
+		{
+		  NS_LOG_INFO ("Satisfying with NULLp");
+		  m_outNULLps (nullp_i, incoming.m_face);
+		}
+	      else if (wasSO)
+		{
+		  NS_LOG_INFO ("Satisfying with SO");
+		  m_outSOs (so_i, incoming.m_face);
+		}
+	      else if (wasDO)
+		{
+		  NS_LOG_INFO ("Satisfying with DO");
+		  m_outDOs (do_i, incoming.m_face);
+		}
+	      else if (wasDU)
+		{
+		  NS_LOG_INFO ("Satisfying with DU");
+		  m_outDUs (du_i, incoming.m_face);
+		}
+	    }
+
+	  sentSomething = true;
+	  return;
+	}
+
+      // Go through the normal forwarding methods
+
+      // Check if the NNPT has any information for this particular 3N name
+      // Retrieve the new 3N name destination
+      bool redirect = m_nnpt->foundOldName(dst);
+
+      newdst = m_nnpt->findPairedNamePtr (dst)->getName ();
+
+      if (redirect)
+	NS_LOG_INFO ("We are on (" << myAddr << ") we are redirecting (" << *dst << ") to (" << newdst << ")");
+
+      // The destination may be moving to a sector we were told about
+      if (!redirect && ((wasDO && MigrateDO (*dst, do_i)) || (wasDU && MigrateDU (*dst, du_i))))
+	NS_LOG_INFO ("We are on (" << myAddr << ") migrating this PDU to (" << *dst << ")");
+      // We may have obtained a DEN so we need to check
+      else if (m_node_pdu_buffer->DestinationExists (*dst) && !redirect)
+	{
+	  NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << *dst << ")");
+
+	  if (wasDO)
+	    {
+	      NS_LOG_INFO ("Buffering DO");
+	      m_node_pdu_buffer->PushDO (*dst, do_i);
+	    }
+	  else if (wasDU)
+	    {
+	      NS_LOG_INFO ("Buffering DU");
+	      m_node_pdu_buffer->PushDU (*dst, du_i);
+	    }
+	}
+
+      NS_LOG_INFO ("On (" << myAddr << ") Going to look at NNST size: " << m_nnst->GetSize() << " to send to (" << newdst << ")");
+      NS_LOG_INFO (*m_nnst);
+
+      // Roughly pick the next hop that would bring us closer to newdst
+      const nnst::FaceMetric *tmp = SelectNextHop (newdst, data->GetName (), 0);
+
+      if (tmp == 0)
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") no route to (" << newdst << "), dropping Data for (" << *dst << ")");
+	  m_dropData (data, incoming.m_face);
+	  return;
+	}
+
+      Ptr<Face> outFace = tmp->GetFace ();
+      Address destAddr = tmp->GetAddress ();
+
+      // Several aggregated names can resolve to the same next hop and 3N name
+      // (i.e. NNPT redirections), only send one PDU for each of them
+      bool satisfied = false;
+      if ((wasNULL || wasSO || wasDO || wasDU) && (!sentSomething || redirect) &&
+	  SkipSentNextHop (sentTo, incoming.m_face, outFace, destAddr, newdst, satisfied))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") already sent to (" << newdst << ") via " << destAddr << ", skipping (" << *dst << ")");
+	  if (satisfied)
+	    {
+	      sentSomething = true;
+	      return;
+	    }
+	}
+      else if ((wasNULL || wasSO || wasDO) && (!sentSomething || redirect))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *dst << ") using DO");
+	  // Since we don't have more information about this 3N name, create a DO to push the
+	  // Data to a new location
+	  Ptr<DO> do_o_spec = Create<DO> ();
+	  // Set the new 3N name
+	  do_o_spec->SetName (newdst);
+	  // Set the lifetime of the 3N PDU
+	  do_o_spec->SetLifetime (m_3n_lifetime);
+	  // Configure payload for PDU
+	  do_o_spec->SetPayload (icn_pdu);
+	  // Signal that the PDU had an ICN PDU as payload
+	  do_o_spec->SetPDUPayloadType (NDN_NNN);
+
+	  // Send the DO PDU out the selected Face
+	  ok = outFace->SendDO (do_o_spec, destAddr);
+
+	  // Something caused an error
+	  if (!ok)
+	    {
+	      // Log Data drops
+	      m_dropData (data, incoming.m_face);
+	      // Log DO PDU drop
+	      m_dropDOs (do_o_spec, outFace);
+	      NS_LOG_DEBUG ("Cannot satisfy data to (" << newdst << ") via "<< *incoming.m_face);
+	    }
+	  else
+	    {
+	      // Log that a Data PDU was sent
+	      DidSendOutData (inFace, outFace, data, pitEntry);
+	      // Log that a DO PDU was sent
+	      m_outDOs (do_o_spec, outFace);
+	      sentTo.push_back (boost::make_tuple (outFace, destAddr, newdst));
+
+	      if (incoming.m_face == outFace)
+		{
+		  // Actually sent something using this Face
+		  sentSomething = true;
+		  return;
+		}
+	    }
+	}
+      else if (wasDU && (!sentSomething || redirect))
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *dst << ") using DU");
+	  // We know that the Data was brought by a DU PDU, meaning we know the origin
+	  // Create a new DU PDU to send the data
+	  Ptr<DU> du_o_spec = Create<DU> ();
+	  // Use the original DU's Src 3N name
+	  du_o_spec->SetSrcName (du_i->GetSrcName ());
+	  // Set the new 3N name destination
+	  du_o_spec->SetDstName (newdst);
+	  // Set the lifetime of the 3N PDU
+	  du_o_spec->SetLifetime (m_3n_lifetime);
+	  // Configure payload for PDU
+	  du_o_spec->SetPayload (icn_pdu);
+	  // Signal that the PDU had an ICN PDU as payload
+	  du_o_spec->SetPDUPayloadType (NDN_NNN);
+
+	  // Send the DU PDU out the selected Face
+	  ok = outFace->SendDU (du_o_spec, destAddr);
+
+	  // Something caused an error
+	  if (!ok)
+	    {
+	      // Log Data drops
+	      m_dropData (data, incoming.m_face);
+	      // Log DU PDU drop
+	      m_dropDUs (du_o_spec, outFace);
+	      NS_LOG_DEBUG ("Cannot satisfy data to " << newdst << " via "<< *incoming.m_face);
+	    }
+	  else
+	    {
+	      // Log that a Data PDU was sent
+	      DidSendOutData (inFace, outFace, data, pitEntry);
+	      // Log that a DO PDU was sent
+	      m_outDUs (du_o_spec, outFace);
+	      sentTo.push_back (boost::make_tuple (outFace, destAddr, newdst));
+
+	      if (incoming.m_face == outFace)
+		{
+		  // Actually sent something using this Face
+		  sentSomething = true;
+		  return;
+		}
+	    }
+	}
+
+      // If we had received a NULL PDU with this Interest at some point, and still
+      // haven't pushed anything in previous sections, we should do it now
+      if (!sentSomething)
+	{
+	  NS_LOG_INFO ("On (" << myAddr << ") Satisfying using NULLp");
+	  Ptr<NULLp> null_p_o = Create<NULLp> ();
+	  // Set the lifetime of the 3N PDU
+	  null_p_o->SetLifetime (m_3n_lifetime);
+	  // Configure payload for PDU
+	  null_p_o->SetPayload (icn_pdu);
+	  // Signal that the PDU had an ICN PDU as payload
+	  null_p_o->SetPDUPayloadType (NDN_NNN);
+
+	  // Send out the NULL PDU
+	  ok = incoming.m_face->SendNULLp (null_p_o);
+
+	  NS_LOG_DEBUG ("Satisfy " << *incoming.m_face);
+
+	  if (!ok)
+	    {
+	      m_dropData (data, incoming.m_face);
+	      m_dropNULLps (null_p_o, incoming.m_face);
+	      NS_LOG_DEBUG ("Cannot satisfy data to " << *incoming.m_face);
+	    }
+	  else
+	    {
+	      // Log that a Data PDU was sent
+	      DidSendOutData (inFace, incoming.m_face, data, pitEntry);
+	      // Log that a DO PDU was sent
+	      m_outNULLps (null_p_o, incoming.m_face);
+	    }
+	}
+    }
+
+    void
+    ForwardingStrategy::SatisfyPendingInterest (Ptr<NNNPDU> pdu,
+                                                Ptr<Face> inFace,
+                                                Ptr<const ndn::Data> data,
+                                                Ptr<pit::Entry> pitEntry)
+    {
+      NS_LOG_FUNCTION (this);
+      NNNAddress myAddr = GetNode3NName ();
+
+      NS_LOG_INFO ("On (" << myAddr << ") Satisfying pending Interests for " << data->GetName());
 
       if (inFace != 0)
 	pitEntry->RemoveIncoming (inFace);
       else
 	NS_LOG_INFO ("On (" << myAddr << ") satisfying from local CS");
 
-      // Convert the Data PDU into a NS-3 Packet
-      Ptr<Packet> icn_pdu = ndn::Wire::FromData (data);
+      // Converts the Data PDU into a NS-3 Packet and keeps what the 3N names need
+      SatisfyState state (this, inFace, data, pitEntry);
+      const Ptr<Packet> &icn_pdu = state.m_icnPdu;
 
       // Pointers and flags for PDU types
       Ptr<NULLp> nullp_i;
@@ -1835,19 +2598,21 @@ namespace ns3
 	  break;
       }
 
+      state.m_nullp = nullp_i;
+      state.m_so = so_i;
+      state.m_do = do_i;
+      state.m_du = du_i;
+
       // Satisfy all pending Interests with the Data we received on each Face
       BOOST_FOREACH (const pit::IncomingFace &incoming, pitEntry->GetIncoming ())
       {
 	bool ok = false;
-	bool sentSomething = false;
 
 	NS_LOG_INFO ("On (" << myAddr << ") Satisfying for Face " << incoming.m_face->GetId() << " of type " << incoming.m_face->GetFlags() << " at (" << GetNode3NName () << ")");
 
 	/////////////////////////////////////////////////////////////////////////////////////////
-	// Obtain the distinct 3N names associated to this Face and go through them
-	std::vector<Ptr<NNNAddress> > distinct = incoming.m_addrs->GetDistinctDestinations ();
 	// It is possible for the face to have no destinations
-	if (distinct.empty())
+	if (incoming.NoAddresses ())
 	  {
 	    // The PIT Entry has been created but has no 3N names. We satisfy with whatever we were given
 	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has no 3N names aggregated");
@@ -1965,8 +2730,11 @@ namespace ns3
 			// Configure payload for PDU
 			do_o_spec->SetPayload (icn_pdu);
 
+			// The destination may be moving to a sector we were told about
+			if (!redirect && MigrateDO (endDest, do_o_spec))
+			  NS_LOG_INFO ("We are on (" << myAddr << ") migrating this PDU to (" << endDest << ")");
 			// We may have obtained a DEN so we need to check
-			if (m_node_pdu_buffer->DestinationExists (endDest) && !redirect)
+			else if (m_node_pdu_buffer->DestinationExists (endDest) && !redirect)
 			  {
 			    NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << endDest << ")");
 
@@ -2074,257 +2842,9 @@ namespace ns3
 	  {
 	    NS_LOG_INFO ("On (" << myAddr << ") Our PIT has 3N names aggregated");
 
-	    // There is at least one 3N name in this list - go through the code
-	    BOOST_FOREACH (Ptr<NNNAddress> j, distinct)
-	    {
-	      bool subSector = m_node_names->foundName(j);
-	      NNNAddress newdst;
-	      // Obtain all the 3N names aggregated in this sector
-	      std::vector<Ptr<NNNAddress> > addrs = incoming.m_addrs->GetCompleteDestinations (j);
-
-	      BOOST_FOREACH (Ptr<NNNAddress> i, addrs)
-	      {
-		// If the aggregation is the same as the 3N Name the node is using, then
-		// everything aggregated is probably connected to it
-		if (subSector)
-		  {
-		    NS_LOG_INFO ("We are satisfying Interests to nodes that are directly connected to us (" << *i << "), continue");
-		  }
-		// We are pushing to a different sector
-		else
-		  {
-
-		    NS_LOG_INFO ("On (" << myAddr << ") satisfying for 3N names in different subsector (" << *j << "), destination: (" << *i << ")");
-		    if (sentSomething)
-		      {
-			NS_LOG_INFO ("On (" << myAddr << "), we seem to have already sent to subsector (" << *j << ") about to skip");
-			continue;
-		      }
-		  }
-
-		// First check to see if we happen to be the destination
-		if (m_node_names->foundName(i))
-		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") We are the desired 3N named node destination");
-		    // This also happens to mean that we satisfying an Application - do not know if
-		    // this holds in future references
-		    if (wasNULL)
-		      ok = incoming.m_face->SendNULLp (nullp_i);
-		    else if (wasSO)
-		      ok = incoming.m_face->SendSO (so_i);
-		    else if (wasDO)
-		      ok = incoming.m_face->SendDO (do_i);
-		    else if (wasDU)
-		      ok = incoming.m_face->SendDU (du_i);
-
-		    // Something caused an error
-		    if (!ok)
-		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log the type of 3N Data transfer PDU that was dropped
-			if (wasNULL)
-			  m_dropNULLps (nullp_i, incoming.m_face);
-			else if (wasSO)
-			  m_dropSOs (so_i, incoming.m_face);
-			else if (wasDO)
-			  m_dropDOs (do_i, incoming.m_face);
-			else if (wasDU)
-			  m_dropDUs (du_i, incoming.m_face);
-
-			NS_LOG_DEBUG ("Cannot satisfy data to " << *i << " via "<< *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
-
-			if (wasNULL)
-			  {
-			    NS_LOG_INFO ("Satisfying with NULLp");
-			    m_outNULLps (nullp_i, incoming.m_face);
-			  }
-			else if (wasSO)
-			  {
-			    NS_LOG_INFO ("Satisfying with SO");
-			    m_outSOs (so_i, incoming.m_face);
-			  }
-			else if (wasDO)
-			  {
-			    NS_LOG_INFO ("Satisfying with DO");
-			    m_outDOs (do_i, incoming.m_face);
-			  }
-			else if (wasDU)
-			  {
-			    NS_LOG_INFO ("Satisfying with DU");
-			    m_outDUs (du_i, incoming.m_face);
-			  }
-		      }
-
-		    sentSomething = true;
-		    continue;
-		  }
-
-		// Go through the normal forwarding methods
-
-		// Check if the NNPT has any information for this particular 3N name
-		// Retrieve the new 3N name destination
-		bool redirect = m_nnpt->foundOldName(i);
-
-		newdst = m_nnpt->findPairedNamePtr (i)->getName ();
-
-		if (redirect)
-		  NS_LOG_INFO ("We are on (" << myAddr << ") we are redirecting (" << *i << ") to (" << newdst << ")");
-
-		// We may have obtained a DEN so we need to check
-		if (m_node_pdu_buffer->DestinationExists (i) && !redirect)
-		  {
-		    NS_LOG_INFO ("We are on (" << myAddr << ") we have been told to buffer this PDU to (" << *i << ")");
-
-		    if (wasDO)
-		      {
-			NS_LOG_INFO ("Buffering DO");
-			m_node_pdu_buffer->PushDO (i, do_i);
-		      }
-		    else if (wasDU)
-		      {
-			NS_LOG_INFO ("Buffering DU");
-			m_node_pdu_buffer->PushDU (i, du_i);
-		      }
-		  }
-
-		NS_LOG_INFO ("On (" << myAddr << ") Going to look at NNST size: " << m_nnst->GetSize() << " to send to (" << newdst << ")");
-		NS_LOG_INFO (*m_nnst);
-
-		// Roughly pick the next hop that would bring us closer to newdst
-		std::pair<Ptr<Face>, Address> tmp = m_nnst->ClosestSectorFaceInfo (newdst, 0);
-
-		Ptr<Face> outFace = tmp.first;
-		Address destAddr = tmp.second;
-
-		if ((wasNULL || wasSO || wasDO) && (!sentSomething || redirect))
-		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *i << ") using DO");
-		    // Since we don't have more information about this 3N name, create a DO to push the
-		    // Data to a new location
-		    Ptr<DO> do_o_spec = Create<DO> ();
-		    // Set the new 3N name
-		    do_o_spec->SetName (newdst);
-		    // Set the lifetime of the 3N PDU
-		    do_o_spec->SetLifetime (m_3n_lifetime);
-		    // Configure payload for PDU
-		    do_o_spec->SetPayload (icn_pdu);
-		    // Signal that the PDU had an ICN PDU as payload
-		    do_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		    // Send the DO PDU out the selected Face
-		    ok = outFace->SendDO (do_o_spec, destAddr);
-
-		    // Something caused an error
-		    if (!ok)
-		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log DO PDU drop
-			m_dropDOs (do_o_spec, outFace);
-			NS_LOG_DEBUG ("Cannot satisfy data to (" << newdst << ") via "<< *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, outFace, data, pitEntry);
-			// Log that a DO PDU was sent
-			m_outDOs (do_o_spec, outFace);
-
-			if (incoming.m_face == outFace)
-			  {
-			    // Actually sent something using this Face
-			    sentSomething = true;
-			    continue;
-			  }
-		      }
-		  }
-		else if (wasDU && (!sentSomething || redirect))
-		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying for 3N name (" << *i << ") using DU");
-		    // We know that the Data was brought by a DU PDU, meaning we know the origin
-		    // Create a new DU PDU to send the data
-		    Ptr<DU> du_o_spec = Create<DU> ();
-		    // Use the original DU's Src 3N name
-		    du_o_spec->SetSrcName (du_i->GetSrcName ());
-		    // Set the new 3N name destination
-		    du_o_spec->SetDstName (newdst);
-		    // Set the lifetime of the 3N PDU
-		    du_o_spec->SetLifetime (m_3n_lifetime);
-		    // Configure payload for PDU
-		    du_o_spec->SetPayload (icn_pdu);
-		    // Signal that the PDU had an ICN PDU as payload
-		    du_o_spec->SetPDUPayloadType (NDN_NNN);
-
-		    // Send the DU PDU out the selected Face
-		    ok = outFace->SendDU (du_o_spec, destAddr);
-
-		    // Something caused an error
-		    if (!ok)
-		      {
-			// Log Data drops
-			m_dropData (data, incoming.m_face);
-			// Log DU PDU drop
-			m_dropDUs (du_o_spec, outFace);
-			NS_LOG_DEBUG ("Cannot satisfy data to " << newdst << " via "<< *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, outFace, data, pitEntry);
-			// Log that a DO PDU was sent
-			m_outDUs (du_o_spec, outFace);
-
-			if (incoming.m_face == outFace)
-			  {
-			    // Actually sent something using this Face
-			    sentSomething = true;
-			    continue;
-			  }
-		      }
-		  }
-
-		// If we had received a NULL PDU with this Interest at some point, and still
-		// haven't pushed anything in previous sections, we should do it now
-		if (!sentSomething)
-		  {
-		    NS_LOG_INFO ("On (" << myAddr << ") Satisfying using NULLp");
-		    Ptr<NULLp> null_p_o = Create<NULLp> ();
-		    // Set the lifetime of the 3N PDU
-		    null_p_o->SetLifetime (m_3n_lifetime);
-		    // Configure payload for PDU
-		    null_p_o->SetPayload (icn_pdu);
-		    // Signal that the PDU had an ICN PDU as payload
-		    null_p_o->SetPDUPayloadType (NDN_NNN);
-
-		    // Send out the NULL PDU
-		    ok = incoming.m_face->SendNULLp (null_p_o);
-
-		    NS_LOG_DEBUG ("Satisfy " << *incoming.m_face);
-
-		    if (!ok)
-		      {
-			m_dropData (data, incoming.m_face);
-			m_dropNULLps (null_p_o, incoming.m_face);
-			NS_LOG_DEBUG ("Cannot satisfy data to " << *incoming.m_face);
-		      }
-		    else
-		      {
-			// Log that a Data PDU was sent
-			DidSendOutData (inFace, incoming.m_face, data, pitEntry);
-			// Log that a DO PDU was sent
-			m_outNULLps (null_p_o, incoming.m_face);
-		      }
-		  }
-	      }
-	      // Reset for each distinct 3N subsector
-	      sentSomething = false;
-	    }
+	    // There is at least one 3N name in this list, they come grouped by sector
+	    state.Reset (incoming);
+	    incoming.VisitDestinations (state);
 	  }
       }
 
@@ -2487,9 +3007,25 @@ namespace ns3
 	  return false;
 	}
 
+      // A retransmission keeps the slot of the first transmission through the Face
+      bool newOutgoing = pitEntry->GetOutgoing ().find (outFace) == pitEntry->GetOutgoing ().end ();
+
+      // Check if the Face has room for one more Interest
+      Ptr<Limits> limits = newOutgoing ? GetEnforcedLimits (outFace) : 0;
+      if (limits != 0 && !limits->IsBelowLimit ())
+	{
+	  m_dropInterests (interest, outFace);
+	  return false;
+	}
+
       // Update the PIT Entry with the Outgoing selected Face
       pitEntry->AddOutgoing (outFace);
 
+      // The slot is returned once per outgoing Face, when the Interest is
+      // satisfied or times out
+      if (limits != 0)
+	limits->BorrowLimit ();
+
       // Flag to know if what we sent was successful
       bool successSend = false;
 
@@ -2680,7 +3216,6 @@ namespace ns3
       }
 
       // Pointers to use when we have DO or DU PDUs
-      std::pair<Ptr<Face>, Address> tmp;
       Address destAddr;
       NNNAddress newdst;
       Ptr<NNNAddress> newdstPtr;
@@ -2727,8 +3262,11 @@ namespace ns3
 	      return propagatedCount > 0;
 	    }
 
+	  // The destination may be moving to a sector we were told about
+	  if (!m_nnpt->foundOldName(constdstPtr) && ((wasDO && MigrateDO (newdst, do_i)) || (wasDU && MigrateDU (newdst, du_i))))
+	    NS_LOG_INFO ("We are on (" << GetNode3NName () << ") migrating this PDU to (" << newdst << ")");
 	  // We may have obtained a DEN so we need to check
-	  if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
+	  else if (m_node_pdu_buffer->DestinationExists (newdst) && !m_nnpt->foundOldName(constdstPtr))
 	    {
 	      NS_LOG_INFO ("We are on (" << GetNode3NName () << ") we have been told to buffer this PDU to (" << newdst << ")");
 
@@ -2798,13 +3336,19 @@ namespace ns3
 	  for (int j = 0; j < totalFaces; j++)
 	    {
 	      // Roughly find the next hop
-	      tmp = m_nnst->ClosestSectorFaceInfo (newdst, j);
+	      const nnst::FaceMetric *tmp = SelectNextHop (newdst, interest->GetName (), j);
+
+	      // No NNST entry leads to newdst, so no other candidate either
+	      if (tmp == 0)
+		{
+		  NS_LOG_INFO ("No route to (" << newdst << ")");
+		  break;
+		}
 
 	      // Update the variables for Face and PoA name
-	      foutFace = tmp.first;
-	      destAddr = tmp.second;
+	      foutFace = tmp->GetFace ();
 
-	      if (TrySendOutInterest(pdu_i, inFace, foutFace, destAddr, interest, pitEntry))
+	      if (TrySendOutInterest(pdu_i, inFace, foutFace, tmp->GetAddress (), interest, pitEntry))
 		{
 		  propagatedCount++;
 		  break;
@@ -2859,6 +3403,13 @@ namespace ns3
       return propagatedCount > 0;
     }
 
+    const nnst::FaceMetric *
+    ForwardingStrategy::SelectNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip)
+    {
+      NS_LOG_FUNCTION (this << dst << flow << skip);
+      return m_nnst->ClosestSectorNextHop (dst, skip);
+    }
+
     void
     ForwardingStrategy::NotifyNewAggregate ()
     {
@@ -30,6 +30,9 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <ns3-dev/ns3/name.h>
 
 #include "../nnn-face.h"
 #include "../nnn-naming.h"
@@ -87,7 +90,11 @@ namespace ns3
     namespace nnpt { class Entry; }
 
     class Pit;
-    namespace pit { class Entry; }
+    namespace pit
+    {
+      class Entry;
+      struct IncomingFace;
+    }
 
     class Fib;
     namespace fib
@@ -148,6 +155,13 @@ namespace ns3
       virtual Ptr<const NNNAddress>
       GetNode3NNamePtr ();
 
+      /**
+       * \brief Version of the mechanism PDUs this node creates, B_NNN
+       * (compact PoA lists and names) if CompactSignalling is set
+       */
+      uint16_t
+      GetSignallingVersion () const;
+
       // Produces a random 3N name under the delegated name space
       virtual Ptr<NNNAddress>
       produce3NName ();
@@ -164,9 +178,114 @@ namespace ns3
       virtual Time
       GetRetxTimer () const;
 
+      virtual void
+      SetAwaitingResponseMaxSize (uint32_t maxSize);
+
+      virtual uint32_t
+      GetAwaitingResponseMaxSize () const;
+
       virtual void
       flushBuffer (Ptr<Face> face, Ptr<NNNAddress> oldName, Ptr<NNNAddress> newName);
 
+      /**
+       * \brief PDUBuffer holding the PDUs for nodes that are moving
+       */
+      Ptr<PDUBuffer>
+      GetPDUBuffer () const;
+
+      /**
+       * \brief 3N names of the node itself
+       */
+      Ptr<NamesContainer>
+      GetNodeNames () const;
+
+      /**
+       * \brief 3N names the node leased to others
+       */
+      Ptr<NamesContainer>
+      GetLeasedNames () const;
+
+      /**
+       * \brief Tell the Limits of every Face how many PDUs the PDUBuffer holds
+       *
+       * Connected to the "Buffered" trace source of the PDUBuffer
+       */
+      void
+      NotifyBufferOccupancy (uint32_t oldValue, uint32_t newValue);
+
+      /**
+       * \brief Tell the Limits of a Face that a DEN or INF arrived on it
+       */
+      void
+      NotifyHandoff (Ptr<Face> face);
+
+      /**
+       * \brief Limits enforced on a Face, 0 unless the "Limit" attribute names a class
+       */
+      Ptr<Limits>
+      GetEnforcedLimits (Ptr<Face> face) const;
+
+      /**
+       * \brief Forward a DEN carrying a predicted next sector towards that sector
+       *
+       * On the access router the node is leaving (with BufferMigration
+       * set), PDUs for the node are tunnelled to the predicted sector from
+       * then on, starting with the ones already buffered. On the
+       * predicted sector, the PDUs are buffered for the node, to be
+       * flushed when its INF arrives, one hop away from it. Without a
+       * route to the predicted sector the DEN is dropped, and the access
+       * router the node left buffers its PDUs and propagates the DEN to
+       * its parents as usual.
+       */
+      virtual void
+      MigrateBuffer (Ptr<Face> face, Ptr<DEN> den_p);
+
+      /**
+       * \brief Send a DEN for leavingAddr to the parent sectors, without its
+       * predicted next sector, while the node is at most two hops away
+       */
+      void
+      PropagateDEN (Ptr<DEN> den_p, const NNNAddress &leavingAddr);
+
+      /**
+       * \brief Tunnel a DO to the predicted next sector of its destination
+       *
+       * Without a route to that sector the DO is buffered here instead
+       *
+       * \return false if the destination is not being migrated
+       */
+      bool
+      MigrateDO (const NNNAddress &addr, Ptr<const DO> do_p);
+
+      /**
+       * \brief Tunnel a DU to the predicted next sector of its destination
+       *
+       * Without a route to that sector the DU is buffered here instead
+       *
+       * \return false if the destination is not being migrated
+       */
+      bool
+      MigrateDU (const NNNAddress &addr, Ptr<const DU> du_p);
+
+      /**
+       * \brief Tunnel an encoded 3N PDU in a DU to the predicted next sector of addr
+       * \return false if addr is not being migrated or there is no route to its sector
+       */
+      bool
+      Migrate (const NNNAddress &addr, Ptr<Packet> pdu);
+
+      /**
+       * \brief Stop tunnelling the PDUs for a leaving node
+       */
+      void
+      EndMigration (NNNAddress addr);
+
+      /**
+       * \brief Processing of DUs carrying a migrated 3N PDU (NNN_NNN payload)
+       */
+      virtual void
+      OnMigratedPDU (Ptr<Face> face, Ptr<DU> du_p);
+
       /**
        * \brief Actual processing of incoming Nnn ENs
        *
@@ -302,9 +421,24 @@ namespace ns3
       virtual void
       RemoveFace (Ptr<Face> face);
 
+      /**
+       * @brief Get the PoA names of this node, the PoA name of face first
+       */
       virtual std::vector<Address>
       GetAllPoANames (Ptr<Face> face);
 
+      /**
+       * @brief Same as GetAllPoANames, reusing the storage of poanames
+       */
+      void
+      GetAllPoANames (Ptr<Face> face, std::vector<Address> &poanames) const;
+
+      /**
+       * @brief Check whether all the PoA names of this node are in poas
+       */
+      bool
+      HasAllPoANames (const std::vector<Address> &poas) const;
+
       virtual void
       Enroll ();
 
@@ -486,6 +620,73 @@ namespace ns3
       WillSatisfyPendingInterest (Ptr<Face> inFace,
                                   Ptr<pit::Entry> pitEntry);
 
+      /// @brief Next hops (Face, PoA, 3N name) used while satisfying one Data
+      typedef std::vector<boost::tuple<Ptr<Face>, Address, NNNAddress> > SentNextHops;
+
+      /**
+       * @brief Check whether a PDU for dst has already been sent to destAddr via outFace
+       */
+      static bool
+      AlreadySentTo (const SentNextHops &sentTo, Ptr<Face> outFace,
+                     const Address &destAddr, const NNNAddress &dst);
+
+      /**
+       * @brief Check whether the PDU for dst can be skipped because it has
+       * already been sent to destAddr via outFace
+       *
+       * @param satisfied set when that PDU also satisfies incomingFace, i.e.
+       * outFace is incomingFace. Otherwise incomingFace still gets the NULLp
+       * fallback, as it did when the PDU was sent once per 3N name
+       */
+      static bool
+      SkipSentNextHop (const SentNextHops &sentTo, Ptr<Face> incomingFace,
+                       Ptr<Face> outFace, const Address &destAddr,
+                       const NNNAddress &dst, bool &satisfied);
+
+      /**
+       * @brief State of SatisfyPendingInterest while it visits the 3N names
+       * aggregated on one incoming Face
+       *
+       * Given to pit::IncomingFace::VisitDestinations, which calls
+       * SatisfyDestination for every 3N name of the Face
+       */
+      struct SatisfyState
+      {
+        SatisfyState (ForwardingStrategy *strategy, Ptr<Face> inFace,
+                      Ptr<const ndn::Data> data, Ptr<pit::Entry> pitEntry);
+
+        /// @brief Start over for the next incoming Face
+        void
+        Reset (const pit::IncomingFace &incoming);
+
+        void
+        operator () (Ptr<const NNNAddress> dst);
+
+        ForwardingStrategy *m_strategy;
+        Ptr<const NNNAddress> m_myAddr;
+        Ptr<Face> m_inFace;
+        Ptr<const ndn::Data> m_data;
+        Ptr<pit::Entry> m_pitEntry;
+        Ptr<Packet> m_icnPdu;     ///< @brief Data as the payload of the 3N PDUs
+        Ptr<NULLp> m_nullp;       ///< @brief Only one of the four is set, depending on the PDU that brought the Data
+        Ptr<SO> m_so;
+        Ptr<DO> m_do;
+        Ptr<DU> m_du;
+        SentNextHops m_sentTo;    ///< @brief Kept for all the incoming Faces
+
+        const pit::IncomingFace *m_incoming;
+        Ptr<NNNAddress> m_sector; ///< @brief Sector of the 3N names being satisfied
+        bool m_first;
+        bool m_subSector;
+        bool m_sentSomething;
+      };
+
+      /**
+       * @brief Satisfy the 3N name dst aggregated on state.m_incoming
+       */
+      void
+      SatisfyDestination (SatisfyState &state, Ptr<const NNNAddress> dst);
+
       /**
        * @brief Actual procedure to satisfy Interest
        *
@@ -660,6 +861,22 @@ namespace ns3
                            Ptr<Face> inFace,
                            Ptr<const ndn::Interest> interest,
                            Ptr<pit::Entry> pitEntry);
+
+      /**
+       * @brief Next hop (Face, PoA) for a DO or DU PDU heading to dst
+       *
+       * SatisfyPendingInterest calls it with skip 0, DoPropagateInterest
+       * with skip 0, 1, ... until a Face takes the PDU. The base class uses
+       * the skip-th next hop of the closest sector in the NNST.
+       *
+       * Returns 0 when no NNST entry leads to dst, callers drop the PDU.
+       *
+       * @param dst  3N name the PDU is heading to
+       * @param flow ICN name of the Interest or Data carried by the PDU
+       * @param skip number of next hops already tried
+       */
+      virtual const nnst::FaceMetric *
+      SelectNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip);
     protected:
       // inherited from Object class
       virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
@@ -671,6 +888,7 @@ namespace ns3
       Ptr<NNST> m_awaiting_response; /// \brief Reference to awaiting response, using NNST
 
       Ptr<FaceContainer> m_faces; ///< \brief List of Faces attached to this node
+      std::vector<Address> m_node_poas; ///< \brief Sorted PoA names of the non application Faces, kept by AddFace/RemoveFace
       Ptr<NamesContainer> m_node_names; ///< \brief 3N names container for personal names
       Ptr<NamesContainer> m_leased_names; ///< \brief 3N names container for node leased names
 
@@ -682,17 +900,21 @@ namespace ns3
 
       std::map <Ptr<const NNNAddress>, Time, PtrNNNComp> m_node_lease_times;
       std::set <Ptr<Face>, PtrFaceComp> m_returnEN_faces;
+      std::map <NNNAddress, NNNAddress> m_migrations; ///< \brief Leaving 3N names and the predicted sectors their PDUs are tunnelled to
 
       bool m_cacheUnsolicitedDataFromApps;
       bool m_cacheUnsolicitedData;
       bool m_detectRetransmissions;
       bool m_produce3Nnames;
+      bool m_compactSignalling; ///< \brief Send created mechanism PDUs as B_NNN
+      bool m_bufferMigration; ///< \brief Migrate buffered PDUs to the sector predicted in DENs
 
       Time m_3n_lease_time;
       Time m_3n_lease_ack_timeout;
       Time m_3n_lifetime;
       Time m_ack_timeout;
       int32_t m_standardMetric;
+      std::string m_limitsClass; ///< \brief TypeId of the Limits aggregated to non application Faces
       uint64_t m_producedNameNumber;
       bool m_on_ren_oen;
       bool m_sent_ren;
@@ -0,0 +1,345 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-rtt-multipath.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-rtt-multipath.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-rtt-multipath.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-rtt-multipath.h"
+
+#include "../nnn-pdus.h"
+#include "../pit/nnn-pit-entry.h"
+#include "../pit/nnn-pit-entry-outgoing-face.h"
+#include "../nnst/nnn-nnst.h"
+#include "../nnst/nnn-nnst-entry.h"
+#include "../nnst/nnn-nnst-entry-facemetric.h"
+
+#include <ns3-dev/ns3/double.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/string.h>
+
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace fw
+    {
+      NS_OBJECT_ENSURE_REGISTERED (RttMultipath);
+
+      NS_LOG_COMPONENT_DEFINE (RttMultipath::GetLogName ().c_str ());
+
+      std::string
+      RttMultipath::GetLogName ()
+      {
+	return super::GetLogName () + ".RttMultipath";
+      }
+
+      TypeId
+      RttMultipath::GetTypeId (void)
+      {
+	static TypeId tid = TypeId ("ns3::nnn::fw::RttMultipath")
+	    .SetGroupName ("Nnn")
+	    .SetParent<ForwardingStrategy> ()
+	    .AddConstructor<RttMultipath> ()
+
+	    .AddAttribute ("FlowTimeout", "Idle time after which a flow may be given another next hop",
+	                   StringValue ("1s"),
+	                   MakeTimeAccessor (&RttMultipath::m_flowTimeout),
+	                   MakeTimeChecker ())
+	    .AddAttribute ("YellowWeight", "Fraction of its weight a YELLOW next hop keeps",
+	                   DoubleValue (0.25),
+	                   MakeDoubleAccessor (&RttMultipath::m_yellowWeight),
+	                   MakeDoubleChecker<double> (0.0, 1.0))
+	    ;
+	return tid;
+      }
+
+      RttMultipath::RttMultipath ()
+      {
+      }
+
+      RttMultipath::~RttMultipath ()
+      {
+      }
+
+      void
+      RttMultipath::DoDispose ()
+      {
+	Simulator::Cancel (m_cleanFlows);
+	m_flows.clear ();
+	m_credits.clear ();
+	m_measured.clear ();
+
+	super::DoDispose ();
+      }
+
+      uint32_t
+      RttMultipath::GetNFlows () const
+      {
+	return m_flows.size ();
+      }
+
+      const nnst::FaceMetric *
+      RttMultipath::SelectNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip)
+      {
+	NS_LOG_FUNCTION (this << dst << flow << skip);
+
+	Ptr<nnst::Entry> entry = m_nnst->ClosestSector (dst);
+	if (entry == 0 || entry->m_faces.size () < 2)
+	  return super::SelectNextHop (dst, flow, skip);
+
+	const nnst::FaceMetricSet &hops = entry->m_faces;
+	uint32_t chosen = PickNextHop (dst, flow, hops);
+	if (chosen == hops.size ())
+	  return super::SelectNextHop (dst, flow, skip);
+
+	// The next hop of the flow first, then the others in (status, routing cost) order
+	skip %= hops.size ();
+	if (skip == 0)
+	  return &hops[chosen];
+	else if (skip <= chosen)
+	  return &hops[skip - 1];
+	else
+	  return &hops[skip];
+      }
+
+      uint32_t
+      RttMultipath::PickNextHop (const NNNAddress &dst, const ndn::Name &flow, const nnst::FaceMetricSet &hops)
+      {
+	Time now = Simulator::Now ();
+
+	Time fastest;
+	for (uint32_t i = 0; i < hops.size (); i++)
+	  {
+	    Time srtt = hops[i].GetSRtt ();
+	    if (!srtt.IsZero () && (fastest.IsZero () || srtt < fastest))
+	      fastest = srtt;
+	  }
+
+	std::vector<double> weights (hops.size (), 0.0);
+	double total = 0;
+	for (uint32_t i = 0; i < hops.size (); i++)
+	  {
+	    weights[i] = GetWeight (hops[i], fastest);
+	    total += weights[i];
+	  }
+
+	if (total <= 0)
+	  return hops.size ();
+
+	FlowKey key (dst, flow.size () > 1 ? flow.getPrefix (flow.size () - 1) : flow);
+
+	// Keep the next hop of an active flow while it can take the flow
+	std::map<FlowKey, Flow>::iterator item = m_flows.find (key);
+	if (item != m_flows.end () && now - item->second.m_lastUse < m_flowTimeout)
+	  {
+	    for (uint32_t i = 0; i < hops.size (); i++)
+	      {
+		if (hops[i].GetFace () == item->second.m_face && hops[i].GetAddress () == item->second.m_poa)
+		  {
+		    if (weights[i] <= 0)
+		      break;
+
+		    item->second.m_lastUse = now;
+		    return i;
+		  }
+	      }
+	  }
+
+	// Smooth weighted round robin over the usable next hops
+	uint32_t chosen = hops.size ();
+	double chosenCredit = 0;
+	for (uint32_t i = 0; i < hops.size (); i++)
+	  {
+	    if (weights[i] <= 0)
+	      continue;
+
+	    double &credit = m_credits[NextHopKey (hops[i].GetFace ()->GetId (), hops[i].GetAddress ())];
+	    credit += weights[i] / total;
+
+	    if (chosen == hops.size () || credit > chosenCredit)
+	      {
+		chosen = i;
+		chosenCredit = credit;
+	      }
+	  }
+
+	m_credits[NextHopKey (hops[chosen].GetFace ()->GetId (), hops[chosen].GetAddress ())] -= 1.0;
+
+	Flow &held = m_flows[key];
+	held.m_face = hops[chosen].GetFace ();
+	held.m_poa = hops[chosen].GetAddress ();
+	held.m_lastUse = now;
+
+	NS_LOG_INFO ("Flow " << key.second << " to (" << dst << ") now uses " << held.m_poa
+	             << " on Face " << held.m_face->GetId () << " with weight " << weights[chosen] / total);
+
+	if (!m_cleanFlows.IsRunning ())
+	  m_cleanFlows = Simulator::Schedule (m_flowTimeout, &RttMultipath::CleanFlows, this);
+
+	return chosen;
+      }
+
+      double
+      RttMultipath::GetWeight (const nnst::FaceMetric &metric, const Time &fastest) const
+      {
+	if (!metric.GetFace ()->IsUp () || metric.GetStatus () == nnst::FaceMetric::NNN_NNST_RED)
+	  return 0;
+
+	// Next hops not measured yet are taken as the fastest, so they get probed
+	Time srtt = metric.GetSRtt ().IsZero () ? fastest : metric.GetSRtt ();
+	double weight = srtt.IsZero () ? 1.0 : 1.0 / srtt.GetSeconds ();
+
+	if (metric.GetStatus () == nnst::FaceMetric::NNN_NNST_YELLOW)
+	  weight *= m_yellowWeight;
+
+	return weight;
+      }
+
+      bool
+      RttMultipath::TrySendOutInterest (Ptr<NNNPDU> pdu,
+                                        Ptr<Face> inFace,
+                                        Ptr<Face> outFace,
+                                        Address addr,
+                                        Ptr<const ndn::Interest> interest,
+                                        Ptr<pit::Entry> pitEntry)
+      {
+	if (!super::TrySendOutInterest (pdu, inFace, outFace, addr, interest, pitEntry))
+	  return false;
+
+	// Remember the NNST entry used, to measure it once the Data comes back
+	Ptr<DO> do_i = DynamicCast<DO> (pdu);
+	Ptr<DU> du_i = DynamicCast<DU> (pdu);
+
+	Ptr<nnst::Entry> entry;
+	if (do_i != 0)
+	  entry = m_nnst->ClosestSector (do_i->GetName ());
+	else if (du_i != 0)
+	  entry = m_nnst->ClosestSector (du_i->GetDstName ());
+
+	if (entry != 0 && entry->m_faces.HasFace (outFace))
+	  {
+	    m_measured[pitEntry] = entry->GetAddressPtr ();
+
+	    if (!m_cleanFlows.IsRunning ())
+	      m_cleanFlows = Simulator::Schedule (m_flowTimeout, &RttMultipath::CleanFlows, this);
+	  }
+
+	return true;
+      }
+
+      void
+      RttMultipath::WillSatisfyPendingInterest (Ptr<Face> inFace,
+                                                Ptr<pit::Entry> pitEntry)
+      {
+	NS_LOG_FUNCTION (this);
+
+	std::map<Ptr<pit::Entry>, Ptr<const NNNAddress> >::iterator measured = m_measured.find (pitEntry);
+	if (measured != m_measured.end ())
+	  {
+	    pit::Entry::out_iterator out = pitEntry->GetOutgoing ().end ();
+	    if (inFace != 0)
+	      out = pitEntry->GetOutgoing ().find (inFace);
+
+	    if (out != pitEntry->GetOutgoing ().end ())
+	      {
+		m_nnst->UpdateFaceRtt (*measured->second, inFace, Simulator::Now () - out->m_sendTime);
+		m_nnst->UpdateStatus (*measured->second, inFace, nnst::FaceMetric::NNN_NNST_GREEN);
+	      }
+
+	    m_measured.erase (measured);
+	  }
+
+	super::WillSatisfyPendingInterest (inFace, pitEntry);
+      }
+
+      void
+      RttMultipath::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
+      {
+	NS_LOG_FUNCTION (this);
+
+	std::map<Ptr<pit::Entry>, Ptr<const NNNAddress> >::iterator measured = m_measured.find (pitEntry);
+	if (measured != m_measured.end ())
+	  {
+	    for (pit::Entry::out_iterator face = pitEntry->GetOutgoing ().begin ();
+		face != pitEntry->GetOutgoing ().end ();
+		face++)
+	      {
+		m_nnst->UpdateStatus (*measured->second, face->m_face, nnst::FaceMetric::NNN_NNST_YELLOW);
+	      }
+
+	    m_measured.erase (measured);
+	  }
+
+	super::WillEraseTimedOutPendingInterest (pitEntry);
+      }
+
+      void
+      RttMultipath::RemoveFace (Ptr<Face> face)
+      {
+	NS_LOG_FUNCTION (this << face->GetId ());
+
+	for (std::map<FlowKey, Flow>::iterator item = m_flows.begin (); item != m_flows.end (); )
+	  {
+	    if (item->second.m_face == face)
+	      m_flows.erase (item++);
+	    else
+	      ++item;
+	  }
+
+	for (std::map<NextHopKey, double>::iterator item = m_credits.begin (); item != m_credits.end (); )
+	  {
+	    if (item->first.first == face->GetId ())
+	      m_credits.erase (item++);
+	    else
+	      ++item;
+	  }
+
+	super::RemoveFace (face);
+      }
+
+      void
+      RttMultipath::CleanFlows ()
+      {
+	NS_LOG_FUNCTION (this);
+	Time now = Simulator::Now ();
+
+	for (std::map<FlowKey, Flow>::iterator item = m_flows.begin (); item != m_flows.end (); )
+	  {
+	    if (now - item->second.m_lastUse >= m_flowTimeout)
+	      m_flows.erase (item++);
+	    else
+	      ++item;
+	  }
+
+	// Interests whose PIT entry went away without being satisfied or timing out
+	for (std::map<Ptr<pit::Entry>, Ptr<const NNNAddress> >::iterator item = m_measured.begin (); item != m_measured.end (); )
+	  {
+	    if (item->first->GetExpireTime () < now)
+	      m_measured.erase (item++);
+	    else
+	      ++item;
+	  }
+
+	if (!m_flows.empty () || !m_measured.empty ())
+	  m_cleanFlows = Simulator::Schedule (m_flowTimeout, &RttMultipath::CleanFlows, this);
+      }
+
+    } /* namespace fw */
+  } /* namespace nnn */
+} /* namespace ns3 */
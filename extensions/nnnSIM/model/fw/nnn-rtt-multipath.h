@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-rtt-multipath.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-rtt-multipath.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-rtt-multipath.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_RTT_MULTIPATH_H_
+#define NNN_RTT_MULTIPATH_H_
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <ns3-dev/ns3/event-id.h>
+
+#include "nnn-forwarding-strategy.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnst
+    {
+      class FaceMetricSet;
+    }
+
+    namespace fw
+    {
+      /**
+       * @ingroup nnn-fw
+       * @brief Spreads the DO and DU PDUs heading to a 3N name over all the
+       * next hops of its NNST entry
+       *
+       * A flow (3N destination and ICN name without its last component) is
+       * given the next hop with the largest credit, in smooth weighted round
+       * robin. The weight of a next hop is the inverse of its SRTT, reduced
+       * by YellowWeight when it is YELLOW and zero when it is RED or its Face
+       * is down. A flow keeps its next hop, so its PDUs are not reordered,
+       * until the next hop disappears or gets weight zero, or the flow has
+       * been idle for FlowTimeout.
+       *
+       * The SRTT of the next hops is measured with the Interests carried by
+       * DO and DU PDUs, and a next hop goes YELLOW when they time out.
+       */
+      class RttMultipath : public ForwardingStrategy
+      {
+      private:
+	typedef ForwardingStrategy super;
+
+      public:
+	static TypeId GetTypeId ();
+
+	/**
+	 * @brief Helper function to retrieve logging name for the forwarding strategy
+	 */
+	static std::string GetLogName ();
+
+	RttMultipath ();
+	virtual ~RttMultipath ();
+
+	/**
+	 * @brief Number of flows holding a next hop
+	 */
+	uint32_t
+	GetNFlows () const;
+
+	virtual void
+	WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry);
+
+	virtual void
+	RemoveFace (Ptr<Face> face);
+
+      protected:
+	virtual void
+	WillSatisfyPendingInterest (Ptr<Face> inFace,
+	                            Ptr<pit::Entry> pitEntry);
+
+	virtual bool
+	TrySendOutInterest (Ptr<NNNPDU> pdu,
+	                    Ptr<Face> inFace,
+	                    Ptr<Face> outFace,
+	                    Address addr,
+	                    Ptr<const ndn::Interest> interest,
+	                    Ptr<pit::Entry> pitEntry);
+
+	virtual const nnst::FaceMetric *
+	SelectNextHop (const NNNAddress &dst, const ndn::Name &flow, uint32_t skip);
+
+	virtual void DoDispose (); ///< @brief Do cleanup
+
+      private:
+	/**
+	 * @brief Position in hops of the next hop of flow, hops.size () if
+	 * none of them can take it
+	 */
+	uint32_t
+	PickNextHop (const NNNAddress &dst, const ndn::Name &flow, const nnst::FaceMetricSet &hops);
+
+	/**
+	 * @brief Share of the flows for metric, fastest being the lowest SRTT
+	 * measured among its NNST entry
+	 */
+	double
+	GetWeight (const nnst::FaceMetric &metric, const Time &fastest) const;
+
+	/**
+	 * @brief Forget the idle flows and the Interests that are no longer pending
+	 */
+	void
+	CleanFlows ();
+
+	/// @brief (3N destination, ICN name without its last component)
+	typedef std::pair<NNNAddress, ndn::Name> FlowKey;
+
+	/// @brief (Face id, PoA) of a next hop
+	typedef std::pair<uint32_t, Address> NextHopKey;
+
+	struct Flow
+	{
+	  Ptr<Face> m_face;
+	  Address m_poa;
+	  Time m_lastUse;
+	};
+
+	std::map<FlowKey, Flow> m_flows; ///< \brief Next hop held by each flow
+	std::map<NextHopKey, double> m_credits; ///< \brief Smooth weighted round robin credit of each next hop
+	std::map<Ptr<pit::Entry>, Ptr<const NNNAddress> > m_measured; ///< \brief NNST entry the pending Interests were sent to
+
+	Time m_flowTimeout;
+	double m_yellowWeight;
+	EventId m_cleanFlows;
+      };
+
+    } /* namespace fw */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_RTT_MULTIPATH_H_ */
@@ -440,6 +440,10 @@ namespace ns3
       try
       {
 	  NNN_PDU_TYPE type = HeaderHelper::GetNNNHeaderType (packet);
+
+	  // The decoded payload must not look like a classified 3N PDU
+	  HeaderHelper::UntagNNNHeader (packet);
+
 	  switch (type)
 	  {
 	    case nnn::NULL_NNN:
@@ -30,6 +30,9 @@ namespace ns3
       :m_oldName        (Create<const NNNAddress> ())
       ,m_newName        (Create<const NNNAddress> ())
       ,m_lease_expire   (Seconds (0))
+      ,m_oldHash        (AddressHash (*m_oldName))
+      ,m_newHash        (AddressHash (*m_newName))
+      ,m_latest         (m_newName)
       {
       }
 
@@ -40,6 +43,9 @@ namespace ns3
       :m_oldName        (oldName)
       ,m_newName        (newName)
       ,m_lease_expire   (lease_expire)
+      ,m_oldHash        (AddressHash (*oldName))
+      ,m_newHash        (AddressHash (*newName))
+      ,m_latest         (newName)
       {
       }
     } /* namespace nnpt */
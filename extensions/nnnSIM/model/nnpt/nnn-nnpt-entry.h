@@ -29,6 +29,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index/tag.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <ns3-dev/ns3/ptr.h>
 #include <ns3-dev/ns3/simple-ref-count.h>
@@ -49,6 +50,19 @@ namespace ns3
   {
     namespace nnpt
     {
+      /**
+       * @ingroup nnn-nnpt
+       * @brief Hash of a 3N name, over all the bytes of its labels
+       */
+      inline std::size_t
+      AddressHash (const NNNAddress &name)
+      {
+	std::size_t seed = 0;
+	for (NNNAddress::const_iterator it = name.begin (); it != name.end (); ++it)
+	  boost::hash_combine (seed, boost::hash_range (it->begin (), it->end ()));
+	return seed;
+      }
+
       /**
        * @ingroup nnn-nnpt
        * @brief structure for PIT entry
@@ -71,6 +85,15 @@ namespace ns3
 	Ptr<const NNNAddress> m_oldName;
 	Ptr<const NNNAddress> m_newName;
 	Time m_lease_expire;
+
+	std::size_t m_oldHash; ///< \brief AddressHash of m_oldName, computed once
+	std::size_t m_newHash; ///< \brief AddressHash of m_newName, computed once
+
+	// Shortcut further down the chain of new names, left by
+	// NNPT::findPairedNamePtr and reset to m_newName when an entry
+	// further down is removed. Not part of any index, so it can be
+	// changed in place
+	mutable Ptr<const NNNAddress> m_latest; ///< \brief Last name of the chain seen from this entry
       };
 
       inline std::ostream &
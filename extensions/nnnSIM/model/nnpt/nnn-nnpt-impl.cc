@@ -0,0 +1,44 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-impl.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-impl.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-impl.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "nnn-nnpt-impl.h"
+
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
+    static struct X ## type ## templ ## RegistrationClass \
+    {                                                     \
+  X ## type ## templ ## RegistrationClass () {        \
+      ns3::TypeId tid = type<templ>::GetTypeId ();      \
+      tid.GetParent ();                                 \
+    }                                                   \
+    } x_ ## type ## templ ## RegistrationVariable
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnpt
+    {
+      // explicit instantiation and registering
+      template class NNPTImpl<ordered_names_traits>;
+      template class NNPTImpl<hashed_names_traits>;
+
+      NS_OBJECT_ENSURE_REGISTERED_TEMPL(NNPTImpl, ordered_names_traits);
+      NS_OBJECT_ENSURE_REGISTERED_TEMPL(NNPTImpl, hashed_names_traits);
+    } /* namespace nnpt */
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,662 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-impl.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-impl.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-impl.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_NNPT_IMPL_H_
+#define NNN_NNPT_IMPL_H_
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+
+#include "nnn-nnpt.h"
+#include "nnn-nnpt-entry.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnpt
+    {
+      /**
+       * @ingroup nnn-nnpt
+       * @brief Key of the hashed name indexes, a name with its hash
+       *
+       * Stored entries give the hash they computed once (nnpt::Entry
+       * m_oldHash and m_newHash), so rehashing never walks the labels
+       * and equality only compares labels when the hashes agree
+       */
+      struct HashedName
+      {
+	HashedName (std::size_t hash, const NNNAddress *name) : m_hash (hash), m_name (name) {}
+
+	std::size_t m_hash;
+	const NNNAddress *m_name;
+      };
+
+      struct HashedNameHash
+      {
+	std::size_t operator () (const HashedName &name) const { return name.m_hash; }
+      };
+
+      struct HashedNameEqual
+      {
+	bool operator () (const HashedName &lhs, const HashedName &rhs) const
+	{
+	  return lhs.m_hash == rhs.m_hash && *lhs.m_name == *rhs.m_name;
+	}
+      };
+
+      struct OldHashedName
+      {
+	typedef HashedName result_type;
+	result_type operator () (const Entry &entry) const { return HashedName (entry.m_oldHash, PeekPointer (entry.m_oldName)); }
+      };
+
+      struct NewHashedName
+      {
+	typedef HashedName result_type;
+	result_type operator () (const Entry &entry) const { return HashedName (entry.m_newHash, PeekPointer (entry.m_newName)); }
+      };
+
+      /**
+       * @ingroup nnn-nnpt
+       * @brief Traits for an NNPT finding names through ordered indexes
+       * (NNNAddress comparisons, O(log n) of them per lookup)
+       */
+      struct ordered_names_traits
+      {
+	static std::string GetName () { return "Ordered"; }
+
+	typedef Ptr<const NNNAddress> key_type;
+
+	static key_type
+	Key (Ptr<const NNNAddress> name)
+	{
+	  return name;
+	}
+
+	typedef multi_index_container<
+	    Entry,
+	    indexed_by<
+	      ordered_unique<
+	        tag<NNPT::st_lease>,
+	        identity<Entry>
+	      >,
+
+	      ordered_unique<
+	        tag<NNPT::oldname>,
+	        member<Entry,Ptr<const NNNAddress>,&Entry::m_oldName>,
+	        NNPT::PtrNNNComp
+	      >,
+
+	      ordered_unique<
+	        tag<NNPT::newname>,
+	        member<Entry,Ptr<const NNNAddress>,&Entry::m_newName>,
+	        NNPT::PtrNNNComp
+	      >
+	    >
+	> pair_set;
+      };
+
+      /**
+       * @ingroup nnn-nnpt
+       * @brief Traits for an NNPT finding names through hashed indexes,
+       * only the lease index is ordered
+       */
+      struct hashed_names_traits
+      {
+	static std::string GetName () { return "Hashed"; }
+
+	typedef HashedName key_type;
+
+	static key_type
+	Key (Ptr<const NNNAddress> name)
+	{
+	  return HashedName (AddressHash (*name), PeekPointer (name));
+	}
+
+	typedef multi_index_container<
+	    Entry,
+	    indexed_by<
+	      ordered_unique<
+	        tag<NNPT::st_lease>,
+	        identity<Entry>
+	      >,
+
+	      hashed_unique<
+	        tag<NNPT::oldname>,
+	        OldHashedName,
+	        HashedNameHash,
+	        HashedNameEqual
+	      >,
+
+	      hashed_unique<
+	        tag<NNPT::newname>,
+	        NewHashedName,
+	        HashedNameHash,
+	        HashedNameEqual
+	      >
+	    >
+	> pair_set;
+      };
+
+      /**
+       * @ingroup nnn-nnpt
+       * @brief Class implementing NNPT structure & functionality, with
+       * the name indexes given by Traits
+       */
+      template<class Traits>
+      class NNPTImpl : public NNPT
+      {
+      public:
+	typedef typename Traits::pair_set pair_set;
+	typedef typename pair_set::template index<oldname>::type pair_set_by_oldname;
+	typedef typename pair_set::template index<newname>::type pair_set_by_newname;
+	typedef typename pair_set::template index<st_lease>::type pair_set_by_lease;
+
+	/**
+	 * \brief Interface ID
+	 *
+	 * \return interface ID
+	 */
+	static TypeId GetTypeId ();
+
+	NNPTImpl ();
+
+	virtual
+	~NNPTImpl ();
+
+	virtual void
+	addEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName, Time lease_expire);
+
+	virtual void
+	deleteEntry (Ptr<const NNNAddress> oldName);
+
+	virtual void
+	deleteEntry (Entry nnptEntry);
+
+	virtual void
+	deleteEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName);
+
+	virtual bool
+	foundOldName (Ptr<const NNNAddress> name);
+
+	virtual bool
+	foundNewName (Ptr<const NNNAddress> name);
+
+	virtual Ptr<const NNNAddress>
+	findPairedNamePtr (Ptr<const NNNAddress> oldName);
+
+	virtual Ptr<const NNNAddress>
+	findPairedOldNamePtr (Ptr<const NNNAddress> newName);
+
+	virtual Entry
+	findEntry (Ptr<const NNNAddress> name);
+
+	virtual void
+	updateLeaseTime (Ptr<const NNNAddress> oldName, Time lease_expire);
+
+	virtual uint32_t
+	size ();
+
+	virtual void
+	cleanExpired ();
+
+	virtual void
+	Print (std::ostream &os) const;
+
+	virtual void
+	printByAddress ();
+
+	virtual void
+	printByLease ();
+
+	pair_set container;
+
+      protected:
+	virtual void
+	EnforceMaxSize (Ptr<const NNNAddress> keep);
+
+      private:
+	/**
+	 *  \brief Invalidate the shortcuts of the entries leading to oldName,
+	 *  the old name of a removed entry, as they may go past it
+	 *
+	 *  Chains only grow at their end, so only the entries before the
+	 *  removed one can hold a shortcut through it
+	 */
+	void
+	InvalidateShortcuts (Ptr<const NNNAddress> oldName);
+
+	/**
+	 *  \brief Fill out with the entries in oldName order, which the
+	 *  hashed indexes do not keep
+	 */
+	void
+	SortedByOldName (std::vector<const Entry*> &out) const;
+
+	struct OldNameLess
+	{
+	  bool operator () (const Entry *lhs, const Entry *rhs) const { return *lhs->m_oldName < *rhs->m_oldName; }
+	};
+
+	static LogComponent g_log; ///< @brief Logging variable
+      };
+
+      //////////////////////////////////////////
+      ////////// Implementation ////////////////
+      //////////////////////////////////////////
+
+      template<class Traits>
+      LogComponent NNPTImpl< Traits >::g_log = LogComponent (("nnn.nnpt." + Traits::GetName ()).c_str ());
+
+      template<class Traits>
+      TypeId
+      NNPTImpl< Traits >::GetTypeId ()
+      {
+	static TypeId tid = TypeId (("ns3::nnn::nnpt::"+Traits::GetName ()).c_str ())
+	.SetGroupName ("Nnn")
+	.SetParent<NNPT> ()
+	.AddConstructor< NNPTImpl< Traits > > ()
+	;
+	return tid;
+      }
+
+      template<class Traits>
+      NNPTImpl<Traits>::NNPTImpl ()
+      {
+      }
+
+      template<class Traits>
+      NNPTImpl<Traits>::~NNPTImpl ()
+      {
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::addEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName, Time lease_expire)
+      {
+	NS_LOG_FUNCTION (this << *oldName << *newName << lease_expire);
+
+	if (!foundOldName(oldName) && !foundOldName(newName))
+	  {
+	    // We assume that the lease time gives us the absolute expiry time
+	    // We need to calculate the relative time for the Schedule function
+	    Time now = Simulator::Now ();
+	    Time relativeExpireTime = lease_expire - now;
+
+	    NS_LOG_INFO ("addEntry : Checking remaining lease time " << relativeExpireTime << " for (" << *newName << ") at " << now);
+
+	    // If the relative expire time is above 0, we can save it
+	    if (relativeExpireTime.IsStrictlyPositive())
+	      {
+		NS_LOG_INFO ("addEntry : Adding entry for (" << *oldName << ") ->  (" << *newName  << ")");
+		container.insert(Entry(oldName, newName, lease_expire));
+		Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
+		EnforceMaxSize (oldName);
+		UpdateSize ();
+	      }
+	  }
+	else
+	  {
+	    NS_LOG_INFO("addEntry : Found either " << *oldName << " or " << *newName << " already in NNPT");
+	  }
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::deleteEntry (Ptr<const NNNAddress> oldName)
+      {
+	NS_LOG_FUNCTION (this);
+	pair_set_by_oldname& pair_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = pair_index.find(Traits::Key (oldName));
+
+	if (it != pair_index.end())
+	  {
+	    Ptr<const NNNAddress> removed = it->m_oldName;
+	    pair_index.erase(it);
+	    InvalidateShortcuts (removed);
+	    UpdateSize ();
+	  }
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::deleteEntry (Entry nnptEntry)
+      {
+	NS_LOG_FUNCTION (this);
+	typename pair_set::iterator it = container.find(nnptEntry);
+
+	if (it != container.end())
+	  {
+	    Ptr<const NNNAddress> removed = it->m_oldName;
+	    container.erase(it);
+	    InvalidateShortcuts (removed);
+	  }
+	UpdateSize ();
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::deleteEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName)
+      {
+	NS_LOG_FUNCTION (this);
+	pair_set_by_oldname& pair_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = pair_index.find(Traits::Key (oldName));
+
+	if (it != pair_index.end() && *it->m_newName == *newName)
+	  {
+	    Ptr<const NNNAddress> removed = it->m_oldName;
+	    pair_index.erase(it);
+	    InvalidateShortcuts (removed);
+	    UpdateSize ();
+	  }
+      }
+
+      template<class Traits>
+      bool
+      NNPTImpl<Traits>::foundOldName (Ptr<const NNNAddress> name)
+      {
+	NS_LOG_FUNCTION (this);
+	pair_set_by_oldname& names_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = names_index.find(Traits::Key (name));
+
+	if (it == names_index.end())
+	  {
+	    NS_LOG_INFO ("Didn't find old name (" << *name << ")");
+	    return false;
+	  }
+	else
+	  {
+	    NS_LOG_INFO ("Found old name (" << *name << ")");
+	    return true;
+	  }
+      }
+
+      template<class Traits>
+      bool
+      NNPTImpl<Traits>::foundNewName (Ptr<const NNNAddress> name)
+      {
+	NS_LOG_FUNCTION (this << *name);
+	pair_set_by_newname& names_index = container.template get<newname> ();
+	typename pair_set_by_newname::iterator it = names_index.find(Traits::Key (name));
+
+	if (it == names_index.end())
+	  {
+	    NS_LOG_INFO ("Didn't find new name (" << *name << ")");
+	    return false;
+	  }
+	else
+	  {
+	    NS_LOG_INFO ("Found new name (" << *name << ")");
+	    return true;
+	  }
+      }
+
+      template<class Traits>
+      Ptr<const NNNAddress>
+      NNPTImpl<Traits>::findPairedNamePtr (Ptr<const NNNAddress> oldName)
+      {
+	NS_LOG_FUNCTION (this << *oldName);
+	pair_set_by_oldname& pair_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = pair_index.find(Traits::Key (oldName));
+
+	if (it == pair_index.end())
+	  return oldName;
+
+	// Find the last name of the chain, taking the valid shortcuts
+	Ptr<const NNNAddress> latest;
+	typename pair_set_by_oldname::iterator hop = it;
+	while (hop != pair_index.end())
+	  {
+	    latest = hop->m_latest;
+	    hop = pair_index.find(Traits::Key (latest));
+	  }
+
+	// Go over the same entries again, pointing them all at it
+	hop = it;
+	while (hop != pair_index.end())
+	  {
+	    Ptr<const NNNAddress> next = hop->m_latest;
+	    hop->m_latest = latest;
+	    hop = pair_index.find(Traits::Key (next));
+	  }
+
+	return latest;
+      }
+
+      template<class Traits>
+      Ptr<const NNNAddress>
+      NNPTImpl<Traits>::findPairedOldNamePtr (Ptr<const NNNAddress> newName)
+      {
+	NS_LOG_FUNCTION (this << *newName);
+	pair_set_by_newname& pair_index = container.template get<newname> ();
+	typename pair_set_by_newname::iterator it = pair_index.find(Traits::Key (newName));
+
+	if (it != pair_index.end ())
+	  {
+	    Ptr<const NNNAddress> oldest;
+	    // Check if there is an older entry
+	    while (it != pair_index.end ())
+	      {
+		oldest = it->m_oldName;
+		it = pair_index.find (Traits::Key (oldest));
+	      }
+	    return oldest;
+	  }
+	else
+	  {
+	    return newName;
+	  }
+      }
+
+      template<class Traits>
+      Entry
+      NNPTImpl<Traits>::findEntry (Ptr<const NNNAddress> name)
+      {
+	NS_LOG_FUNCTION (this << *name);
+	pair_set_by_oldname& pair_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = pair_index.find(Traits::Key (name));
+
+	if (it != pair_index.end())
+	  {
+	    return *it;
+	  }
+	else
+	  {
+	    return Entry ();
+	  }
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::updateLeaseTime (Ptr<const NNNAddress> oldName, Time lease_expire)
+      {
+	NS_LOG_FUNCTION (this << *oldName << lease_expire);
+	pair_set_by_oldname& pair_index = container.template get<oldname> ();
+	typename pair_set_by_oldname::iterator it = pair_index.find(Traits::Key (oldName));
+
+	Time relativeExpireTime = lease_expire - Simulator::Now ();
+
+	// If the relative expire time is above 0, schedule the next clean
+	if (relativeExpireTime.IsStrictlyPositive())
+	  {
+	    if (it != pair_index.end())
+	      {
+		Entry tmp = *it;
+
+		tmp.m_lease_expire = lease_expire;
+
+		if (pair_index.replace(it, tmp))
+		  {
+		    Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
+		  }
+	      }
+	  }
+      }
+
+      template<class Traits>
+      uint32_t
+      NNPTImpl<Traits>::size ()
+      {
+	NS_LOG_FUNCTION (this);
+	return container.size();
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::EnforceMaxSize (Ptr<const NNNAddress> keep)
+      {
+	if (m_maxSize == 0)
+	  return;
+
+	pair_set_by_lease& lease_index = container.template get<st_lease> ();
+
+	while (container.size () > m_maxSize)
+	  {
+	    typename pair_set_by_lease::iterator victim = lease_index.begin ();
+	    if (keep != 0 && *victim->m_oldName == *keep)
+	      ++victim;
+
+	    if (victim == lease_index.end ())
+	      break;
+
+	    NS_LOG_INFO ("Evicting (" << *victim->m_oldName << ") -> (" << *victim->m_newName << ") with lease " << victim->m_lease_expire);
+	    Ptr<const NNNAddress> removed = victim->m_oldName;
+	    lease_index.erase (victim);
+	    InvalidateShortcuts (removed);
+	    m_evictions++;
+	  }
+
+	UpdateSize ();
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::cleanExpired ()
+      {
+	NS_LOG_FUNCTION (this);
+	pair_set_by_lease& lease_index = container.template get<st_lease> ();
+	Time now = Simulator::Now ();
+
+	// The entry this clean was scheduled for may already be gone
+	// (deleted, evicted or renewed), so only take what is due
+	while (!lease_index.empty () && lease_index.begin ()->m_lease_expire <= now)
+	  {
+	    typename pair_set_by_lease::iterator it = lease_index.begin ();
+	    NS_LOG_INFO ("cleanExpired : removing (" << *it->m_oldName << ") -> (" << *it->m_newName << ")");
+	    Ptr<const NNNAddress> removed = it->m_oldName;
+	    lease_index.erase (it);
+	    InvalidateShortcuts (removed);
+	  }
+
+	UpdateSize ();
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::InvalidateShortcuts (Ptr<const NNNAddress> oldName)
+      {
+	pair_set_by_newname& pair_index = container.template get<newname> ();
+	typename pair_set_by_newname::iterator up = pair_index.find (Traits::Key (oldName));
+
+	// Walk the chain back from the removed entry
+	while (up != pair_index.end ())
+	  {
+	    up->m_latest = up->m_newName;
+	    up = pair_index.find (Traits::Key (up->m_oldName));
+	  }
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::SortedByOldName (std::vector<const Entry*> &out) const
+      {
+	const pair_set_by_oldname& pair_index = container.template get<oldname> ();
+
+	out.clear ();
+	for (typename pair_set_by_oldname::const_iterator it = pair_index.begin (); it != pair_index.end (); ++it)
+	  out.push_back (&(*it));
+
+	std::sort (out.begin (), out.end (), OldNameLess ());
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::Print (std::ostream &os) const
+      {
+	std::vector<const Entry*> entries;
+	SortedByOldName (entries);
+
+	for (typename std::vector<const Entry*>::const_iterator it = entries.begin (); it != entries.end (); ++it)
+	  os << **it;
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::printByAddress ()
+      {
+	std::cout << "Old Address\t| New Address\t| Lease Expire" << std::endl;
+	std::cout << "-------------------------------------------------" << std::endl;
+
+	Print (std::cout);
+      }
+
+      template<class Traits>
+      void
+      NNPTImpl<Traits>::printByLease ()
+      {
+	pair_set_by_lease& lease_index = container.template get<st_lease> ();
+	typename pair_set_by_lease::iterator it = lease_index.begin();
+
+	std::cout << "NNN Address\t| New Address\t| Lease Expire" << std::endl;
+	std::cout << "-------------------------------------------------" << std::endl;
+
+	while (it != lease_index.end ())
+	  {
+	    std::cout << *it;
+	    ++it;
+	  }
+      }
+
+      /**
+       * @ingroup nnn-nnpt
+       * @brief NNPT with ordered name indexes (default)
+       */
+      typedef NNPTImpl<ordered_names_traits> Ordered;
+
+      /**
+       * @ingroup nnn-nnpt
+       * @brief NNPT with hashed name indexes
+       */
+      typedef NNPTImpl<hashed_names_traits> Hashed;
+    } /* namespace nnpt */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_NNPT_IMPL_H_ */
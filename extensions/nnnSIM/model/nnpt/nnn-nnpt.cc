@@ -20,6 +20,8 @@
 #include "nnn-nnpt.h"
 
 #include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/trace-source-accessor.h>
+#include <ns3-dev/ns3/uinteger.h>
 
 NS_LOG_COMPONENT_DEFINE ("nnn.nnpt");
 
@@ -35,101 +37,28 @@ namespace ns3
       static TypeId tid = TypeId ("ns3::nnn::NNPT") // cheating ns3 object system
 	  .SetParent<Object> ()
 	  .SetGroupName ("Nnn")
-	  .AddConstructor<NNPT> ()
+	  .AddAttribute ("MaxSize",
+	                 "Set maximum number of entries in NNPT. If 0, limit is not enforced",
+	                 UintegerValue (0),
+	                 MakeUintegerAccessor (&NNPT::GetMaxSize,
+	                                       &NNPT::SetMaxSize),
+	                 MakeUintegerChecker<uint32_t> ())
+	  .AddTraceSource ("Evictions", "Evictions", MakeTraceSourceAccessor (&NNPT::m_evictions))
+	  .AddTraceSource ("Entries", "Number of entries", MakeTraceSourceAccessor (&NNPT::m_entries))
+	  .AddTraceSource ("Bytes", "Approximate memory held by the entries", MakeTraceSourceAccessor (&NNPT::m_bytes))
 	  ;
       return tid;
     }
 
-    NNPT::NNPT() {
-    }
-
-    NNPT::~NNPT() {
-    }
-
-    void
-    NNPT::addEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName, Time lease_expire)
+    NNPT::NNPT()
+    : m_maxSize   (0)
+    , m_evictions (0)
+    , m_entries   (0)
+    , m_bytes     (0)
     {
-      NS_LOG_FUNCTION (this << *oldName << *newName << lease_expire);
-
-      if (!foundOldName(oldName) && !foundOldName(newName))
-        {
-	  // We assume that the lease time gives us the absolute expiry time
-	  // We need to calculate the relative time for the Schedule function
-	  Time now = Simulator::Now ();
-	  Time relativeExpireTime = lease_expire - now;
-
-	  NS_LOG_INFO ("addEntry : Checking remaining lease time " << relativeExpireTime << " for (" << *newName << ") at " << now);
-
-          // If the relative expire time is above 0, we can save it
-          if (relativeExpireTime.IsStrictlyPositive())
-            {
-              NS_LOG_INFO ("addEntry : Adding entry for (" << *oldName << ") ->  (" << *newName  << ")");
-              container.insert(nnpt::Entry(oldName, newName, lease_expire));
-              Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
-            }
-        }
-      else
-        {
-          NS_LOG_INFO("addEntry : Found either " << *oldName << " or " << *newName << " already in NNPT");
-        }
     }
 
-    void
-    NNPT::deleteEntry (Ptr<const NNNAddress> oldName)
-    {
-      NS_LOG_FUNCTION (this);
-      nnpt::Entry tmp = findEntry (oldName);
-      container.erase(tmp);
-    }
-
-    void
-    NNPT::deleteEntry (nnpt::Entry nnptEntry)
-    {
-      NS_LOG_FUNCTION (this);
-      container.erase(nnptEntry);
-    }
-// Missing deleteEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName);
-
-    bool
-    NNPT::foundOldName (Ptr<const NNNAddress> name)
-    {
-      NS_LOG_FUNCTION (this);
-      pair_set_by_oldname& names_index = container.get<oldname> ();
-      pair_set_by_oldname::iterator it = names_index.find(name);
-
-      if (it == names_index.end())
-	{
-	  NS_LOG_INFO ("Didn't find old name (" << *name << ")");
-	  return false;
-	}
-      else
-	{
-	  NS_LOG_INFO ("Found old name (" << *name << ")");
-	  return true;
-	}
-    }
-
-    bool
-    NNPT::foundNewName (Ptr<const NNNAddress> name)
-    {
-      NS_LOG_FUNCTION (this << *name);
-      pair_set_by_newname& names_index = container.get<newname> ();
-      pair_set_by_newname::iterator it = names_index.find(name);
-
-      nnpt::Entry tmp = *it;
-
-      NS_LOG_INFO ("foundNewName : schedule errors " << tmp.m_lease_expire << " (" << tmp.m_oldName << ") -> (" << tmp.m_newName << ")" );
-
-      if (it == names_index.end())
-	{
-	  NS_LOG_INFO ("Didn't find new name (" << *name << ")");
-	  return false;
-	}
-      else
-	{
-	  NS_LOG_INFO ("Found new name (" << *name << ")");
-	  return true;
-	}
+    NNPT::~NNPT() {
     }
 
     const NNNAddress&
@@ -148,113 +77,24 @@ namespace ns3
       return *findPairedOldNamePtr(newName);
     }
 
-    Ptr<const NNNAddress>
-    NNPT::findPairedNamePtr (Ptr<const NNNAddress> oldName)
-    {
-      NS_LOG_FUNCTION (this << *oldName);
-      pair_set_by_oldname& pair_index = container.get<oldname> ();
-      pair_set_by_oldname::iterator it = pair_index.find(oldName);
-
-      if (it != pair_index.end())
-	{
-	  nnpt::Entry tmp;
-	  // Check if there is a newer entry
-	  while (true)
-	    {
-	      tmp = *it;
-	      it = pair_index.find(tmp.m_newName);
-	      if (it == pair_index.end())
-		break;
-	    }
-	  return tmp.m_newName;
-	}
-      else
-	{
-	  return oldName;
-	}
-    }
-
-    Ptr<const NNNAddress>
-    NNPT::findPairedOldNamePtr (Ptr<const NNNAddress> newName)
+    uint32_t
+    NNPT::GetMaxSize () const
     {
-      NS_LOG_FUNCTION (this << *newName);
-      pair_set_by_newname& pair_index = container.get<newname> ();
-      pair_set_by_newname::iterator it = pair_index.find(newName);
-
-      if (it != pair_index.end ())
-	{
-	  nnpt::Entry tmp;
-	  // Check if there is a newer entry
-	  while (true)
-	    {
-	      tmp = *it;
-	      it = pair_index.find (tmp.m_oldName);
-	      if (it == pair_index.end ())
-		break;
-	    }
-	  return tmp.m_oldName;
-	}
-      else
-	{
-	  return newName;
-	}
-    }
-
-    nnpt::Entry
-    NNPT::findEntry (Ptr<const NNNAddress> name)
-    {
-      NS_LOG_FUNCTION (this << *name);
-      pair_set_by_oldname& pair_index = container.get<oldname> ();
-      pair_set_by_oldname::iterator it = pair_index.find(name);
-
-      if (it != pair_index.end())
-	{
-	  return *it;
-	}
-      else
-	{
-	  return nnpt::Entry ();
-	}
+      return m_maxSize;
     }
 
     void
-    NNPT::updateLeaseTime (Ptr<const NNNAddress> oldName, Time lease_expire)
+    NNPT::SetMaxSize (uint32_t maxSize)
     {
-      NS_LOG_FUNCTION (this << *oldName << lease_expire);
-      pair_set_by_oldname& pair_index = container.get<oldname> ();
-      pair_set_by_oldname::iterator it = pair_index.find(oldName);
-
-      Time relativeExpireTime = lease_expire - Simulator::Now ();
-
-      // If the relative expire time is above 0, schedule the next clean
-      if (relativeExpireTime.IsStrictlyPositive())
-	{
-	  if (it != pair_index.end())
-	    {
-	      nnpt::Entry tmp = *it;
-
-	      tmp.m_lease_expire = lease_expire;
-
-	      if (pair_index.replace(it, tmp))
-		{
-		  Simulator::Schedule(relativeExpireTime, &NNPT::cleanExpired, this);
-		}
-	    }
-	}
-    }
-
-    uint32_t
-    NNPT::size ()
-    {
-      NS_LOG_FUNCTION (this);
-      return container.size();
+      m_maxSize = maxSize;
+      EnforceMaxSize (0);
     }
 
     bool
     NNPT::isEmpty ()
     {
       NS_LOG_FUNCTION (this);
-      return (container.size() == 0);
+      return (size() == 0);
     }
 
     Time
@@ -274,64 +114,26 @@ namespace ns3
     }
 
     void
-    NNPT::cleanExpired ()
-    {
-      NS_LOG_FUNCTION (this);
-      pair_set_by_lease& lease_index = container.get<st_lease> ();
-      Time now = Simulator::Now ();
-
-      pair_set_by_lease::iterator it = lease_index.begin();
-
-      while (! isEmpty())
-	{
-	  if (it->m_lease_expire <= now)
-	    {
-	      NS_LOG_INFO ("cleanExpired : removing (" << *it->m_oldName << ") -> (" << *it->m_newName << ")");
-	      deleteEntry(*it);
-	      break;
-	    }
-	  ++it;
-	}
-    }
-
-    void
-    NNPT::Print (std::ostream &os) const
+    NNPT::UpdateSize ()
     {
-      const pair_set_by_oldname& pair_index = container.get<oldname> ();
+      // Entry and both of its 3N names, plus about three pointers of
+      // links for each of the three indexes (ordered or hashed)
+      static const uint64_t entryBytes = sizeof (nnpt::Entry) + 2 * sizeof (NNNAddress) + 9 * sizeof (void *);
 
-      std::copy(pair_index.begin (), pair_index.end (), std::ostream_iterator<pair_set::value_type> (os));
+      m_entries = size ();
+      m_bytes = m_entries * entryBytes;
     }
 
-    void
-    NNPT::printByAddress ()
+    uint32_t
+    NNPT::GetEntries () const
     {
-      pair_set_by_oldname& pair_index = container.get<oldname> ();
-      pair_set_by_oldname::iterator it = pair_index.begin();
-
-      std::cout << "Old Address\t| New Address\t| Lease Expire" << std::endl;
-      std::cout << "-------------------------------------------------" << std::endl;
-
-      while (it != pair_index.end())
-	{
-	  std::cout << *it;
-	  ++it;
-	}
+      return m_entries;
     }
 
-    void
-    NNPT::printByLease ()
+    uint64_t
+    NNPT::GetBytes () const
     {
-      pair_set_by_lease& lease_index = container.get<st_lease> ();
-      pair_set_by_lease::iterator it = lease_index.begin();
-
-      std::cout << "NNN Address\t| New Address\t| Lease Expire" << std::endl;
-      std::cout << "-------------------------------------------------" << std::endl;
-
-      while (it != lease_index.end ())
-	{
-	  std::cout << *it;
-	  ++it;
-	}
+      return m_bytes;
     }
 
     std::ostream&
@@ -36,6 +36,7 @@
 
 #include <ns3-dev/ns3/object.h>
 #include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/traced-value.h>
 
 using boost::multi_index_container;
 using namespace ::boost::multi_index;
@@ -60,7 +61,10 @@ namespace ns3
 
     /**
      * @ingroup nnn-nnpt
-     * @brief Class implementing NNPT structure & functionality
+     * @brief Class for NNPT interface
+     *
+     * The tables themselves are nnpt::NNPTImpl, which differ in how
+     * they index the names (see nnn-nnpt-impl.h)
      */
     class NNPT : public Object
     {
@@ -76,36 +80,6 @@ namespace ns3
       struct newname {};
       struct st_lease {};
 
-      /**
-       *  \brief NNPT contains multiple indices: index<oldname>, index<newname>
-       *  and index<st_lease>
-       */
-      typedef multi_index_container<
-      	nnpt::Entry,
-      	indexed_by<
-          ordered_unique<
-            tag<st_lease>,
-      	    identity<nnpt::Entry>
-          >,
-
-          ordered_unique<
-            tag<oldname>,
-            member<nnpt::Entry,Ptr<const NNNAddress>,&nnpt::Entry::m_oldName>,
-            PtrNNNComp
-          >,
-
-          ordered_unique<
-            tag<newname>,
-            member<nnpt::Entry,Ptr<const NNNAddress>,&nnpt::Entry::m_newName>,
-            PtrNNNComp
-          >
-        >
-      > pair_set;
-
-      typedef pair_set::index<oldname>::type pair_set_by_oldname;
-      typedef pair_set::index<newname>::type pair_set_by_newname;
-      typedef pair_set::index<st_lease>::type pair_set_by_lease;
-
       /**
        * \brief Interface ID
        *
@@ -127,38 +101,38 @@ namespace ns3
       /**
        * \brief Add an entry in NNPT
        */
-      void
-      addEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName, Time lease_expire);
+      virtual void
+      addEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName, Time lease_expire) = 0;
 
       /**
        * \brief Delete an entry in NNPT by oldName
        */
-      void
-      deleteEntry (Ptr<const NNNAddress> oldName);
+      virtual void
+      deleteEntry (Ptr<const NNNAddress> oldName) = 0;
 
       /**
        * \brief Delete an entry in NNPT by nnptEntry
        */
-      void
-      deleteEntry (nnpt::Entry nnptEntry);
+      virtual void
+      deleteEntry (nnpt::Entry nnptEntry) = 0;
 
       /**
        * \brief Delete an entry in NNPT by oldName & newName
        */
-      void
-      deleteEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName);
+      virtual void
+      deleteEntry (Ptr<const NNNAddress> oldName, Ptr<const NNNAddress> newName) = 0;
 
       /**
        * \brief Search for oldName in NNPT
        */
-      bool
-      foundOldName (Ptr<const NNNAddress> name);
+      virtual bool
+      foundOldName (Ptr<const NNNAddress> name) = 0;
 
       /**
        * \brief Search for newName in NNPT
        */
-      bool
-      foundNewName (Ptr<const NNNAddress> name);
+      virtual bool
+      foundNewName (Ptr<const NNNAddress> name) = 0;
 
       /**
        * \brief Search for the newName in name pair by
@@ -177,34 +151,52 @@ namespace ns3
       /**
        * \brief Search for the pointer of the newName in the name pair
        * by using oldName in NNPT
+       *
+       * A node that moved several times leaves a chain of entries. The
+       * chain is compressed as it is followed: every entry on the way is
+       * left pointing at the last name, so the next search for any of
+       * them takes a single hop until the chain grows again
        */
-      Ptr<const NNNAddress>
-      findPairedNamePtr (Ptr<const NNNAddress> oldName);
+      virtual Ptr<const NNNAddress>
+      findPairedNamePtr (Ptr<const NNNAddress> oldName) = 0;
 
       /**
        * \brief Search for the pointer of the oldName in the name pair
        * by using newName in NNPT
        */
-      Ptr<const NNNAddress>
-      findPairedOldNamePtr (Ptr<const NNNAddress> newName);
+      virtual Ptr<const NNNAddress>
+      findPairedOldNamePtr (Ptr<const NNNAddress> newName) = 0;
 
       /**
        *  \brief Search for one nnpt-entry by one NNNAddress
        */
-      nnpt::Entry
-      findEntry (Ptr<const NNNAddress> name);
+      virtual nnpt::Entry
+      findEntry (Ptr<const NNNAddress> name) = 0;
 
       /**
        *  \brief Update the expire time of the nnpt-entry
        */
-      void
-      updateLeaseTime (Ptr<const NNNAddress> oldName, Time lease_expire);
+      virtual void
+      updateLeaseTime (Ptr<const NNNAddress> oldName, Time lease_expire) = 0;
 
       /**
        *  \brief Calculate the size of NNPT
        */
+      virtual uint32_t
+      size () = 0;
+
+      /**
+       *  \brief Get the maximum number of entries, 0 if there is no limit
+       */
       uint32_t
-      size ();
+      GetMaxSize () const;
+
+      /**
+       *  \brief Set the maximum number of entries, 0 to lift the limit.
+       *  Going over the limit evicts the entries whose lease is the nearest
+       */
+      void
+      SetMaxSize (uint32_t maxSize);
 
       /**
        *  \brief Check whether the NNPT is empty
@@ -227,28 +219,58 @@ namespace ns3
       /**
        *  \brief Clean out the expired entries in NNPT
        */
-      void
-      cleanExpired ();
+      virtual void
+      cleanExpired () = 0;
 
       /**
        *  \brief Print out the NNPT
        */
-      void
-      Print (std::ostream &os) const;
+      virtual void
+      Print (std::ostream &os) const = 0;
 
       /**
        *  \brief Print out the NNPT by the order of oldNames
        */
-      void
-      printByAddress ();
+      virtual void
+      printByAddress () = 0;
 
       /**
        *  \brief Print out the NNPT by the order of leaseTime
        */
+      virtual void
+      printByLease () = 0;
+
+      /**
+       * \brief Current value of the Entries trace source
+       */
+      uint32_t
+      GetEntries () const;
+
+      /**
+       * \brief Current value of the Bytes trace source
+       */
+      uint64_t
+      GetBytes () const;
+
+    protected:
+      /**
+       *  \brief Evict entries, nearest lease first, until the NNPT is back
+       *  within m_maxSize. The entry for keep (an oldName) is never evicted
+       */
+      virtual void
+      EnforceMaxSize (Ptr<const NNNAddress> keep) = 0;
+
+      /**
+       *  \brief Refresh the Entries and Bytes trace sources, to be called
+       *  by the implementations whenever an entry is added or removed
+       */
       void
-      printByLease ();
+      UpdateSize ();
 
-      pair_set container;
+      uint32_t m_maxSize;                ///< \brief Maximum number of entries, 0 for no limit
+      TracedValue<uint32_t> m_evictions; ///< \brief Number of entries evicted to honour m_maxSize
+      TracedValue<uint32_t> m_entries;   ///< \brief Number of entries
+      TracedValue<uint64_t> m_bytes;     ///< \brief Approximate memory held by the entries
     };
 
     std::ostream& operator<< (std::ostream& os, const NNPT &nnpt);
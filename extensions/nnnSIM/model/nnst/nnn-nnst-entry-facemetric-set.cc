@@ -0,0 +1,287 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnst-entry-facemetric-set.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnst-entry-facemetric-set.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnst-entry-facemetric-set.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-nnst-entry-facemetric-set.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnst
+    {
+      namespace
+      {
+	struct SameFace
+	{
+	  SameFace (Ptr<Face> face) : m_face (face) {}
+	  bool operator() (const FaceMetric &m) const { return m.GetFace () == m_face; }
+	  Ptr<Face> m_face;
+	};
+
+	struct SamePoA
+	{
+	  SamePoA (const Address &poa) : m_poa (poa) {}
+	  bool operator() (const FaceMetric &m) const { return m.GetAddress () == m_poa; }
+	  const Address &m_poa;
+	};
+
+	struct Expired
+	{
+	  Expired (const Time &now) : m_now (now) {}
+	  bool operator() (const FaceMetric &m) const { return m.GetExpireTime () <= m_now; }
+	  const Time &m_now;
+	};
+      }
+
+      FaceMetricSet::FaceMetricSet ()
+      : m_size    (0)
+      , m_indexed (0)
+      {
+      }
+
+      FaceMetricSet::FaceMetricSet (const FaceMetricSet &other)
+      : m_size    (0)
+      , m_indexed (0)
+      {
+	*this = other;
+      }
+
+      FaceMetricSet &
+      FaceMetricSet::operator= (const FaceMetricSet &other)
+      {
+	if (this == &other)
+	  return *this;
+
+	Clear ();
+
+	if (other.m_indexed != 0)
+	  m_indexed = new fmtr_set (*other.m_indexed);
+	else
+	  {
+	    for (uint32_t i = 0; i < other.m_size; i++)
+	      new (Flat () + i) FaceMetric (other.Flat ()[i]);
+	    m_size = other.m_size;
+	  }
+
+	return *this;
+      }
+
+      FaceMetricSet::~FaceMetricSet ()
+      {
+	Clear ();
+      }
+
+      bool
+      FaceMetricSet::Insert (const FaceMetric &metric)
+      {
+	if (m_indexed != 0)
+	  {
+	    bool ok = m_indexed->insert (metric).second;
+	    Rearrange ();
+	    return ok;
+	  }
+
+	FaceMetric *flat = Flat ();
+	for (uint32_t i = 0; i < m_size; i++)
+	  {
+	    if (flat[i].GetFace () == metric.GetFace () && flat[i].GetAddress () == metric.GetAddress ())
+	      return false;
+	  }
+
+	if (m_size == InlineSize)
+	  {
+	    ToIndexed ();
+	    return Insert (metric);
+	  }
+
+	new (flat + m_size) FaceMetric (metric);
+	m_size++;
+	SortFlat ();
+	return true;
+      }
+
+      bool
+      FaceMetricSet::HasFace (Ptr<Face> face) const
+      {
+	if (m_indexed != 0)
+	  return m_indexed->get<i_face> ().find (face) != m_indexed->get<i_face> ().end ();
+
+	return std::find_if (Flat (), Flat () + m_size, SameFace (face)) != Flat () + m_size;
+      }
+
+      bool
+      FaceMetricSet::HasPoA (const Address &poa) const
+      {
+	if (m_indexed != 0)
+	  return m_indexed->get<i_poa> ().find (poa) != m_indexed->get<i_poa> ().end ();
+
+	return std::find_if (Flat (), Flat () + m_size, SamePoA (poa)) != Flat () + m_size;
+      }
+
+      Ptr<Face>
+      FaceMetricSet::GetFace (const Address &poa) const
+      {
+	if (m_indexed != 0)
+	  {
+	    fmtr_set_by_poa::const_iterator it = m_indexed->get<i_poa> ().find (poa);
+	    return (it != m_indexed->get<i_poa> ().end ()) ? it->GetFace () : Ptr<Face> ();
+	  }
+
+	const FaceMetric *it = std::find_if (Flat (), Flat () + m_size, SamePoA (poa));
+	return (it != Flat () + m_size) ? it->GetFace () : Ptr<Face> ();
+      }
+
+      void
+      FaceMetricSet::EraseFace (Ptr<Face> face)
+      {
+	if (m_indexed != 0)
+	  {
+	    m_indexed->get<i_face> ().erase (face);
+	    ToFlat ();
+	  }
+	else
+	  EraseFlat (SameFace (face));
+      }
+
+      void
+      FaceMetricSet::ErasePoA (const Address &poa)
+      {
+	if (m_indexed != 0)
+	  {
+	    m_indexed->get<i_poa> ().erase (poa);
+	    ToFlat ();
+	  }
+	else
+	  EraseFlat (SamePoA (poa));
+      }
+
+      Time
+      FaceMetricSet::GetEarliestExpireTime () const
+      {
+	if (m_indexed != 0)
+	  {
+	    const fmtr_set_by_lease& lease_index = m_indexed->get<i_lease> ();
+	    return lease_index.empty () ? Time::Max () : lease_index.begin ()->GetExpireTime ();
+	  }
+
+	Time earliest = Time::Max ();
+	for (uint32_t i = 0; i < m_size; i++)
+	  {
+	    if (Flat ()[i].GetExpireTime () < earliest)
+	      earliest = Flat ()[i].GetExpireTime ();
+	  }
+	return earliest;
+      }
+
+      void
+      FaceMetricSet::EraseExpired (const Time &now)
+      {
+	if (m_indexed != 0)
+	  {
+	    fmtr_set_by_lease& lease_index = m_indexed->get<i_lease> ();
+	    lease_index.erase (lease_index.begin (), lease_index.upper_bound (now));
+	    ToFlat ();
+	  }
+	else
+	  EraseFlat (Expired (now));
+      }
+
+      void
+      FaceMetricSet::SortFlat ()
+      {
+	FaceMetric *flat = Flat ();
+	for (uint32_t i = 1; i < m_size; i++)
+	  {
+	    for (uint32_t j = i; j > 0 && MetricLess (flat[j], flat[j - 1]); j--)
+	      std::swap (flat[j], flat[j - 1]);
+	  }
+      }
+
+      template<class Predicate>
+      void
+      FaceMetricSet::EraseFlat (Predicate erase)
+      {
+	FaceMetric *flat = Flat ();
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < m_size; i++)
+	  {
+	    if (erase (flat[i]))
+	      continue;
+	    if (kept != i)
+	      flat[kept] = flat[i];
+	    kept++;
+	  }
+
+	for (uint32_t i = kept; i < m_size; i++)
+	  flat[i].~FaceMetric ();
+	m_size = kept;
+      }
+
+      void
+      FaceMetricSet::ToIndexed ()
+      {
+	fmtr_set *indexed = new fmtr_set ();
+	FaceMetric *flat = Flat ();
+	for (uint32_t i = 0; i < m_size; i++)
+	  {
+	    indexed->insert (flat[i]);
+	    flat[i].~FaceMetric ();
+	  }
+	m_size = 0;
+	m_indexed = indexed;
+	Rearrange ();
+      }
+
+      void
+      FaceMetricSet::ToFlat ()
+      {
+	if (m_indexed->size () > InlineSize)
+	  {
+	    Rearrange ();
+	    return;
+	  }
+
+	fmtr_set *indexed = m_indexed;
+	m_indexed = 0;
+
+	// Keep the (status, routing cost) order the i_metric index already has
+	fmtr_set_by_metric& metric_index = indexed->get<i_metric> ();
+	for (fmtr_set_by_metric::iterator it = metric_index.begin (); it != metric_index.end (); ++it)
+	  new (Flat () + m_size++) FaceMetric (*it);
+
+	delete indexed;
+      }
+
+      void
+      FaceMetricSet::Clear ()
+      {
+	if (m_indexed != 0)
+	  {
+	    delete m_indexed;
+	    m_indexed = 0;
+	  }
+
+	FaceMetric *flat = Flat ();
+	for (uint32_t i = 0; i < m_size; i++)
+	  flat[i].~FaceMetric ();
+	m_size = 0;
+      }
+    } /* namespace nnst */
+  } /* namespace nnn */
+} /* namespace ns3 */
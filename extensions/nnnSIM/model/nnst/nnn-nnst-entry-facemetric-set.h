@@ -0,0 +1,336 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnst-entry-facemetric-set.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnst-entry-facemetric-set.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnst-entry-facemetric-set.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNN_NNST_ENTRY_FACEMETRIC_SET_H_
+#define NNN_NNST_ENTRY_FACEMETRIC_SET_H_
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/random_access_index.hpp>
+#include <boost/multi_index/tag.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/nstime.h>
+
+#include "nnn-nnst-entry-facemetric.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnst
+    {
+      /// @cond include_hidden
+      class i_entry {};
+      class i_face {};
+      class i_poa {};
+      class i_lease {};
+      class i_metric {};
+      class i_nth {};
+      /// @endcond
+
+      /**
+       * @ingroup nnn-nnst
+       * @brief Typedef for indexed face container of Entry
+       *
+       * Currently, there are 5 indexes:
+       * - by face (used to find record and update metric)
+       * - by Address
+       * - by Lease time
+       * - by routing metric
+       * - by position
+       */
+      /// @cond include_hidden
+      typedef boost::multi_index::multi_index_container<
+	  FaceMetric,
+	  boost::multi_index::indexed_by<
+	    boost::multi_index::ordered_unique<
+	      boost::multi_index::tag<i_entry>,
+	      boost::multi_index::identity<FaceMetric>
+          >,
+
+            // For fast access to elements using Face
+            boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<i_face>,
+              boost::multi_index::const_mem_fun<FaceMetric,Ptr<Face>,&FaceMetric::GetFace>
+            >,
+
+            // For fast access by PoA Address
+            boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<i_poa>,
+              boost::multi_index::const_mem_fun<FaceMetric,Address,&FaceMetric::GetAddress>
+            >,
+
+            // For access by lease time
+            boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<i_lease>,
+              boost::multi_index::const_mem_fun<FaceMetric,Time,&FaceMetric::GetExpireTime>
+            >,
+
+            // List of available faces ordered by (status, m_routingCost)
+            boost::multi_index::ordered_non_unique<
+              boost::multi_index::tag<i_metric>,
+              boost::multi_index::composite_key<
+                FaceMetric,
+                boost::multi_index::const_mem_fun<FaceMetric,FaceMetric::Status,&FaceMetric::GetStatus>,
+                boost::multi_index::const_mem_fun<FaceMetric,int32_t,&FaceMetric::GetRoutingCost>
+              >
+            >,
+
+            // To optimize nth candidate selection (sacrifice a little bit
+            // space to gain speed)
+            boost::multi_index::random_access<
+              boost::multi_index::tag<i_nth>
+            >
+          >
+      > fmtr_set;
+      /// @endcond
+
+      typedef fmtr_set::index<i_face>::type fmtr_set_by_face;
+      typedef fmtr_set::index<i_poa>::type fmtr_set_by_poa;
+      typedef fmtr_set::index<i_lease>::type fmtr_set_by_lease;
+      typedef fmtr_set::index<i_metric>::type fmtr_set_by_metric;
+      typedef fmtr_set::index<i_nth>::type fmtr_set_by_nth;
+
+      /**
+       * @ingroup nnn-nnst
+       * @brief Next hops (Face, PoA) of an NNST Entry
+       *
+       * Almost every 3N name is reachable through one to three PoAs, so up
+       * to InlineSize next hops are kept inside the object itself, ordered
+       * by (status, routing cost). All the other lookups are linear scans
+       * over those few elements. Only when an Entry gets more next hops
+       * than that are they moved to the fmtr_set, and moved back once they
+       * fit again.
+       *
+       * Like fmtr_set, a (Face, PoA) pair is only stored once.
+       */
+      class FaceMetricSet
+      {
+      public:
+	static const uint32_t InlineSize = 3;
+
+	FaceMetricSet ();
+
+	FaceMetricSet (const FaceMetricSet &other);
+
+	FaceMetricSet &
+	operator= (const FaceMetricSet &other);
+
+	~FaceMetricSet ();
+
+	uint32_t
+	size () const
+	{
+	  return (m_indexed != 0) ? m_indexed->size () : m_size;
+	}
+
+	bool
+	empty () const
+	{
+	  return size () == 0;
+	}
+
+	/**
+	 * @brief Add a next hop
+	 * @returns false if the (Face, PoA) pair was already there
+	 */
+	bool
+	Insert (const FaceMetric &metric);
+
+	/**
+	 * @brief n-th next hop in (status, routing cost) order
+	 */
+	const FaceMetric &
+	operator[] (uint32_t n) const
+	{
+	  return (m_indexed != 0) ? m_indexed->get<i_nth> ()[n] : Flat ()[n];
+	}
+
+	bool
+	HasFace (Ptr<Face> face) const;
+
+	bool
+	HasPoA (const Address &poa) const;
+
+	/**
+	 * @brief Face used to reach poa, 0 if there is none
+	 */
+	Ptr<Face>
+	GetFace (const Address &poa) const;
+
+	/**
+	 * @brief Apply modifier to the next hops on face (all of them if face
+	 * is 0) and restore the (status, routing cost) order
+	 */
+	template<class Modifier>
+	void
+	Modify (Ptr<Face> face, Modifier modifier);
+
+	void
+	EraseFace (Ptr<Face> face);
+
+	void
+	ErasePoA (const Address &poa);
+
+	/**
+	 * @brief Earliest lease of the next hops, Time::Max () if there are none
+	 */
+	Time
+	GetEarliestExpireTime () const;
+
+	/**
+	 * @brief Remove the next hops whose lease expires at or before now
+	 */
+	void
+	EraseExpired (const Time &now);
+
+	/**
+	 * @brief Fill out with the next hops ordered by cmp
+	 *
+	 * Meant for printing, the flat representation has no other order
+	 * than the one by (status, routing cost)
+	 */
+	template<class Compare>
+	void
+	Sorted (std::vector<const FaceMetric*> &out, Compare cmp) const
+	{
+	  out.clear ();
+	  for (uint32_t i = 0; i < size (); i++)
+	    out.push_back (&(*this)[i]);
+	  std::stable_sort (out.begin (), out.end (), Indirect<Compare> (cmp));
+	}
+
+	/**
+	 * @brief Order used by operator[]
+	 */
+	static bool
+	MetricLess (const FaceMetric &a, const FaceMetric &b)
+	{
+	  if (a.GetStatus () != b.GetStatus ())
+	    return a.GetStatus () < b.GetStatus ();
+	  return a.GetRoutingCost () < b.GetRoutingCost ();
+	}
+
+      private:
+	template<class Compare>
+	struct Indirect
+	{
+	  Indirect (Compare cmp) : m_cmp (cmp) {}
+	  bool operator() (const FaceMetric *a, const FaceMetric *b) const { return m_cmp (*a, *b); }
+	  Compare m_cmp;
+	};
+
+	FaceMetric *
+	Flat ()
+	{
+	  return static_cast<FaceMetric*> (static_cast<void*> (&m_inline));
+	}
+
+	const FaceMetric *
+	Flat () const
+	{
+	  return static_cast<const FaceMetric*> (static_cast<const void*> (&m_inline));
+	}
+
+	/**
+	 * @brief Restore the (status, routing cost) order of the flat array,
+	 * keeping equal elements in their current order
+	 */
+	void
+	SortFlat ();
+
+	/**
+	 * @brief Remove the flat elements for which erase returns true
+	 */
+	template<class Predicate>
+	void
+	EraseFlat (Predicate erase);
+
+	void
+	ToIndexed ();
+
+	void
+	ToFlat ();
+
+	void
+	Clear ();
+
+	void
+	Rearrange ()
+	{
+	  // reordering random access index same way as by metric index
+	  m_indexed->get<i_nth> ().rearrange (m_indexed->get<i_metric> ().begin ());
+	}
+
+	typedef boost::aligned_storage<InlineSize * sizeof (FaceMetric),
+	    boost::alignment_of<FaceMetric>::value>::type inline_storage;
+
+	inline_storage m_inline; ///< \brief Next hops while there are at most InlineSize
+	uint32_t m_size;         ///< \brief Number of next hops in m_inline
+	fmtr_set *m_indexed;     ///< \brief Next hops once there are more than InlineSize
+      };
+
+      template<class Modifier>
+      void
+      FaceMetricSet::Modify (Ptr<Face> face, Modifier modifier)
+      {
+	if (m_indexed == 0)
+	  {
+	    FaceMetric *flat = Flat ();
+	    for (uint32_t i = 0; i < m_size; i++)
+	      {
+		if (face == 0 || flat[i].GetFace () == face)
+		  modifier (flat[i]);
+	      }
+	    SortFlat ();
+	    return;
+	  }
+
+	fmtr_set_by_face& face_index = m_indexed->get<i_face> ();
+	fmtr_set_by_face::iterator it = face_index.begin ();
+
+	while (it != face_index.end ())
+	  {
+	    if (face == 0 || it->GetFace () == face)
+	      {
+		FaceMetric tmp = *it;
+		modifier (tmp);
+		face_index.replace (it, tmp);
+	      }
+	    ++it;
+	  }
+
+	Rearrange ();
+      }
+
+    } /* namespace nnst */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_NNST_ENTRY_FACEMETRIC_SET_H_ */
@@ -45,7 +45,7 @@ namespace ns3
 	};
 
 	FaceMetric(Ptr<Face> face, Address addr, Time lease_expire, int32_t cost);
-	virtual ~FaceMetric();
+	~FaceMetric();
 
 	/**
 	 * \brief Comparison operator used by boost::multi_index::identity<>
@@ -77,7 +77,7 @@ namespace ns3
 	void
 	SetStatus (Status status)
 	{
-	  m_status.Set (status);
+	  m_status = status;
 	}
 
 	Status
@@ -163,7 +163,7 @@ namespace ns3
 	Time m_sRtt;                  ///< \brief Round-trip time variation
 	Time m_rttVar;                ///< \brief round-trip time variation
 	int32_t m_routingCost;        ///< \brief routing protocol cost (interpretation of the value depends on the underlying routing protocol)
-	TracedValue<Status> m_status; ///< \brief Status of next hop
+	Status m_status;              ///< \brief Status of next hop
       };
 
       std::ostream& operator<< (std::ostream& os, const FaceMetric &metric);
@@ -44,6 +44,93 @@ namespace ns3
   {
     namespace nnst
     {
+      namespace
+      {
+	struct SetStatus
+	{
+	  SetStatus (FaceMetric::Status status) : m_status (status) {}
+	  void operator() (FaceMetric &m) const { m.SetStatus (m_status); }
+	  FaceMetric::Status m_status;
+	};
+
+	struct SetRoutingMetric
+	{
+	  SetRoutingMetric (int32_t metric) : m_metric (metric) {}
+	  void operator() (FaceMetric &m) const
+	  {
+	    if (m.GetRoutingCost () > m_metric || m.GetStatus() == FaceMetric::NNN_NNST_RED)
+	      {
+		m.SetRoutingCost (m_metric);
+		m.SetStatus (FaceMetric::NNN_NNST_YELLOW);
+	      }
+	  }
+	  int32_t m_metric;
+	};
+
+	struct InvalidateMetric
+	{
+	  void operator() (FaceMetric &m) const
+	  {
+	    m.SetRoutingCost (std::numeric_limits<uint16_t>::max ());
+	    m.SetStatus (FaceMetric::NNN_NNST_RED);
+	  }
+	};
+
+	struct UpdateRtt
+	{
+	  UpdateRtt (const Time &sample) : m_sample (sample) {}
+	  void operator() (FaceMetric &m) const { m.UpdateRtt (m_sample); }
+	  const Time &m_sample;
+	};
+
+	struct SetExpireTime
+	{
+	  SetExpireTime (Time lease) : m_lease (lease) {}
+	  void operator() (FaceMetric &m) const { m.UpdateExpireTime (m_lease); }
+	  Time m_lease;
+	};
+
+	bool
+	AddressLess (const FaceMetric &a, const FaceMetric &b)
+	{
+	  return a.GetAddress () < b.GetAddress ();
+	}
+
+	bool
+	LeaseLess (const FaceMetric &a, const FaceMetric &b)
+	{
+	  return a.GetExpireTime () < b.GetExpireTime ();
+	}
+
+	bool
+	FaceLess (const FaceMetric &a, const FaceMetric &b)
+	{
+	  return *a.GetFace () < *b.GetFace ();
+	}
+
+	void
+	Print (std::ostream &os, const NNNAddress &name, const std::vector<const FaceMetric*> &metrics)
+	{
+	  std::vector<const FaceMetric*>::const_iterator it = metrics.begin ();
+
+	  os << std::left << std::setw(30) << name.toDotHex();
+
+	  if (it != metrics.end ())
+	    {
+	      os << **it;
+	      ++it;
+	    }
+
+	  os << std::endl;
+
+	  while (it != metrics.end())
+	    {
+	      os << std::setw(30) << " " << **it << std::endl;
+	      ++it;
+	    }
+	}
+      }
+
       Entry::Entry()
       {
       }
@@ -71,23 +158,7 @@ namespace ns3
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face) << status);
 
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
-	fmtr_set_by_face::iterator it = face_index.begin ();
-
-	while (it != face_index.end ())
-	  {
-	    FaceMetric tmp = *it;
-	    if (tmp.GetFace() == face)
-	      {
-		tmp.SetStatus(status);
-
-		face_index.replace(it, tmp);
-	      }
-	    ++it;
-	  }
-
-	// reordering random access index same way as by metric index
-	m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+	m_faces.Modify (face, SetStatus (status));
       }
 
       void
@@ -95,24 +166,9 @@ namespace ns3
       {
 	NS_LOG_FUNCTION (this << n_lease);
 
-	fmtr_set_by_nth& nth_index = m_faces.get<i_nth> ();
-	fmtr_set_by_nth::iterator it = nth_index.begin();
+	m_faces.Modify (0, SetExpireTime (n_lease));
 
-	bool replaced = false;
-
-	while (it != nth_index.end())
-	  {
-	    FaceMetric tmp = *it;
-
-	    tmp.UpdateExpireTime(n_lease);
-
-	    replaced = nth_index.replace(it, tmp) || replaced;
-
-	    ++it;
-	  }
-
-	//if (replaced)
-	//  Simulator::Schedule(n_lease, &Entry::cleanExpired, this);
+	//Simulator::Schedule(n_lease, &Entry::cleanExpired, this);
       }
 
       void
@@ -121,66 +177,23 @@ namespace ns3
 	NS_LOG_FUNCTION (this << boost::cref(*face) << metric);
 	NS_ASSERT_MSG (face != NULL, "Trying to Add or Update NULL face");
 
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
-	fmtr_set_by_face::iterator it = face_index.begin ();
-
-	while (it != face_index.end ())
-	  {
-	    FaceMetric tmp = *it;
-	    if (tmp.GetFace() == face)
-	      {
-		if (tmp.GetRoutingCost () > metric || tmp.GetStatus() == FaceMetric::NNN_NNST_RED)
-		  {
-		    tmp.SetRoutingCost(metric);
-		    tmp.SetStatus(FaceMetric::NNN_NNST_YELLOW);
-
-		    face_index.replace(it, tmp);
-		  }
-	      }
-	    ++it;
-	  }
-
-	// reordering random access index same way as by metric index
-	m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+	m_faces.Modify (face, SetRoutingMetric (metric));
       }
 
       void
       Entry::Invalidate ()
       {
 	NS_LOG_FUNCTION (this);
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
-
-	for (fmtr_set_by_face::iterator face = face_index.begin ();
-	    face != face_index.end ();
-	    face++)
-	  {
-	    FaceMetric tmp = *face;
 
-	    tmp.SetRoutingCost(std::numeric_limits<uint16_t>::max ());
-	    tmp.SetStatus(FaceMetric::NNN_NNST_RED);
-
-	    face_index.replace(face, tmp);
-	  }
+	m_faces.Modify (0, InvalidateMetric ());
       }
 
       void
       Entry::UpdateFaceRtt (Ptr<Face> face, const Time &sample)
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face) << sample);
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
-	fmtr_set_by_face::iterator it = face_index.begin ();
-
-	while (it != face_index.end ())
-	  {
-	    FaceMetric tmp = *it;
-	    if (tmp.GetFace() == face)
-	      {
-		tmp.UpdateRtt(sample);
 
-		face_index.replace(it, tmp);
-	      }
-	    ++it;
-	  }
+	m_faces.Modify (face, UpdateRtt (sample));
       }
 
       const FaceMetric &
@@ -188,13 +201,13 @@ namespace ns3
       {
 	if (m_faces.size () == 0) throw Entry::NoFaces ();
 	skip = skip % m_faces.size();
-	return m_faces.get<i_nth> () [skip];
+	return m_faces[skip];
       }
 
       std::pair<Ptr<Face>, Address>
       Entry::FindBestCandidateFaceInfo (uint32_t skip/* = 0*/) const
       {
-        FaceMetric tmp = FindBestCandidate(skip);
+        const FaceMetric &tmp = FindBestCandidate(skip);
 
         std::pair<Ptr<Face>, Address> ret = std::make_pair(tmp.GetFace (), tmp.GetAddress ());
 
@@ -205,21 +218,16 @@ namespace ns3
       Entry::RemoveFace (const Ptr<Face> &face)
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face));
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
 
-	face_index.erase(face);
+	m_faces.EraseFace (face);
       }
 
       void
       Entry::AddPoA (Ptr<Face> face, Address poa, Time e_lease, uint32_t cost)
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face) << poa << e_lease << cost);
-	FaceMetric tmp (face, poa, e_lease, cost);
 
-	m_faces.insert(tmp);
-
-	// reordering random access index same way as by metric index
-	m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
+	m_faces.Insert (FaceMetric (face, poa, e_lease, cost));
 
 	//Simulator::Schedule(e_lease, &Entry::cleanExpired, this);
       }
@@ -228,16 +236,12 @@ namespace ns3
       Entry::GetPoAs()
       {
 	NS_LOG_FUNCTION (this);
-	fmtr_set_by_poa& poa_index = m_faces.get<i_poa> ();
-	fmtr_set_by_poa::iterator it = poa_index.begin ();
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, AddressLess);
 
 	std::vector<Address> poas;
-
-	while (it != poa_index.end ())
-	  {
-	    poas.push_back(it->GetAddress ());
-	    ++it;
-	  }
+	for (size_t i = 0; i < metrics.size (); i++)
+	  poas.push_back (metrics[i]->GetAddress ());
 
 	return poas;
       }
@@ -246,16 +250,14 @@ namespace ns3
       Entry::GetPoAs(Ptr<Face> face)
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face));
-	fmtr_set_by_face& face_index = m_faces.get<i_face> ();
-	fmtr_set_by_face::iterator it = face_index.begin();
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, FaceLess);
 
 	std::vector<Address> poas;
-
-	while (it != face_index.end ())
+	for (size_t i = 0; i < metrics.size (); i++)
 	  {
-	    if (it->GetFace() == face )
-	      poas.push_back(it->GetAddress());
-	    ++it;
+	    if (metrics[i]->GetFace () == face)
+	      poas.push_back (metrics[i]->GetAddress ());
 	  }
 
 	return poas;
@@ -265,178 +267,101 @@ namespace ns3
       Entry::GetPoAsN()
       {
 	NS_LOG_FUNCTION (this);
-	return GetPoAs().size();
+	return m_faces.size ();
       }
 
       uint32_t
       Entry::GetPoAsN(Ptr<Face> face)
       {
 	NS_LOG_FUNCTION (this << boost::cref(*face));
-	return GetPoAs(face).size();
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < m_faces.size (); i++)
+	  {
+	    if (m_faces[i].GetFace () == face)
+	      n++;
+	  }
+	return n;
       }
 
       Ptr<Face>
       Entry::GetFace (Address poa)
       {
 	NS_LOG_FUNCTION (this << poa);
-	fmtr_set_by_poa& poa_index = m_faces.get<i_poa> ();
-	fmtr_set_by_poa::iterator it = poa_index.find(poa);
-
-	Ptr<Face> tmp;
-
-	if (it != poa_index.end())
-	  {
-	    tmp = it->GetFace();
-	  }
-
-	return tmp;
+	return m_faces.GetFace (poa);
       }
 
       bool
       Entry::isEmpty()
       {
 	NS_LOG_FUNCTION (this);
-	return (m_faces.size() == 0);
+	return m_faces.empty ();
+      }
+
+      Time
+      Entry::GetEarliestLease () const
+      {
+	return m_faces.GetEarliestExpireTime ();
+      }
+
+      Time
+      EntryLease::operator() (Ptr<const Entry> entry) const
+      {
+	return (entry == 0) ? Time::Max () : entry->GetEarliestLease ();
       }
 
       void
       Entry::RemovePoA (Address poa)
       {
 	NS_LOG_FUNCTION (this << poa);
-	fmtr_set_by_poa& poa_index = m_faces.get<i_poa> ();
 
-	poa_index.erase(poa);
+	m_faces.ErasePoA (poa);
       }
 
       void
       Entry::cleanExpired ()
       {
 	NS_LOG_FUNCTION (this);
-	fmtr_set_by_lease& lease_index = m_faces.get<i_lease> ();
-	Time now = Simulator::Now ();
 
-	fmtr_set_by_lease::iterator it = lease_index.begin ();
-	for (; it != lease_index.end ();)
-	  {
-	    if (it->GetExpireTime() <= now)
-	      it = lease_index.erase (it);
-	    else
-	      ++it;
-
-	    if (it->GetExpireTime () > now)
-	      break;
-	  }
+	m_faces.EraseExpired (Simulator::Now ());
       }
 
       void
       Entry::printByAddress () const
       {
-	fmtr_set_by_poa::iterator it = m_faces.get<i_poa> ().begin ();
-
-	std::cout << std::left << std::setw(30) << GetAddress().toDotHex();
-
-	if (it != m_faces.get<i_poa> ().end ())
-	  {
-	    std::cout << *it;
-	    ++it;
-	  }
-
-	std::cout << std::endl;
-
-	while (it != m_faces.get<i_poa> ().end())
-	  {
-	    std::cout << std::setw(30) << " " << *it << std::endl;
-	    ++it;
-	  }
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, AddressLess);
+	Print (std::cout, GetAddress (), metrics);
       }
 
       void
       Entry::printByLease () const
       {
-	fmtr_set_by_lease::iterator it = m_faces.get<i_lease> ().begin ();
-
-	std::cout << std::left << std::setw(30) << GetAddress().toDotHex();
-
-	if (it != m_faces.get<i_lease> ().end ())
-	  {
-	    std::cout << *it;
-	    ++it;
-	  }
-
-	std::cout << std::endl;
-
-	while (it != m_faces.get<i_lease> ().end())
-	  {
-	    std::cout << std::setw(30) << " " << *it << std::endl;;
-	    ++it;
-	  }
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, LeaseLess);
+	Print (std::cout, GetAddress (), metrics);
       }
 
       void
       Entry::printByMetric () const
       {
-	fmtr_set_by_metric::iterator it = m_faces.get<i_metric> ().begin ();
-
-	std::cout << std::left << std::setw(30) << GetAddress().toDotHex();
-
-	if (it != m_faces.get<i_metric> ().end ())
-	  {
-	    std::cout << *it;
-	    ++it;
-	  }
-
-	std::cout << std::endl;
-
-	while (it != m_faces.get<i_metric> ().end())
-	  {
-	    std::cout << std::setw(30) << " " << *it << std::endl;
-	    ++it;
-	  }
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, FaceMetricSet::MetricLess);
+	Print (std::cout, GetAddress (), metrics);
       }
 
       void
       Entry::printByFace () const
       {
-	fmtr_set_by_face::iterator it = m_faces.get<i_face> ().begin ();
-
-	std::cout << std::left << std::setw(30) << GetAddress().toDotHex();
-
-	if (it != m_faces.get<i_face> ().end ())
-	  {
-	    std::cout << *it;
-	    ++it;
-	  }
-
-	std::cout << std::endl;
-
-	while (it != m_faces.get<i_face> ().end())
-	  {
-	    std::cout << std::setw(30) << " " << *it << std::endl;;
-	    ++it;
-	  }
+	std::vector<const FaceMetric*> metrics;
+	m_faces.Sorted (metrics, FaceLess);
+	Print (std::cout, GetAddress (), metrics);
       }
 
       std::ostream& operator<< (std::ostream& os, const Entry &entry)
       {
-	fmtr_set tmp = entry.m_faces;
-	fmtr_set_by_face& face_index = tmp.get<nnst::i_face> ();
-	fmtr_set_by_face::iterator it = face_index.begin ();
-
-	os  << std::left << std::setw(30) << entry.GetAddress().toDotHex();
-
-	if (it != face_index.end ())
-	  {
-	    os << *it;
-	    ++it;
-	  }
-
-	os << std::endl;
-
-	while (it != face_index.end())
-	  {
-	    os << std::setw(30) << " " <<  *it << std::endl;
-	    ++it;
-	  }
+	std::vector<const FaceMetric*> metrics;
+	entry.m_faces.Sorted (metrics, FaceLess);
+	Print (os, entry.GetAddress (), metrics);
 
 	return os;
       }
@@ -20,15 +20,6 @@
 #ifndef NNN_NNST_ENTRY_H_
 #define NNN_NNST_ENTRY_H_
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/mem_fun.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/tag.hpp>
-
 #include <ns3-dev/ns3/ptr.h>
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/simulator.h>
@@ -36,10 +27,11 @@
 
 #include "nnn-nnst.h"
 #include "nnn-nnst-entry-facemetric.h"
+#include "nnn-nnst-entry-facemetric-set.h"
 #include "../nnn-naming.h"
 #include "../nnn-face.h"
 #include "../../utils/trie/trie.h"
-#include "../../utils/trie/counting-policy.h"
+#include "../../utils/trie/lease-policy.h"
 #include "../../utils/trie/trie-with-policy.h"
 #include "../../helper/nnn-face-container.h"
 
@@ -52,78 +44,6 @@ namespace ns3
   {
     namespace nnst
     {
-      /// @cond include_hidden
-      class i_entry {};
-      class i_face {};
-      class i_poa {};
-      class i_lease {};
-      class i_metric {};
-      class i_nth {};
-      /// @endcond
-
-      /**
-       * @ingroup nnn-nnst
-       * @brief Typedef for indexed face container of Entry
-       *
-       * Currently, there are 5 indexes:
-       * - by face (used to find record and update metric)
-       * - by Address
-       * - by Lease time
-       * - by routing metric
-       * - by position
-       */
-      /// @cond include_hidden
-      typedef multi_index_container<
-	  FaceMetric,
-	  indexed_by<
-	    ordered_unique<
-	      tag<i_entry>,
-	      identity<FaceMetric>
-          >,
-
-            // For fast access to elements using Face
-            ordered_non_unique<
-              tag<i_face>,
-              const_mem_fun<FaceMetric,Ptr<Face>,&FaceMetric::GetFace>
-            >,
-
-            // For fast access by PoA Address
-            ordered_non_unique<
-              tag<i_poa>,
-              const_mem_fun<FaceMetric,Address,&FaceMetric::GetAddress>
-            >,
-
-            // For access by lease time
-            ordered_non_unique<
-              tag<i_lease>,
-              const_mem_fun<FaceMetric,Time,&FaceMetric::GetExpireTime>
-            >,
-
-            // List of available faces ordered by (status, m_routingCost)
-            ordered_non_unique<
-              tag<i_metric>,
-              composite_key<
-                FaceMetric,
-                const_mem_fun<FaceMetric,FaceMetric::Status,&FaceMetric::GetStatus>,
-                const_mem_fun<FaceMetric,int32_t,&FaceMetric::GetRoutingCost>
-              >
-            >,
-
-            // To optimize nth candidate selection (sacrifice a little bit
-            // space to gain speed)
-            random_access<
-              tag<i_nth>
-            >
-          >
-      > fmtr_set;
-      /// @endcond
-
-      typedef fmtr_set::index<i_face>::type fmtr_set_by_face;
-      typedef fmtr_set::index<i_poa>::type fmtr_set_by_poa;
-      typedef fmtr_set::index<i_lease>::type fmtr_set_by_lease;
-      typedef fmtr_set::index<i_metric>::type fmtr_set_by_metric;
-      typedef fmtr_set::index<i_nth>::type fmtr_set_by_nth;
-
       class Entry : public SimpleRefCount<Entry>
       {
       public:
@@ -132,7 +52,7 @@ namespace ns3
 	typedef nnnSIM::trie_with_policy<
 	    NNNAddress,
 	    nnnSIM::smart_pointer_payload_traits<Entry>,
-	    nnnSIM::counting_policy_traits
+	    nnnSIM::lease_policy_traits<EntryLease>
 	    > trie;
 
 	Entry();
@@ -211,6 +131,12 @@ namespace ns3
 	bool
 	isEmpty();
 
+	/**
+	 * \brief Earliest lease of the next hops, Time::Max () if there are none
+	 */
+	Time
+	GetEarliestLease () const;
+
 	void
 	RemovePoA (Address poa);
 
@@ -235,7 +161,7 @@ namespace ns3
       public:
 	Ptr<NNST> m_nnst;             ///< \brief NNST to which entry is added
 	Ptr<const NNNAddress> m_address;    ///< \brief Address used for the NNST Entry
-	fmtr_set m_faces;
+	FaceMetricSet m_faces;
 
       private:
 	trie::iterator item_;
@@ -22,10 +22,14 @@
 #include <boost/lambda/core.hpp>
 #include <boost/ref.hpp>
 
+#include <ns3-dev/ns3/trace-source-accessor.h>
+#include <ns3-dev/ns3/uinteger.h>
+
 namespace ll = boost::lambda;
 
 #include "nnn-nnst.h"
 #include "nnn-nnst-entry.h"
+#include "../../utils/nnn-limits.h"
 
 NS_LOG_COMPONENT_DEFINE ("nnn.nnst");
 
@@ -35,6 +39,20 @@ namespace ns3
   {
     NS_OBJECT_ENSURE_REGISTERED (NNST);
 
+    // Remove entry from the set kept under key, and the set when it is left empty
+    template<class Index, class Key>
+    static void
+    EraseFromIndex (Index &index, const Key &key, Ptr<nnst::Entry> entry)
+    {
+      typename Index::iterator it = index.find (key);
+      if (it == index.end ())
+	return;
+
+      it->second.erase (entry);
+      if (it->second.empty ())
+	index.erase (it);
+    }
+
     TypeId
     NNST::GetTypeId (void)
     {
@@ -42,11 +60,25 @@ namespace ns3
 	  .SetParent<Object> ()
 	  .SetGroupName ("Nnn")
 	  .AddConstructor<NNST> ()
+	  .AddAttribute ("MaxSize",
+	                 "Set maximum number of entries in NNST. If 0, limit is not enforced",
+	                 UintegerValue (0),
+	                 MakeUintegerAccessor (&NNST::GetMaxSize,
+	                                       &NNST::SetMaxSize),
+	                 MakeUintegerChecker<uint32_t> ())
+	  .AddTraceSource ("Evictions", "Evictions", MakeTraceSourceAccessor (&NNST::m_evictions))
+	  .AddTraceSource ("Entries", "Number of entries", MakeTraceSourceAccessor (&NNST::m_entries))
+	  .AddTraceSource ("Bytes", "Approximate memory held by the entries", MakeTraceSourceAccessor (&NNST::m_bytes))
 	  ;
       return tid;
     }
 
-    NNST::NNST() {
+    NNST::NNST()
+    : m_maxSize   (0)
+    , m_evictions (0)
+    , m_entries   (0)
+    , m_bytes     (0)
+    {
     }
 
     NNST::~NNST() {
@@ -120,6 +152,42 @@ namespace ns3
         return ClosestSectorFaceInfo(*prefix, skip);
     }
 
+    const nnst::FaceMetric *
+    NNST::ClosestSectorNextHop (const NNNAddress &prefix, uint32_t skip)
+    {
+      NS_LOG_FUNCTION (this << prefix);
+      Ptr<nnst::Entry> tmp = ClosestSector (prefix);
+
+      if (tmp == 0)
+	return 0;
+      else
+	return &tmp->FindBestCandidate (skip);
+    }
+
+    const nnst::FaceMetric *
+    NNST::NextOneHop (const NNNAddress &prefix, OneHopSector sector, uint32_t skip, Ptr<nnst::Entry> &from)
+    {
+      NS_LOG_FUNCTION (this << prefix << sector);
+
+      Ptr<nnst::Entry> curr = (from == 0) ? Begin () : Next (from);
+      for (; curr != End (); curr = Next (curr))
+	{
+	  const NNNAddress &name = curr->GetAddress ();
+	  if (name.distance (prefix) != 1)
+	    continue;
+
+	  if ((sector == ONE_HOP_SUB && !prefix.isParentSector (name)) ||
+	      (sector == ONE_HOP_PARENT && !name.isParentSector (prefix)))
+	    continue;
+
+	  from = curr;
+	  return &curr->FindBestCandidate (skip);
+	}
+
+      from = 0;
+      return 0;
+    }
+
     std::vector<Ptr<const NNNAddress> >
     NNST::OneHopNameInfo (const NNNAddress &prefix)
     {
@@ -150,15 +218,12 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
 
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      Ptr<nnst::Entry> from;
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
+      while (const nnst::FaceMetric *hop = NextOneHop (prefix, ONE_HOP_ANY, skip, from))
 	{
-	  if (curr->GetAddress().distance(prefix) == 1)
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
+	  ret.push_back (std::make_pair (hop->GetFace (), hop->GetAddress ()));
 	}
 
       return ret;
@@ -202,15 +267,12 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
 
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      Ptr<nnst::Entry> from;
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
+      while (const nnst::FaceMetric *hop = NextOneHop (prefix, ONE_HOP_SUB, skip, from))
 	{
-	  if (curr->GetAddress().distance(prefix) == 1 && prefix.isParentSector(curr->GetAddress()))
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
+	  ret.push_back (std::make_pair (hop->GetFace (), hop->GetAddress ()));
 	}
 
       return ret;
@@ -254,15 +316,12 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << prefix);
 
-      Ptr<nnst::Entry> curr;
       std::vector<std::pair<Ptr<Face>, Address> > ret;
+      Ptr<nnst::Entry> from;
 
-      for (curr = Begin(); curr != End (); curr = Next(curr))
+      while (const nnst::FaceMetric *hop = NextOneHop (prefix, ONE_HOP_PARENT, skip, from))
 	{
-	  if (curr->GetAddress().distance(prefix) == 1 && curr->GetAddress().isParentSector(prefix))
-	    {
-	      ret.push_back(curr->FindBestCandidateFaceInfo(skip));
-	    }
+	  ret.push_back (std::make_pair (hop->GetFace (), hop->GetAddress ()));
 	}
 
       return ret;
@@ -304,7 +363,7 @@ namespace ns3
 	  char c;
 	  Ptr<nnst::Entry> tmp = Add (Create<NNNAddress> (name), face, poa, lease_expire, metric, c);
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this);
 	  return tmp;
 	}
       else
@@ -330,7 +389,7 @@ namespace ns3
 	      tmp = Add(prefix, *i, poa, lease_expire, metric, c);
 	    }
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this);
 	  return tmp;
 	}
       else
@@ -356,7 +415,7 @@ namespace ns3
 	      tmp = Add(prefix, face, *i, lease_expire, metric, c);
 	    }
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this);
 	  return tmp;
 	}
       else
@@ -378,7 +437,7 @@ namespace ns3
 	  char c;
 	  Ptr<nnst::Entry> tmp = Add(name, face, poa, lease_expire, metric, c);
 
-	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+	  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this);
 	  return tmp;
 	}
       else
@@ -393,7 +452,14 @@ namespace ns3
       super::iterator item = super::find_exact (prefix);
 
       if (item != super::end ())
-	super::modify (&(*item), ll::bind (&nnst::Entry::UpdateStatus, ll::_1, face, status));
+	{
+	  super::modify (&(*item), ll::bind (&nnst::Entry::UpdateStatus, ll::_1, face, status));
+
+	  // Let the Face adapt what it lets through to the state of the next hop
+	  Ptr<Limits> limits = m_forwardingStrategy != 0 ? m_forwardingStrategy->GetEnforcedLimits (face) : 0;
+	  if (limits != 0)
+	    limits->NotifyFaceStatus (status);
+	}
     }
 
     void
@@ -417,7 +483,7 @@ namespace ns3
 	      if (ok)
 		{
 		  Ptr<nnst::Entry> tmp = item->payload ();
-		  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this, tmp);
+		  Simulator::Schedule(relativeExpireTime, &NNST::cleanExpired, this);
 		}
 	    }
 	}
@@ -472,7 +538,7 @@ namespace ns3
 	  //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	  //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (nnstEntry->payload ());
 
-	  super::erase (nnstEntry);
+	  Erase (nnstEntry->payload ());
 	}
     }
 
@@ -481,24 +547,33 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << boost::cref(*face));
 
-      Ptr<nnst::Entry> entry = Begin ();
-      while (entry != End ())
+      face_index::iterator idx = m_faceIndex.find (face->GetId ());
+      if (idx == m_faceIndex.end ())
+	return;
+
+      // Only the entries that use the Face need to be visited
+      std::set<Ptr<nnst::Entry> > entries;
+      entries.swap (idx->second);
+      m_faceIndex.erase (idx);
+
+      std::vector<Address> poas;
+      for (std::set<Ptr<nnst::Entry> >::iterator it = entries.begin (); it != entries.end (); ++it)
 	{
-	  entry->RemoveFace (face);
-	  if (entry->m_faces.size () == 0)
-	    {
-	      Ptr<nnst::Entry> nextEntry = Next (entry);
+	  Ptr<nnst::Entry> entry = *it;
+
+	  poas = entry->GetPoAs (face);
+	  RemoveFace (*entry->to_iterator (), face);
+
+	  for (std::vector<Address>::iterator i = poas.begin (); i != poas.end (); ++i)
+	    Unindex (entry, face, *i);
 
+	  if (entry->isEmpty ())
+	    {
 	      // notify forwarding strategy about soon be removed FIB entry
 	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
 
-	      super::erase (StaticCast<nnst::Entry> (entry)->to_iterator ());
-	      entry = nextEntry;
-	    }
-	  else
-	    {
-	      entry = Next (entry);
+	      Erase (entry);
 	    }
 	}
     }
@@ -508,24 +583,39 @@ namespace ns3
     {
       NS_LOG_FUNCTION (this << poa);
 
-      Ptr<nnst::Entry> entry = Begin ();
-      while (entry != End ())
+      poa_index::iterator idx = m_poaIndex.find (poa);
+      if (idx == m_poaIndex.end ())
+	return;
+
+      // Only the entries that use the PoA need to be visited
+      std::set<Ptr<nnst::Entry> > entries;
+      entries.swap (idx->second);
+      m_poaIndex.erase (idx);
+
+      std::vector<Ptr<Face> > faces;
+      for (std::set<Ptr<nnst::Entry> >::iterator it = entries.begin (); it != entries.end (); ++it)
 	{
-	  entry->RemovePoA (poa);
-	  if (entry->m_faces.size () == 0)
+	  Ptr<nnst::Entry> entry = *it;
+
+	  faces.clear ();
+	  for (uint32_t i = 0; i < entry->m_faces.size (); i++)
 	    {
-	      Ptr<nnst::Entry> nextEntry = Next (entry);
+	      if (entry->m_faces[i].GetAddress () == poa)
+		faces.push_back (entry->m_faces[i].GetFace ());
+	    }
 
+	  RemovePoA (*entry->to_iterator (), poa);
+
+	  for (std::vector<Ptr<Face> >::iterator i = faces.begin (); i != faces.end (); ++i)
+	    Unindex (entry, *i, poa);
+
+	  if (entry->isEmpty ())
+	    {
 	      // notify forwarding strategy about soon be removed NNST entry
 	      //NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
 	      //this->GetObject<ForwardingStrategy> ()->WillRemoveNNSTEntry (entry);
 
-	      super::erase (entry->to_iterator ());
-	      entry = nextEntry;
-	    }
-	  else
-	    {
-	      entry = Next (entry);
+	      Erase (entry);
 	    }
 	}
     }
@@ -602,6 +692,19 @@ namespace ns3
       return super::getPolicy ().size ();
     }
 
+    uint32_t
+    NNST::GetMaxSize () const
+    {
+      return m_maxSize;
+    }
+
+    void
+    NNST::SetMaxSize (uint32_t maxSize)
+    {
+      m_maxSize = maxSize;
+      EnforceMaxSize (0);
+    }
+
     Ptr<const nnst::Entry>
     NNST::Begin () const
     {
@@ -719,13 +822,22 @@ namespace ns3
     void
     NNST::NotifyNewAggregate ()
     {
+      if (m_forwardingStrategy == 0)
+	{
+	  m_forwardingStrategy = GetObject<ForwardingStrategy> ();
+	}
+
       Object::NotifyNewAggregate ();
     }
 
     void
     NNST::DoDispose (void)
     {
+      m_faceIndex.clear ();
+      m_poaIndex.clear ();
       clear ();
+      UpdateSize ();
+      m_forwardingStrategy = 0;
       Object::DoDispose ();
     }
 
@@ -761,6 +873,16 @@ namespace ns3
 	  if (!result.second)
 	    {
 	      result.first->payload()->AddPoA(face, poa, lease_expire, metric);
+	      // The new PoA may bring the lease of the entry closer
+	      super::getPolicy ().update (result.first);
+	    }
+
+	  Index (result.first->payload (), face, poa);
+
+	  if (result.second)
+	    {
+	      UpdateSize ();
+	      EnforceMaxSize (result.first->payload ());
 	    }
 
 	  return result.first->payload ();
@@ -790,15 +912,117 @@ namespace ns3
     }
 
     void
-    NNST::cleanExpired(Ptr<nnst::Entry> item)
+    NNST::cleanExpired ()
+    {
+      NS_LOG_FUNCTION (this);
+
+      Time now = Simulator::Now ();
+
+      // Remember what is going to expire to fix the indexes afterwards
+      std::vector<std::pair<Ptr<Face>, Address> > expired;
+
+      super::iterator node;
+      while ((node = super::getPolicy ().pop_expired (now)) != super::end ())
+	{
+	  Ptr<nnst::Entry> item = node->payload ();
+	  NS_LOG_INFO ("Lease due for (" << item->GetAddress () << ")");
+
+	  expired.clear ();
+	  for (uint32_t i = 0; i < item->m_faces.size (); i++)
+	    {
+	      const nnst::FaceMetric &metric = item->m_faces[i];
+	      if (metric.GetExpireTime () <= now)
+		expired.push_back (std::make_pair (metric.GetFace (), metric.GetAddress ()));
+	    }
+
+	  item->cleanExpired ();
+
+	  for (std::vector<std::pair<Ptr<Face>, Address> >::iterator it = expired.begin (); it != expired.end (); ++it)
+	    Unindex (item, it->first, it->second);
+
+	  if (item->isEmpty ())
+	    Erase (item);
+	  else
+	    // Back in the lease order with the next lease of the entry
+	    super::getPolicy ().update (node);
+	}
+    }
+
+    void
+    NNST::Index (Ptr<nnst::Entry> entry, Ptr<Face> face, Address poa)
+    {
+      m_faceIndex[face->GetId ()].insert (entry);
+      m_poaIndex[poa].insert (entry);
+    }
+
+    void
+    NNST::Unindex (Ptr<nnst::Entry> entry, Ptr<Face> face, Address poa)
+    {
+      if (!entry->m_faces.HasFace (face))
+	EraseFromIndex (m_faceIndex, face->GetId (), entry);
+
+      if (!entry->m_faces.HasPoA (poa))
+	EraseFromIndex (m_poaIndex, poa, entry);
+    }
+
+    void
+    NNST::Erase (Ptr<nnst::Entry> entry)
     {
-      Ptr<const NNNAddress> name = item->GetAddressPtr();
-      NS_LOG_FUNCTION (this << boost::cref(*name));
+      for (uint32_t i = 0; i < entry->m_faces.size (); i++)
+	{
+	  EraseFromIndex (m_faceIndex, entry->m_faces[i].GetFace ()->GetId (), entry);
+	  EraseFromIndex (m_poaIndex, entry->m_faces[i].GetAddress (), entry);
+	}
 
-      item->cleanExpired ();
+      super::erase (entry->to_iterator ());
+      UpdateSize ();
+    }
 
-      if (item->isEmpty ())
-	Remove (name);
+    void
+    NNST::EnforceMaxSize (Ptr<nnst::Entry> keep)
+    {
+      if (m_maxSize == 0)
+	return;
+
+      while (GetSize () > m_maxSize)
+	{
+	  // The lease policy keeps the entries with the nearest lease first
+	  super::policy_container::iterator victim = super::getPolicy ().begin ();
+	  if (victim->payload () == keep)
+	    ++victim;
+
+	  if (victim == super::getPolicy ().end ())
+	    break;
+
+	  Ptr<nnst::Entry> entry = victim->payload ();
+	  NS_LOG_INFO ("Evicting (" << entry->GetAddress () << ") with lease " << entry->GetEarliestLease ());
+	  Erase (entry);
+	  m_evictions++;
+	}
+    }
+
+    void
+    NNST::UpdateSize ()
+    {
+      // Trie node, entry, its 3N name and one next hop; the indexes hold
+      // a reference to the entry for each Face and PoA
+      static const uint64_t entryBytes = sizeof (super::parent_trie) + sizeof (nnst::Entry) + sizeof (NNNAddress)
+	  + sizeof (nnst::FaceMetric) + 2 * sizeof (Ptr<nnst::Entry>);
+
+      m_entries = GetSize ();
+      m_bytes = m_entries * entryBytes;
+    }
+
+    uint32_t
+    NNST::GetEntries () const
+    {
+      return m_entries;
+    }
+
+    uint64_t
+    NNST::GetBytes () const
+    {
+      return m_bytes;
     }
 
     std::ostream&
@@ -29,6 +29,9 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 
+#include <map>
+#include <set>
+
 using namespace ::boost;
 using namespace ::boost::multi_index;
 
@@ -38,13 +41,14 @@ using namespace ::boost::multi_index;
 #include <ns3-dev/ns3/node.h>
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/object.h>
+#include <ns3-dev/ns3/traced-value.h>
 
 #include "nnn-nnst-entry-facemetric.h"
 #include "../nnn-naming.h"
 #include "../nnn-face.h"
 #include "../fw/nnn-forwarding-strategy.h"
 #include "../../utils/trie/trie.h"
-#include "../../utils/trie/counting-policy.h"
+#include "../../utils/trie/lease-policy.h"
 #include "../../utils/trie/trie-with-policy.h"
 
 namespace ns3
@@ -63,6 +67,19 @@ namespace ns3
     namespace nnst {
 
       class Entry;
+
+      /**
+       * @ingroup nnn-nnst
+       * @brief Lease of an NNST Entry for nnnSIM::lease_policy_traits, the
+       * earliest lease of its next hops
+       */
+      struct EntryLease
+      {
+	typedef Time value_type;
+
+	Time
+	operator() (Ptr<const Entry> entry) const;
+      };
     }
 
     /**
@@ -73,16 +90,26 @@ namespace ns3
     protected nnnSIM::trie_with_policy<
     NNNAddress,
     nnnSIM::smart_pointer_payload_traits<nnst::Entry>,
-    nnnSIM::counting_policy_traits>
+    nnnSIM::lease_policy_traits<nnst::EntryLease>>
     {
     public:
 
       typedef nnnSIM::trie_with_policy<
 	  NNNAddress,
 	  nnnSIM::smart_pointer_payload_traits<nnst::Entry>,
-	  nnnSIM::counting_policy_traits
+	  nnnSIM::lease_policy_traits<nnst::EntryLease>
 	  > super;
 
+      /**
+       * \brief Which entries one hop away from a name NextOneHop returns
+       */
+      enum OneHopSector
+      {
+	ONE_HOP_ANY,    ///< \brief Every entry at distance 1 (OneHopFaceInfo)
+	ONE_HOP_SUB,    ///< \brief Sub sectors (OneHopSubSectorFaceInfo)
+	ONE_HOP_PARENT  ///< \brief Parent sectors (OneHopParentSectorFaceInfo)
+      };
+
       /**
        * \brief Interface ID
        *
@@ -134,6 +161,17 @@ namespace ns3
       std::pair<Ptr<Face>, Address>
       ClosestSectorFaceInfo (Ptr<const NNNAddress> prefix, uint32_t skip);
 
+      /**
+       *  \brief Next hop of the closest NNNAddress to the given address,
+       *  without copying it
+       *
+       *  The FaceMetric belongs to the NNST entry, it is only valid until
+       *  the NNST is modified. Returns 0 if no entry matches, which
+       *  callers have to check before using the FaceMetric
+       */
+      const nnst::FaceMetric *
+      ClosestSectorNextHop (const NNNAddress &prefix, uint32_t skip);
+
       /**
        *  \brief A vector of all Addresses of nodes within one hop distance
        */
@@ -212,6 +250,25 @@ namespace ns3
       std::vector<std::pair<Ptr<Face>, Address> >
       OneHopParentSectorFaceInfo (Ptr<const NNNAddress> prefix, uint32_t skip);
 
+      /**
+       * \brief Walk the next hops of the entries one hop away from prefix
+       * without building a vector
+       *
+       * \param from cursor, 0 to start. Updated to the entry the returned
+       * next hop belongs to
+       *
+       * \return skip-th best next hop of the next matching entry, 0 when
+       * there are no more. Only valid until the NNST is modified
+       *
+       * \code
+       * Ptr<nnst::Entry> from;
+       * while (const nnst::FaceMetric *hop = nnst->NextOneHop (prefix, NNST::ONE_HOP_PARENT, 0, from))
+       *   hop->GetFace ()->SendDEN (den, hop->GetAddress ());
+       * \endcode
+       */
+      const nnst::FaceMetric *
+      NextOneHop (const NNNAddress &prefix, OneHopSector sector, uint32_t skip, Ptr<nnst::Entry> &from);
+
       /**
        * \brief Find an entry in nnst
        */
@@ -343,6 +400,21 @@ namespace ns3
       uint32_t
       GetSize ();
 
+      /**
+       * \brief Get the maximum number of entries, 0 if there is no limit
+       */
+      uint32_t
+      GetMaxSize () const;
+
+      /**
+       * \brief Set the maximum number of entries, 0 to lift the limit
+       *
+       * Going over the limit evicts the entries whose lease is the
+       * nearest, as they are the ones that would go away first anyway
+       */
+      void
+      SetMaxSize (uint32_t maxSize);
+
       /**
        * \brief Get the nnst of a specific node
        */
@@ -361,6 +433,18 @@ namespace ns3
       std::vector<Address>
       GetAllPoas (const NNNAddress &prefix);
 
+      /**
+       * @brief Current value of the Entries trace source
+       */
+      uint32_t
+      GetEntries () const;
+
+      /**
+       * @brief Current value of the Bytes trace source
+       */
+      uint64_t
+      GetBytes () const;
+
     protected:
       // inherited from Object class
       virtual void NotifyNewAggregate (); ///< @brief Notify when object is aggregated
@@ -384,8 +468,60 @@ namespace ns3
       void
       RemovePoA (super::parent_trie &item, Address poa);
 
+      /**
+       * @brief Drop the next hops whose lease is due, going only through
+       * the entries the lease policy gives out as expired
+       */
+      void
+      cleanExpired ();
+
+      /**
+       * @brief Record that entry has a FaceMetric using face and poa
+       */
+      void
+      Index (Ptr<nnst::Entry> entry, Ptr<Face> face, Address poa);
+
+      /**
+       * @brief Drop the index records of entry for face and poa when
+       * none of its remaining FaceMetrics use them
+       */
+      void
+      Unindex (Ptr<nnst::Entry> entry, Ptr<Face> face, Address poa);
+
+      /**
+       * @brief Erase the entry from the trie, dropping all its index records
+       */
+      void
+      Erase (Ptr<nnst::Entry> entry);
+
+      /**
+       * @brief Evict entries, nearest lease first, until the NNST is back
+       * within m_maxSize. The entry just added (keep) is never evicted
+       */
       void
-      cleanExpired(Ptr<nnst::Entry> item);
+      EnforceMaxSize (Ptr<nnst::Entry> keep);
+
+      /**
+       * @brief Refresh the Entries and Bytes trace sources after the
+       * number of entries changed
+       */
+      void
+      UpdateSize ();
+
+    private:
+      typedef std::map<uint32_t, std::set<Ptr<nnst::Entry> > > face_index;
+      typedef std::map<Address, std::set<Ptr<nnst::Entry> > > poa_index;
+
+      // Reverse indexes, so RemoveFromAll only visits the affected entries
+      face_index m_faceIndex; ///< @brief Entries using a Face, by Face id
+      poa_index m_poaIndex;   ///< @brief Entries using a PoA
+
+      uint32_t m_maxSize;                ///< @brief Maximum number of entries, 0 for no limit
+      TracedValue<uint32_t> m_evictions; ///< @brief Number of entries evicted to honour m_maxSize
+      TracedValue<uint32_t> m_entries;   ///< @brief Number of entries
+      TracedValue<uint64_t> m_bytes;     ///< @brief Approximate memory held by the entries
+
+      Ptr<ForwardingStrategy> m_forwardingStrategy; ///< @brief Decides which Face Limits hear about the status of a next hop
     };
 
     std::ostream& operator<< (std::ostream& os, const NNST &nnst);
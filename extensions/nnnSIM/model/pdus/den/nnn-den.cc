@@ -30,12 +30,14 @@ namespace ns3
     DEN::DEN ()
     : NNNPDU (DEN_NNN, Seconds(0))
     , ENPDU ()
+    , m_next_sector (Create<NNNAddress> ())
     {
     }
 
     DEN::DEN (Ptr<NNNAddress> name)
     : NNNPDU (DEN_NNN, Seconds(0))
     , ENPDU ()
+    , m_next_sector (Create<NNNAddress> ())
     {
       SetName (name);
     }
@@ -43,6 +45,7 @@ namespace ns3
     DEN::DEN (const NNNAddress &name)
     : NNNPDU (DEN_NNN, Seconds(0))
     , ENPDU ()
+    , m_next_sector (Create<NNNAddress> ())
     {
       SetName (name);
     }
@@ -55,6 +58,7 @@ namespace ns3
       SetLifetime (den_p.GetLifetime ());
       AddPoa (den_p.GetPoas ());
       SetName (den_p.GetName ());
+      SetNextSector (den_p.GetNextSector ());
       SetWire (den_p.GetWire ());
     }
 
@@ -85,12 +89,46 @@ namespace ns3
       SetWire (0);
     }
 
+    const NNNAddress&
+    DEN::GetNextSector () const
+    {
+      return *m_next_sector;
+    }
+
+    Ptr<const NNNAddress>
+    DEN::GetNextSectorPtr () const
+    {
+      return m_next_sector;
+    }
+
+    void
+    DEN::SetNextSector (Ptr<NNNAddress> sector)
+    {
+      m_next_sector = sector;
+      SetWire (0);
+    }
+
+    void
+    DEN::SetNextSector (const NNNAddress &sector)
+    {
+      m_next_sector = Create<NNNAddress> (sector);
+      SetWire (0);
+    }
+
+    bool
+    DEN::HasNextSector () const
+    {
+      return !m_next_sector->isEmpty ();
+    }
+
     void
     DEN::Print (std::ostream &os) const
     {
       os << "<DEN>" << std::endl;
       NNNPDU::Print(os);
       os << "  <Name>" << GetName () << "</Name>" << std::endl;
+      if (HasNextSector ())
+	os << "  <NextSector>" << GetNextSector () << "</NextSector>" << std::endl;
       ENPDU::Print(os);
       os << "</DEN>" << std::endl;
     }
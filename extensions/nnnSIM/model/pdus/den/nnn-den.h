@@ -98,6 +98,41 @@ namespace ns3
       void
       SetName (const NNNAddress &name);
 
+      /**
+       * \brief Get the 3N name of the sector the node predicts it will
+       * attach to next, empty if there is no prediction
+       **/
+      const NNNAddress&
+      GetNextSector () const;
+
+      /**
+       * @brief Get smart pointer to the predicted next sector
+       */
+      Ptr<const NNNAddress>
+      GetNextSectorPtr () const;
+
+      /**
+       * \brief Set the 3N name of the predicted next sector
+       *
+       * @param sector smart pointer to Name
+       **/
+      void
+      SetNextSector (Ptr<NNNAddress> sector);
+
+      /**
+       * \brief Another variant to set the predicted next sector
+       *
+       * @param sector const reference to Name object
+       **/
+      void
+      SetNextSector (const NNNAddress &sector);
+
+      /**
+       * \brief Check if the DEN carries a predicted next sector
+       **/
+      bool
+      HasNextSector () const;
+
       /**
        * @brief Print DEN in plain-text to the specified output stream
        */
@@ -111,6 +146,7 @@ namespace ns3
 
     protected:
       Ptr<NNNAddress> m_name;   ///< @brief NNN Address used in the packet
+      Ptr<NNNAddress> m_next_sector;   ///< @brief Predicted next sector of the leaving node, empty if none
     };
 
     inline std::ostream &
@@ -51,7 +51,7 @@ namespace ns3
       return m_poas.size();
     }
 
-    std::vector<Address>
+    const std::vector<Address> &
     ENPDU::GetPoas () const
     {
       return m_poas;
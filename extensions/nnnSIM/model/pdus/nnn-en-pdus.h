@@ -50,7 +50,7 @@ namespace ns3
        * \brief Get PoA names attached
        *
        **/
-      std::vector<Address>
+      const std::vector<Address> &
       GetPoas () const;
 
       Address
@@ -41,8 +41,12 @@ namespace ns3
 
     /**
      * @brief enum for NNN version being used
+     *
+     * B_NNN PDUs carry their PoA lists and names in the compact nnnSIM
+     * encoding. The version travels in the common header, so a node
+     * decodes whatever version its neighbours chose to send.
      */
-    enum NNN_VER { A_NNN = 0 };
+    enum NNN_VER { A_NNN = 0, B_NNN = 1 };
 
     class NNNPDU : public SimpleRefCount<NNNPDU>
     {
@@ -138,6 +142,7 @@ namespace ns3
     NNNPDU::SetVersion(uint16_t version)
     {
       m_version = version;
+      m_wire = 0;
     }
 
     inline Time
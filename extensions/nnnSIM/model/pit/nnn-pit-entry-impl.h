@@ -49,12 +49,20 @@ namespace ns3
       , item_ (0)
       {
 	  CONTAINER.i_time.insert (*this);
+	  CONTAINER.i_fib[PeekPointer (m_fibEntry)].insert (this);
 	  CONTAINER.RescheduleCleaning ();
       }
 
 	virtual ~EntryImpl ()
 	{
 	  CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+	  CONTAINER.EraseFromIndex (CONTAINER.i_fib, PeekPointer (m_fibEntry), this);
+
+	  for (in_iterator it = m_incoming.begin (); it != m_incoming.end (); ++it)
+	    CONTAINER.EraseFromIndex (CONTAINER.i_face, it->m_face->GetId (), this);
+	  for (out_iterator it = m_outgoing.begin (); it != m_outgoing.end (); ++it)
+	    CONTAINER.EraseFromIndex (CONTAINER.i_face, it->m_face->GetId (), this);
+
 	  CONTAINER.RescheduleCleaning ();
 	}
 
@@ -78,6 +86,77 @@ namespace ns3
 	  CONTAINER.RescheduleCleaning ();
 	}
 
+	virtual in_iterator
+	AddIncoming (Ptr<Face> face)
+	{
+	  in_iterator ret = super::AddIncoming (face);
+	  CONTAINER.i_face[face->GetId ()].insert (this);
+	  return ret;
+	}
+
+	virtual in_iterator
+	AddIncoming (Ptr<Face> face, Ptr<const NNNAddress> addr)
+	{
+	  in_iterator ret = super::AddIncoming (face, addr);
+	  CONTAINER.i_face[face->GetId ()].insert (this);
+	  return ret;
+	}
+
+	virtual void
+	RemoveIncoming (Ptr<Face> face)
+	{
+	  super::RemoveIncoming (face);
+	  UnindexFace (face);
+	}
+
+	virtual void
+	RemoveIncoming (Ptr<Face> face, Ptr<const NNNAddress> addr)
+	{
+	  super::RemoveIncoming (face, addr);
+	  UnindexFace (face);
+	}
+
+	virtual void
+	ClearIncoming ()
+	{
+	  std::vector<Ptr<Face> > faces;
+	  for (in_iterator it = m_incoming.begin (); it != m_incoming.end (); ++it)
+	    faces.push_back (it->m_face);
+
+	  super::ClearIncoming ();
+
+	  for (std::vector<Ptr<Face> >::iterator it = faces.begin (); it != faces.end (); ++it)
+	    UnindexFace (*it);
+	}
+
+	virtual out_iterator
+	AddOutgoing (Ptr<Face> face)
+	{
+	  out_iterator ret = super::AddOutgoing (face);
+	  CONTAINER.i_face[face->GetId ()].insert (this);
+	  return ret;
+	}
+
+	virtual void
+	ClearOutgoing ()
+	{
+	  std::vector<Ptr<Face> > faces;
+	  for (out_iterator it = m_outgoing.begin (); it != m_outgoing.end (); ++it)
+	    faces.push_back (it->m_face);
+
+	  super::ClearOutgoing ();
+
+	  for (std::vector<Ptr<Face> >::iterator it = faces.begin (); it != faces.end (); ++it)
+	    UnindexFace (*it);
+	}
+
+	virtual void
+	RemoveAllReferencesToFace (Ptr<Face> face)
+	{
+	  super::RemoveAllReferencesToFace (face);
+	  UnindexFace (face);
+	}
+
 	// to make sure policies work
 	void
 	SetTrie (typename Pit::super::iterator item) { item_ = item; }
@@ -88,6 +167,15 @@ namespace ns3
       public:
 	boost::intrusive::set_member_hook<> time_hook_;
 
+      private:
+	// Drop the face index record once neither incoming nor outgoing use face
+	void
+	UnindexFace (Ptr<Face> face)
+	{
+	  if (m_incoming.find (face) == m_incoming.end () && m_outgoing.find (face) == m_outgoing.end ())
+	    CONTAINER.EraseFromIndex (CONTAINER.i_face, face->GetId (), this);
+	}
+
       private:
 	typename Pit::super::iterator item_;
       };
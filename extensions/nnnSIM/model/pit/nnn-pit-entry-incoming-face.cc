@@ -19,6 +19,8 @@
  *  You should have received a copy of the GNU Affero Public License
  *  along with nnn-pit-entry-incoming-face.cc.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+
 #include <ns3-dev/ns3/simulator.h>
 
 #include "nnn-pit-entry-incoming-face.h"
@@ -31,10 +33,52 @@ namespace ns3
   {
     namespace pit
     {
+      namespace
+      {
+	/**
+	 * Orders 3N names by sector first and by last label after, so that the
+	 * names of a sector are next to each other, like in NNNAddrAggregator
+	 */
+	struct AddressLess
+	{
+	  bool
+	  operator() (const Ptr<const NNNAddress> &a, const Ptr<const NNNAddress> &b) const
+	  {
+	    if (a->isEmpty () || b->isEmpty ())
+	      return a->isEmpty () && !b->isEmpty ();
+
+	    NNNAddress::const_iterator aLabel = a->end () - 1;
+	    NNNAddress::const_iterator bLabel = b->end () - 1;
+
+	    if (std::lexicographical_compare (a->begin (), aLabel, b->begin (), bLabel))
+	      return true;
+	    if (std::lexicographical_compare (b->begin (), bLabel, a->begin (), aLabel))
+	      return false;
+
+	    return *aLabel < *bLabel;
+	  }
+	};
+
+	/// Adds each visited 3N name to an NNNAddrAggregator, which keeps its own copy
+	struct AddToAggregator
+	{
+	  AddToAggregator (Ptr<NNNAddrAggregator> addrs) : m_addrs (addrs) {}
+
+	  void
+	  operator() (Ptr<const NNNAddress> dst)
+	  {
+	    m_addrs->AddDestination (dst);
+	  }
+
+	  Ptr<NNNAddrAggregator> m_addrs;
+	};
+      }
+
       IncomingFace::IncomingFace (Ptr<Face> face)
       : m_face (face)
       , m_arrivalTime (Simulator::Now ())
-      , m_addrs (Create<NNNAddrAggregator> ())
+      , m_flat (0)
+      , m_size (0)
       // , m_nonce (nonce)
       {
       }
@@ -42,34 +86,192 @@ namespace ns3
       IncomingFace::IncomingFace (Ptr<Face> face, Ptr<const NNNAddress> addr)
       : m_face (face)
       , m_arrivalTime (Simulator::Now ())
-      , m_addrs (Create<NNNAddrAggregator> ())
+      , m_flat (0)
+      , m_size (0)
       {
-	m_addrs->AddDestination(addr);
+	AddDestination (addr);
       }
 
       IncomingFace::IncomingFace ()
       : m_face (0)
       , m_arrivalTime (0)
-      , m_addrs (Create<NNNAddrAggregator> ())
+      , m_flat (0)
+      , m_size (0)
+      {
+      }
+
+      IncomingFace::IncomingFace (const IncomingFace &other)
+      : m_face (0)
+      , m_arrivalTime (0)
+      , m_flat (0)
+      , m_size (0)
       {
+	*this = other;
+      }
+
+      IncomingFace::~IncomingFace ()
+      {
+	Clear ();
       }
 
       void
       IncomingFace::AddDestination(Ptr<const NNNAddress> addr)
       {
-	m_addrs->AddDestination(addr);
+	if (addr == 0)
+	  return;
+
+	if (m_addrs != 0)
+	  {
+	    // The aggregator counts the same 3N name twice, keep it out
+	    if (m_addrs->DestinationExists (ConstCast<NNNAddress> (addr)))
+	      return;
+
+	    m_addrs->AddDestination (addr);
+	    m_size++;
+	    return;
+	  }
+
+	if (m_flat != 0)
+	  {
+	    flat_set::iterator it = std::lower_bound (m_flat->begin (), m_flat->end (), addr, AddressLess ());
+	    if (it != m_flat->end () && **it == *addr)
+	      return;
+
+	    if (m_size == FlatSize)
+	      {
+		ToAggregator ();
+		AddDestination (addr);
+		return;
+	      }
+
+	    m_flat->insert (it, addr);
+	    m_size++;
+	    return;
+	  }
+
+	uint32_t pos = 0;
+	while (pos < m_size && AddressLess () (m_inline[pos], addr))
+	  pos++;
+
+	if (pos < m_size && *m_inline[pos] == *addr)
+	  return;
+
+	if (m_size == InlineSize)
+	  {
+	    ToFlat ();
+	    AddDestination (addr);
+	    return;
+	  }
+
+	for (uint32_t i = m_size; i > pos; i--)
+	  m_inline[i] = m_inline[i - 1];
+	m_inline[pos] = addr;
+	m_size++;
       }
 
       void
       IncomingFace::RemoveDestination(Ptr<const NNNAddress> addr)
       {
-	m_addrs->RemoveDestination(addr);
+	if (addr == 0)
+	  return;
+
+	if (m_addrs != 0)
+	  {
+	    // The aggregator uncounts 3N names it does not have
+	    if (!m_addrs->DestinationExists (ConstCast<NNNAddress> (addr)))
+	      return;
+
+	    m_addrs->RemoveDestination (addr);
+	    m_size--;
+	  }
+	else if (m_flat != 0)
+	  {
+	    flat_set::iterator it = std::lower_bound (m_flat->begin (), m_flat->end (), addr, AddressLess ());
+	    if (it == m_flat->end () || !(**it == *addr))
+	      return;
+
+	    m_flat->erase (it);
+	    m_size--;
+	  }
+	else
+	  {
+	    uint32_t pos = 0;
+	    while (pos < m_size && !(*m_inline[pos] == *addr))
+	      pos++;
+
+	    if (pos == m_size)
+	      return;
+
+	    for (uint32_t i = pos; i + 1 < m_size; i++)
+	      m_inline[i] = m_inline[i + 1];
+	    m_size--;
+	    m_inline[m_size] = 0;
+	  }
+
+	Shrink ();
       }
 
       bool
-      IncomingFace::NoAddresses()
+      IncomingFace::NoAddresses() const
       {
-	return m_addrs->isEmpty();
+	return m_size == 0;
+      }
+
+      uint32_t
+      IncomingFace::GetNumDestinations () const
+      {
+	return m_size;
+      }
+
+      void
+      IncomingFace::ToFlat ()
+      {
+	m_flat = new flat_set (m_inline, m_inline + m_size);
+	for (uint32_t i = 0; i < InlineSize; i++)
+	  m_inline[i] = 0;
+      }
+
+      void
+      IncomingFace::ToAggregator ()
+      {
+	m_addrs = Create<NNNAddrAggregator> ();
+	for (flat_set::iterator it = m_flat->begin (); it != m_flat->end (); ++it)
+	  m_addrs->AddDestination (*it);
+
+	delete m_flat;
+	m_flat = 0;
+      }
+
+      void
+      IncomingFace::Shrink ()
+      {
+	// Leave some room before going back up, so that a face going back
+	// and forth around FlatSize does not rebuild the aggregator each time
+	if (m_addrs != 0 && m_size <= FlatSize / 2)
+	  {
+	    std::vector<Ptr<NNNAddress> > total = m_addrs->GetTotalDestinations ();
+	    m_flat = new flat_set (total.begin (), total.end ());
+	    std::sort (m_flat->begin (), m_flat->end (), AddressLess ());
+	    m_addrs = 0;
+	  }
+
+	if (m_flat != 0 && m_size <= InlineSize)
+	  {
+	    std::copy (m_flat->begin (), m_flat->end (), m_inline);
+	    delete m_flat;
+	    m_flat = 0;
+	  }
+      }
+
+      void
+      IncomingFace::Clear ()
+      {
+	delete m_flat;
+	m_flat = 0;
+	m_addrs = 0;
+	for (uint32_t i = 0; i < InlineSize; i++)
+	  m_inline[i] = 0;
+	m_size = 0;
       }
 
       /**
@@ -78,9 +280,27 @@ namespace ns3
       IncomingFace &
       IncomingFace::operator = (const IncomingFace &other)
       {
+	if (this == &other)
+	  return *this;
+
 	m_face = other.m_face;
-	m_addrs = other.m_addrs;
 	m_arrivalTime = other.m_arrivalTime;
+
+	Clear ();
+
+	// Each copy owns its 3N names
+	if (other.m_addrs != 0)
+	  {
+	    m_addrs = Create<NNNAddrAggregator> ();
+	    AddToAggregator add (m_addrs);
+	    other.VisitDestinations (add);
+	  }
+	else if (other.m_flat != 0)
+	  m_flat = new flat_set (*other.m_flat);
+	else
+	  std::copy (other.m_inline, other.m_inline + other.m_size, m_inline);
+
+	m_size = other.m_size;
 	return *this;
       }
     } // namespace pit
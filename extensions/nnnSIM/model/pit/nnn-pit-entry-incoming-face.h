@@ -22,28 +22,73 @@
 #ifndef _NNN_PIT_ENTRY_INCOMING_FACE_H_
 #define	_NNN_PIT_ENTRY_INCOMING_FACE_H_
 
+#include <vector>
+
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/ptr.h>
 
 #include "../nnn-face.h"
 #include "../addr-aggr/nnn-addr-aggregator.h"
+#include "../naming/nnn-address.h"
 
 namespace ns3
 {
   namespace nnn
   {
-    class NNNAddress;
-
     namespace pit
     {
+      /**
+       * @brief Turns the (sector, label) pairs of NNNAddrAggregator::VisitDestinations
+       * into complete 3N names for a visitor of IncomingFace::VisitDestinations
+       *
+       * The same NNNAddress is refilled for every pair, a new one is only
+       * created when the visitor kept a reference to the previous one
+       */
+      template<class Visitor>
+      class CompleteNameVisitor
+      {
+      public:
+	CompleteNameVisitor (Visitor &visitor)
+	: m_visitor (visitor)
+	, m_name (Create<NNNAddress> ())
+	{
+	}
+
+	void
+	operator () (const NNNAddress &sector, const NNNAddress &label)
+	{
+	  if (m_name->GetReferenceCount () > 1)
+	    m_name = Create<NNNAddress> ();
+
+	  *m_name = sector;
+	  m_name->append (label);
+	  m_visitor (Ptr<const NNNAddress> (m_name));
+	}
+
+      private:
+	Visitor &m_visitor;
+	Ptr<NNNAddress> m_name;
+      };
+
       /**
        * @ingroup nnn-pit
        * @brief PIT state component for each incoming interest (not including duplicates)
+       *
+       * Most incoming faces carry no 3N name or a single one, so the 3N names
+       * seen on the face are kept in three tiers:
+       * - up to InlineSize names inside the object itself
+       * - up to FlatSize names in a sorted vector
+       * - above that, in an NNNAddrAggregator
+       *
+       * The names are moved back to a smaller tier once they fit again. In
+       * every tier the names of the same sector are handed out together.
        */
       struct IncomingFace
       {
+	static const uint32_t InlineSize = 2;
+	static const uint32_t FlatSize = 16;
+
 	Ptr<Face> m_face; ///< \brief face of the incoming Interest
-	Ptr<NNNAddrAggregator> m_addrs; ///< \brief 3N names seen in incoming Interests
 	Time m_arrivalTime;   ///< \brief arrival time of the incoming Interest
 
       public:
@@ -65,6 +110,13 @@ namespace ns3
 	 */
 	IncomingFace (Ptr<Face> face, Ptr<const NNNAddress> addr);
 
+	/**
+	 * @brief Copy constructor
+	 */
+	IncomingFace (const IncomingFace &other);
+
+	~IncomingFace ();
+
 	/**
 	 * \brief Add the 3N name to the associated face
 	 * \param addr 3N name we will aggregate
@@ -73,14 +125,49 @@ namespace ns3
 	AddDestination (Ptr<const NNNAddress> addr);
 
 	/**
-	 * \brief Add the 3N name to the associated face
-	 * \param addr 3N name we will aggregate
+	 * \brief Remove the 3N name from the associated face
+	 * \param addr 3N name to remove
 	 */
 	void
 	RemoveDestination (Ptr<const NNNAddress> addr);
 
 	bool
-	NoAddresses ();
+	NoAddresses () const;
+
+	/**
+	 * \brief Number of distinct 3N names aggregated on the face
+	 */
+	uint32_t
+	GetNumDestinations () const;
+
+	/**
+	 * \brief Call visitor (dst) for every 3N name aggregated on the face
+	 *
+	 * The names of the same sector are visited together. The first two
+	 * tiers hand out the names they hold, the NNNAddrAggregator tier
+	 * refills a single 3N name, so the visitor should copy dst if it
+	 * needs it after the call
+	 */
+	template<class Visitor>
+	void
+	VisitDestinations (Visitor &visitor) const
+	{
+	  if (m_addrs != 0)
+	    {
+	      CompleteNameVisitor<Visitor> complete (visitor);
+	      m_addrs->VisitDestinations (complete);
+	    }
+	  else if (m_flat != 0)
+	    {
+	      for (flat_set::const_iterator it = m_flat->begin (); it != m_flat->end (); ++it)
+		visitor (*it);
+	    }
+	  else
+	    {
+	      for (uint32_t i = 0; i < m_size; i++)
+		visitor (m_inline[i]);
+	    }
+	}
 
 	/**
 	 * @brief Copy operator
@@ -103,6 +190,26 @@ namespace ns3
 	 */
 	bool
 	operator< (const IncomingFace &m) const { return *m_face < *(m.m_face); } // return identity of the face
+
+      private:
+	typedef std::vector<Ptr<const NNNAddress> > flat_set;
+
+	void
+	ToFlat ();
+
+	void
+	ToAggregator ();
+
+	void
+	Shrink ();
+
+	void
+	Clear ();
+
+	Ptr<const NNNAddress> m_inline[InlineSize]; ///< \brief Sorted 3N names while there are at most InlineSize
+	flat_set *m_flat;                           ///< \brief Sorted 3N names while there are at most FlatSize
+	Ptr<NNNAddrAggregator> m_addrs;             ///< \brief 3N names once there are more than FlatSize
+	uint32_t m_size;                            ///< \brief Number of 3N names in whichever tier is used
       };
     } // namespace pit
   } // namespace nnn
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pit-entry-nonce-set.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pit-entry-nonce-set.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pit-entry-nonce-set.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+
+#include "nnn-pit-entry-nonce-set.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace pit
+    {
+      NonceSet::NonceSet ()
+      : m_size     (0)
+      , m_capacity (0)
+      , m_table    (0)
+      , m_zero     (false)
+      {
+      }
+
+      NonceSet::NonceSet (const NonceSet &other)
+      : m_size     (0)
+      , m_capacity (0)
+      , m_table    (0)
+      , m_zero     (false)
+      {
+	*this = other;
+      }
+
+      NonceSet &
+      NonceSet::operator= (const NonceSet &other)
+      {
+	if (this == &other)
+	  return *this;
+
+	delete [] m_table;
+	m_table = 0;
+
+	if (other.m_table != 0)
+	  {
+	    m_table = new uint32_t[other.m_capacity];
+	    std::copy (other.m_table, other.m_table + other.m_capacity, m_table);
+	  }
+	else
+	  std::copy (other.m_inline, other.m_inline + other.m_size, m_inline);
+
+	m_size = other.m_size;
+	m_capacity = other.m_capacity;
+	m_zero = other.m_zero;
+	return *this;
+      }
+
+      NonceSet::~NonceSet ()
+      {
+	delete [] m_table;
+      }
+
+      bool
+      NonceSet::Find (uint32_t nonce) const
+      {
+	if (m_table == 0)
+	  return std::find (m_inline, m_inline + m_size, nonce) != m_inline + m_size;
+
+	if (nonce == 0)
+	  return m_zero;
+
+	for (uint32_t i = Slot (nonce, m_capacity); m_table[i] != 0; i = (i + 1) & (m_capacity - 1))
+	  {
+	    if (m_table[i] == nonce)
+	      return true;
+	  }
+	return false;
+      }
+
+      bool
+      NonceSet::Insert (uint32_t nonce)
+      {
+	if (Find (nonce))
+	  return false;
+
+	if (m_table == 0)
+	  {
+	    if (m_size < InlineSize)
+	      {
+		m_inline[m_size++] = nonce;
+		return true;
+	      }
+
+	    Grow (FirstTableSize);
+	  }
+	else if (2 * (m_size + 1) > m_capacity)
+	  Grow (2 * m_capacity);
+
+	if (nonce == 0)
+	  m_zero = true;
+	else
+	  TableInsert (nonce);
+
+	m_size++;
+	return true;
+      }
+
+      void
+      NonceSet::Get (std::vector<uint32_t> &nonces) const
+      {
+	nonces.clear ();
+
+	if (m_table == 0)
+	  nonces.insert (nonces.end (), m_inline, m_inline + m_size);
+	else
+	  {
+	    if (m_zero)
+	      nonces.push_back (0);
+
+	    for (uint32_t i = 0; i < m_capacity; i++)
+	      {
+		if (m_table[i] != 0)
+		  nonces.push_back (m_table[i]);
+	      }
+	  }
+
+	std::sort (nonces.begin (), nonces.end ());
+      }
+
+      void
+      NonceSet::TableInsert (uint32_t nonce)
+      {
+	uint32_t i = Slot (nonce, m_capacity);
+	while (m_table[i] != 0)
+	  i = (i + 1) & (m_capacity - 1);
+	m_table[i] = nonce;
+      }
+
+      void
+      NonceSet::Grow (uint32_t capacity)
+      {
+	uint32_t *old = m_table;
+	uint32_t oldCapacity = m_capacity;
+
+	m_table = new uint32_t[capacity] ();
+	m_capacity = capacity;
+
+	if (old == 0)
+	  {
+	    // Coming from the inline array
+	    for (uint32_t i = 0; i < m_size; i++)
+	      {
+		if (m_inline[i] == 0)
+		  m_zero = true;
+		else
+		  TableInsert (m_inline[i]);
+	      }
+	    return;
+	  }
+
+	for (uint32_t i = 0; i < oldCapacity; i++)
+	  {
+	    if (old[i] != 0)
+	      TableInsert (old[i]);
+	  }
+	delete [] old;
+      }
+    } // namespace pit
+  } // namespace nnn
+} // namespace ns3
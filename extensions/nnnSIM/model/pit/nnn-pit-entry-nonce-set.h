@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pit-entry-nonce-set.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pit-entry-nonce-set.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pit-entry-nonce-set.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_PIT_ENTRY_NONCE_SET_H_
+#define _NNN_PIT_ENTRY_NONCE_SET_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace pit
+    {
+      /**
+       * @ingroup nnn-pit
+       * @brief Nonces seen for a PIT entry
+       *
+       * Most PIT entries only see the nonces of a few Interests, so the
+       * first InlineSize nonces are kept inside the object itself and
+       * searched linearly. Only entries that keep getting retransmissions
+       * move their nonces to an open addressing table (linear probing,
+       * at most half full). Nonces are never removed.
+       */
+      class NonceSet
+      {
+      public:
+	static const uint32_t InlineSize = 4;
+	static const uint32_t FirstTableSize = 16;
+
+	NonceSet ();
+
+	NonceSet (const NonceSet &other);
+
+	NonceSet &
+	operator= (const NonceSet &other);
+
+	~NonceSet ();
+
+	uint32_t
+	size () const
+	{
+	  return m_size;
+	}
+
+	bool
+	empty () const
+	{
+	  return m_size == 0;
+	}
+
+	/**
+	 * @brief Check if nonce is in the set
+	 */
+	bool
+	Find (uint32_t nonce) const;
+
+	/**
+	 * @brief Add nonce to the set
+	 * @returns false if nonce was already there
+	 */
+	bool
+	Insert (uint32_t nonce);
+
+	/**
+	 * @brief Fill nonces with the content of the set, in increasing order
+	 */
+	void
+	Get (std::vector<uint32_t> &nonces) const;
+
+      private:
+	static uint32_t
+	Slot (uint32_t nonce, uint32_t capacity)
+	{
+	  uint32_t h = nonce * 2654435761u;
+	  return (h ^ (h >> 16)) & (capacity - 1);
+	}
+
+	/**
+	 * @brief Put a nonce known not to be there in m_table, 0 excluded
+	 */
+	void
+	TableInsert (uint32_t nonce);
+
+	void
+	Grow (uint32_t capacity);
+
+	uint32_t m_inline[InlineSize]; ///< \brief Nonces while there are at most InlineSize
+	uint32_t m_size;               ///< \brief Number of nonces in the set
+	uint32_t m_capacity;           ///< \brief Number of slots in m_table (power of 2)
+	uint32_t *m_table;             ///< \brief Nonces once there are more than InlineSize, 0 is an empty slot
+	bool m_zero;                   ///< \brief Nonce 0 is in the set (only used with m_table)
+      };
+    } // namespace pit
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* _NNN_PIT_ENTRY_NONCE_SET_H_ */
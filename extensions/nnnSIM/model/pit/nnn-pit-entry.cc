@@ -35,6 +35,8 @@
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 #include <boost/foreach.hpp>
+
+#include <vector>
 namespace ll = boost::lambda;
 
 NS_LOG_COMPONENT_DEFINE ("nnn.pit.Entry");
@@ -52,6 +54,7 @@ namespace ns3
       , m_interest (header)
       , m_fibEntry (fibEntry)
       , m_maxRetxCount (0)
+      , m_names (0)
       {
 	NS_LOG_FUNCTION (this);
 
@@ -65,6 +68,8 @@ namespace ns3
       Entry::~Entry ()
       {
 	NS_LOG_FUNCTION (GetPrefix ());
+
+	m_container.UpdateSize (0, -static_cast<int32_t> (m_names));
       }
 
       void
@@ -107,13 +112,13 @@ namespace ns3
       bool
       Entry::IsNonceSeen (uint32_t nonce) const
       {
-	return m_seenNonces.find (nonce) != m_seenNonces.end ();
+	return m_seenNonces.Find (nonce);
       }
 
       void
       Entry::AddSeenNonce (uint32_t nonce)
       {
-	m_seenNonces.insert (nonce);
+	m_seenNonces.Insert (nonce);
       }
 
       Entry::in_iterator
@@ -134,8 +139,12 @@ namespace ns3
 
 	if (!ret.second)
 	  { // Incoming face already exists
+	    uint32_t before = ret.first->GetNumDestinations ();
 	    const_cast<IncomingFace&>(*ret.first).AddDestination(addr);
+	    UpdateNames (ret.first->GetNumDestinations () - before);
 	  }
+	else
+	  UpdateNames (ret.first->GetNumDestinations ());
 
 	return ret.first;
       }
@@ -147,7 +156,7 @@ namespace ns3
 
 	if (it != m_incoming.end())
 	  {
-	    if (const_cast<IncomingFace&>(*it).NoAddresses())
+	    if (it->NoAddresses())
 	      m_incoming.erase(face);
 	  }
       }
@@ -159,9 +168,11 @@ namespace ns3
 
 	if (it != m_incoming.end())
 	  {
-	    IncomingFace inface = const_cast<IncomingFace&>(*it);
+	    IncomingFace &inface = const_cast<IncomingFace&>(*it);
 
+	    uint32_t before = inface.GetNumDestinations ();
 	    inface.RemoveDestination(addr);
+	    UpdateNames (inface.GetNumDestinations () - before);
 
 	    if (inface.NoAddresses())
 	      m_incoming.erase(face);
@@ -172,6 +183,7 @@ namespace ns3
       Entry::ClearIncoming ()
       {
 	m_incoming.clear ();
+	UpdateNames (-static_cast<int32_t> (m_names));
       }
 
       Entry::out_iterator
@@ -202,7 +214,10 @@ namespace ns3
 	in_iterator incoming = m_incoming.find (face);
 
 	if (incoming != m_incoming.end ())
-	  m_incoming.erase (incoming);
+	  {
+	    UpdateNames (-static_cast<int32_t> (incoming->GetNumDestinations ()));
+	    m_incoming.erase (incoming);
+	  }
 
 	out_iterator outgoing =
 	    m_outgoing.find (face);
@@ -211,6 +226,13 @@ namespace ns3
 	  m_outgoing.erase (outgoing);
       }
 
+      void
+      Entry::UpdateNames (int32_t names)
+      {
+	m_names += names;
+	m_container.UpdateSize (0, names);
+      }
+
       // void
       // Entry::SetWaitingInVain (Entry::out_iterator face)
       // {
@@ -335,7 +357,9 @@ namespace ns3
 	}
 	os << "\nNonces: ";
 	first = true;
-	BOOST_FOREACH (uint32_t nonce, entry.m_seenNonces)
+	std::vector<uint32_t> nonces;
+	entry.m_seenNonces.Get (nonces);
+	BOOST_FOREACH (uint32_t nonce, nonces)
 	{
 	  if (!first)
 	    os << ",";
@@ -27,6 +27,7 @@
 
 #include "../fib/nnn-fib.h"
 #include "nnn-pit-entry-incoming-face.h"
+#include "nnn-pit-entry-nonce-set.h"
 #include "nnn-pit-entry-outgoing-face.h"
 
 #include <boost/multi_index_container.hpp>
@@ -35,6 +36,7 @@
 
 #include <boost/multi_index/member.hpp>
 #include <set>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 namespace ns3
@@ -65,7 +67,7 @@ namespace ns3
 	typedef std::set< OutgoingFace > out_container; ///< @brief outgoing faces container type
 	typedef out_container::iterator out_iterator;              ///< @brief iterator to outgoing faces
 
-	typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
+	typedef NonceSet nonce_container;  ///< @brief nonce container type
 
 	/**
 	 * \brief PIT entry constructor
@@ -292,6 +294,15 @@ namespace ns3
 	uint32_t m_maxRetxCount;   ///< @brief Maximum allowed number of retransmissions via outgoing faces
 
 	std::list< boost::shared_ptr<fw::Tag> > m_fwTags; ///< @brief Forwarding strategy tags
+
+      private:
+	/**
+	 * @brief Keep m_names and the accounting of the container up to date
+	 */
+	void
+	UpdateNames (int32_t names);
+
+	uint32_t m_names; ///< @brief Number of 3N names on all the incoming faces
       };
 
       /// @cond include_hidden
@@ -303,6 +314,25 @@ namespace ns3
 	  return !entry->GetIncoming ().empty ();
 	}
       };
+
+      /**
+       * Collects the non empty entries on the way of a trie find_if, from the
+       * shortest prefix to the longest. Never lets find_if stop on a node.
+       */
+      struct CollectNotEmpty
+      {
+	CollectNotEmpty (std::vector<Ptr<Entry> > &entries) : m_entries (entries) {}
+
+	bool
+	operator () (Ptr<Entry> entry)
+	{
+	  if (EntryIsNotEmpty () (entry))
+	    m_entries.push_back (entry);
+	  return false;
+	}
+
+	std::vector<Ptr<Entry> > &m_entries;
+      };
       /// @endcond
 
       std::ostream& operator<< (std::ostream& os, const Entry &entry);
@@ -22,6 +22,11 @@
 #ifndef _NNN_PIT_IMPL_H_
 #define	_NNN_PIT_IMPL_H_
 
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
 #include <ns3-dev/ns3/log.h>
 #include <ns3-dev/ns3/simulator.h>
 
@@ -85,6 +90,9 @@ namespace ns3
 	virtual Ptr<Entry>
 	Lookup (const ndn::Data &header);
 
+	virtual void
+	LookupAll (const ndn::Data &header, std::vector<Ptr<Entry> > &entries);
+
 	virtual Ptr<Entry>
 	Lookup (const ndn::Interest &header);
 
@@ -97,6 +105,9 @@ namespace ns3
 	virtual void
 	MarkErased (Ptr<Entry> entry);
 
+	virtual void
+	RemoveFromAll (Ptr<Face> face);
+
 	virtual void
 	Print (std::ostream &os) const;
 
@@ -136,6 +147,10 @@ namespace ns3
 	uint32_t
 	GetCurrentSize () const;
 
+	/// Bring the Entries trace source to the number of entries in the PIT
+	void
+	UpdateEntries ();
+
       private:
 	EventId m_cleanEvent;
 	Ptr<Fib> m_fib; ///< \brief Link to FIB table
@@ -153,6 +168,16 @@ namespace ns3
 	> time_index;
 	time_index i_time;
 
+	// Reverse indexes, so removing a Face only visits the affected entries
+	typedef std::map<uint32_t, std::set<entry*> > face_index;
+	typedef std::map<fib::Entry*, std::set<entry*> > fib_index;
+	face_index i_face; ///< @brief Entries with an incoming or outgoing record on a Face, by Face id
+	fib_index i_fib;   ///< @brief Entries using a FIB entry
+
+	template<class Index, class Key>
+	static void
+	EraseFromIndex (Index &index, const Key &key, entry *item);
+
 	friend class EntryImpl< PitImpl >;
       };
 
@@ -193,6 +218,15 @@ namespace ns3
 	return super::getPolicy ().size ();
       }
 
+      template<class Policy>
+      void
+      PitImpl<Policy>::UpdateEntries ()
+      {
+	int32_t entries = static_cast<int32_t> (super::getPolicy ().size ()) - static_cast<int32_t> (this->m_entries.Get ());
+	if (entries != 0)
+	  UpdateSize (entries, 0);
+      }
+
       template<class Policy>
       PitImpl<Policy>::PitImpl ()
       {
@@ -238,6 +272,7 @@ namespace ns3
       PitImpl<Policy>::DoDispose ()
       {
 	super::clear ();
+	UpdateEntries ();
 
 	m_forwardingStrategy = 0;
 	m_fib = 0;
@@ -288,6 +323,7 @@ namespace ns3
 	    else
 	      break; // nothing else to do. All later records will not be stale
 	  }
+	UpdateEntries ();
 
 	if (super::getPolicy ().size ())
 	  {
@@ -310,6 +346,27 @@ namespace ns3
 	  return item->payload (); // which could also be 0
       }
 
+      template<class Policy>
+      void
+      PitImpl<Policy>::LookupAll (const ndn::Data &header, std::vector<Ptr<Entry> > &entries)
+      {
+	entries.clear ();
+
+	// The root is not checked by find_if
+	if (super::getTrie ().payload () != 0 && EntryIsNotEmpty () (super::getTrie ().payload ()))
+	  entries.push_back (super::getTrie ().payload ());
+
+	super::getTrie ().find_if (header.GetName (), CollectNotEmpty (entries));
+
+	// Longest prefix first, as successive calls to Lookup would give them
+	std::reverse (entries.begin (), entries.end ());
+
+	for (typename std::vector<Ptr<Entry> >::iterator it = entries.begin (); it != entries.end (); ++it)
+	  {
+	    super::getPolicy ().lookup (StaticCast<entry> (*it)->to_iterator ());
+	  }
+      }
+
       template<class Policy>
       Ptr<Entry>
       PitImpl<Policy>::Lookup (const ndn::Interest &header)
@@ -356,6 +413,8 @@ namespace ns3
 
 	Ptr< entry > newEntry = ns3::Create< entry > (boost::ref (*this), header, fibEntry);
 	std::pair< typename super::iterator, bool > result = super::insert (header->GetName (), newEntry);
+	// The policy may have evicted entries to make room
+	UpdateEntries ();
 	if (result.first != super::end ())
 	  {
 	    if (result.second)
@@ -382,6 +441,7 @@ namespace ns3
 	if (this->m_PitEntryPruningTimout.IsZero ())
 	  {
 	    super::erase (StaticCast< entry > (item)->to_iterator ());
+	    UpdateEntries ();
 	  }
 	else
 	  {
@@ -390,6 +450,53 @@ namespace ns3
       }
 
 
+      template<class Policy>
+      void
+      PitImpl<Policy>::RemoveFromAll (Ptr<Face> face)
+      {
+	NS_LOG_FUNCTION (this << face->GetId ());
+
+	typename face_index::iterator idx = i_face.find (face->GetId ());
+	if (idx != i_face.end ())
+	  {
+	    // Removing the references changes the index, work on a copy
+	    std::vector<entry*> referencing (idx->second.begin (), idx->second.end ());
+	    for (typename std::vector<entry*>::iterator it = referencing.begin (); it != referencing.end (); ++it)
+	      (*it)->RemoveAllReferencesToFace (face);
+	  }
+
+	// If this face is the only for the associated FIB entry, then FIB entry will be removed soon.
+	// Thus, we have to remove the whole PIT entry
+	std::vector< Ptr<Entry> > entriesToRemove;
+	for (typename fib_index::iterator it = i_fib.begin (); it != i_fib.end (); ++it)
+	  {
+	    if (it->first->m_faces.size () == 1 &&
+		it->first->m_faces.begin ()->GetFace () == face)
+	      {
+		entriesToRemove.insert (entriesToRemove.end (), it->second.begin (), it->second.end ());
+	      }
+	  }
+
+	for (typename std::vector< Ptr<Entry> >::iterator it = entriesToRemove.begin (); it != entriesToRemove.end (); ++it)
+	  {
+	    MarkErased (*it);
+	  }
+      }
+
+      template<class Policy>
+      template<class Index, class Key>
+      void
+      PitImpl<Policy>::EraseFromIndex (Index &index, const Key &key, entry *item)
+      {
+	typename Index::iterator it = index.find (key);
+	if (it == index.end ())
+	  return;
+
+	it->second.erase (item);
+	if (it->second.empty ())
+	  index.erase (it);
+      }
+
       template<class Policy>
       void
       PitImpl<Policy>::Print (std::ostream& os) const
@@ -24,6 +24,7 @@
 #include <ns3-dev/ns3/uinteger.h>
 #include <ns3-dev/ns3/simulator.h>
 #include <ns3-dev/ns3/packet.h>
+#include <ns3-dev/ns3/trace-source-accessor.h>
 
 #include <ns3-dev/ns3/ndn-name.h>
 #include <ns3-dev/ns3/ndn-interest.h>
@@ -61,16 +62,75 @@ namespace ns3
 	                   TimeValue (), // by default, PIT entries are kept for the time, specified by the InterestLifetime
 	                   MakeTimeAccessor (&Pit::GetMaxPitEntryLifetime, &Pit::SetMaxPitEntryLifetime),
 	                   MakeTimeChecker ())
+
+	    .AddTraceSource ("Entries", "Number of PIT entries",
+	                     MakeTraceSourceAccessor (&Pit::m_entries))
+	    .AddTraceSource ("Bytes", "Approximate memory held by the PIT entries",
+	                     MakeTraceSourceAccessor (&Pit::m_bytes))
+	    .AddTraceSource ("AggregatedNames", "Number of 3N names aggregated on the incoming faces",
+	                     MakeTraceSourceAccessor (&Pit::m_aggregated))
+	    .AddTraceSource ("AggregatedBytes", "Approximate memory held by the aggregated 3N names",
+	                     MakeTraceSourceAccessor (&Pit::m_aggregatedBytes))
 	;
       return tid;
     }
 
     Pit::Pit ()
+    : m_entries (0)
+    , m_bytes (0)
+    , m_aggregated (0)
+    , m_aggregatedBytes (0)
     {
     }
 
     Pit::~Pit ()
     {
     }
+
+    void
+    Pit::UpdateSize (int32_t entries, int32_t names)
+    {
+      // An entry with one incoming and one outgoing face. 3N names are
+      // counted as if they were all in an NNNAddrAggregator, the small
+      // tiers of pit::IncomingFace only hold a pointer to them
+      static const uint64_t entryBytes = sizeof (pit::Entry) + sizeof (pit::IncomingFace) + sizeof (pit::OutgoingFace);
+      static const uint64_t nameBytes = sizeof (NNNAddrAggregator::super::parent_trie) + sizeof (NNNAddrEntry) + sizeof (NNNAddress);
+
+      if (entries != 0)
+	{
+	  m_entries = m_entries + entries;
+	  m_bytes = m_entries * entryBytes;
+	}
+
+      if (names != 0)
+	{
+	  m_aggregated = m_aggregated + names;
+	  m_aggregatedBytes = m_aggregated * nameBytes;
+	}
+    }
+
+    uint32_t
+    Pit::GetEntries () const
+    {
+      return m_entries;
+    }
+
+    uint64_t
+    Pit::GetBytes () const
+    {
+      return m_bytes;
+    }
+
+    uint32_t
+    Pit::GetAggregatedNames () const
+    {
+      return m_aggregated;
+    }
+
+    uint64_t
+    Pit::GetAggregatedBytes () const
+    {
+      return m_aggregatedBytes;
+    }
   } // namespace nnn
 } // namespace ns3
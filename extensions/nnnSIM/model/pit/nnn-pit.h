@@ -22,9 +22,12 @@
 #ifndef _NNN_PIT_H_
 #define	_NNN_PIT_H_
 
+#include <vector>
+
 #include <ns3-dev/ns3/event-id.h>
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/object.h>
+#include <ns3-dev/ns3/traced-value.h>
 
 #include "nnn-pit-entry.h"
 
@@ -96,6 +99,19 @@ namespace ns3
       virtual Ptr<pit::Entry>
       Lookup (const ndn::Data &header) = 0;
 
+      /**
+       * \brief Find all the PIT entries the given content name satisfies
+       *
+       * Gives the same entries, in the same order (longest prefix first), as
+       * calling Lookup (const ndn::Data &) until it returns 0 and satisfying
+       * each entry in between, but walks the PIT only once
+       *
+       * \param header Data for which to lookup the entries
+       * \param entries filled with the PIT entries, empty if none was found
+       */
+      virtual void
+      LookupAll (const ndn::Data &header, std::vector<Ptr<pit::Entry> > &entries) = 0;
+
       /**
        * \brief Find a PIT entry for the given content interest
        * \param header parsed interest header
@@ -135,6 +151,16 @@ namespace ns3
       virtual void
       MarkErased (Ptr<pit::Entry> entry) = 0;
 
+      /**
+       * @brief Remove all references to the face from the PIT
+       * @param face Face that is being removed from the stack
+       *
+       * Entries whose FIB entry only has this face are marked erased, as
+       * the FIB entry will be removed soon
+       */
+      virtual void
+      RemoveFromAll (Ptr<Face> face) = 0;
+
       /**
        * @brief Print out PIT contents for debugging purposes
        *
@@ -189,11 +215,53 @@ namespace ns3
       inline void
       SetMaxPitEntryLifetime (const Time &maxLifetime);
 
+      /**
+       * @brief Account for PIT entries and for the 3N names aggregated on
+       * their incoming faces
+       *
+       * Called by the implementation as entries are inserted in or erased
+       * from the PIT (entries), and by pit::Entry as its incoming faces gain
+       * or lose 3N names (names), so the trace sources never walk the PIT.
+       * An entry still referenced after leaving the PIT is no longer one of
+       * its entries, but its 3N names are counted until it is destroyed
+       */
+      void
+      UpdateSize (int32_t entries, int32_t names);
+
+      /**
+       * @brief Current value of the Entries trace source
+       */
+      uint32_t
+      GetEntries () const;
+
+      /**
+       * @brief Current value of the Bytes trace source
+       */
+      uint64_t
+      GetBytes () const;
+
+      /**
+       * @brief Current value of the AggregatedNames trace source
+       */
+      uint32_t
+      GetAggregatedNames () const;
+
+      /**
+       * @brief Current value of the AggregatedBytes trace source
+       */
+      uint64_t
+      GetAggregatedBytes () const;
+
     protected:
       // configuration variables. Check implementation of GetTypeId for more details
       Time m_PitEntryPruningTimout;
 
       Time m_maxPitEntryLifetime;
+
+      TracedValue<uint32_t> m_entries;         ///< @brief Number of PIT entries
+      TracedValue<uint64_t> m_bytes;           ///< @brief Approximate memory held by the PIT entries
+      TracedValue<uint32_t> m_aggregated;      ///< @brief Number of 3N names aggregated on the incoming faces
+      TracedValue<uint64_t> m_aggregatedBytes; ///< @brief Approximate memory held by the aggregated 3N names
     };
 
     ///////////////////////////////////////////////////////////////////////////////
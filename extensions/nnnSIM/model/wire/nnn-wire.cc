@@ -57,7 +57,7 @@ Wire::FromNULLp (Ptr<const NULLp> n_o, int8_t wireFormat)
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::NULLp::ToWire (n_o);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::NULLp::ToWire (n_o), n_o);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -111,7 +111,7 @@ Wire::FromSO (Ptr<const SO> so_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::SO::ToWire (so_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::SO::ToWire (so_p), so_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -165,7 +165,7 @@ Wire::FromDO (Ptr<const DO> do_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::DO::ToWire (do_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::DO::ToWire (do_p), do_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -219,7 +219,7 @@ Wire::FromEN (Ptr<const EN> en_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::EN::ToWire (en_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::EN::ToWire (en_p), en_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -273,7 +273,7 @@ Wire::FromAEN (Ptr<const AEN> aen_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::AEN::ToWire (aen_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::AEN::ToWire (aen_p), aen_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -327,7 +327,7 @@ Wire::FromREN (Ptr<const REN> ren_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::REN::ToWire (ren_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::REN::ToWire (ren_p), ren_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -381,7 +381,7 @@ Wire::FromDEN (Ptr<const DEN> ren_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::DEN::ToWire (ren_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::DEN::ToWire (ren_p), ren_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -435,7 +435,7 @@ Wire::FromINF (Ptr<const INF> inf_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::INF::ToWire (inf_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::INF::ToWire (inf_p), inf_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -489,7 +489,7 @@ Wire::FromDU (Ptr<const DU> du_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/)
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::DU::ToWire (du_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::DU::ToWire (du_p), du_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
@@ -543,7 +543,7 @@ Wire::FromOEN (Ptr<const OEN> oen_p, int8_t wireFormat/* = WIRE_FORMAT_DEFAULT*/
     wireFormat = GetWireFormat ();
 
   if (wireFormat == WIRE_FORMAT_NNNSIM)
-    return wire::nnnSIM::OEN::ToWire (oen_p);
+    return HeaderHelper::TagNNNHeader (wire::nnnSIM::OEN::ToWire (oen_p), oen_p);
   else
     {
       NS_FATAL_ERROR ("Unsupported format requested");
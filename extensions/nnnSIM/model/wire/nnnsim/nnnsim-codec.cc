@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnnsim-codec.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnnsim-codec.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnnsim-codec.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnnsim-codec.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace wire
+    {
+      namespace nnnSIM
+      {
+	NS_LOG_COMPONENT_DEFINE ("nnn.wire.nnnSIM");
+
+	template <class Schema>
+	Codec<Schema>::Codec ()
+	: CommonHeader<PDU> ()
+	, m_size (0)
+	{
+	}
+
+	template <class Schema>
+	Codec<Schema>::Codec (Ptr<PDU> pdu)
+	: CommonHeader<PDU> (pdu)
+	, m_size (0)
+	{
+	}
+
+	template <class Schema>
+	TypeId
+	Codec<Schema>::GetTypeId (void)
+	{
+	  static TypeId tid = TypeId (Schema::TypeName ())
+	      .SetGroupName ("Nnn")
+	      .SetParent<Header> ()
+	      .AddConstructor<Codec<Schema> > ()
+	      ;
+	  return tid;
+	}
+
+	template <class Schema>
+	TypeId
+	Codec<Schema>::GetInstanceTypeId (void) const
+	{
+	  return GetTypeId ();
+	}
+
+	template <class Schema>
+	Ptr<Packet>
+	Codec<Schema>::ToWire (Ptr<const PDU> pdu)
+	{
+	  Ptr<const Packet> p = pdu->GetWire ();
+	  if (!p)
+	    {
+	      Ptr<Packet> packet = Schema::Payload::Copy (pdu);
+	      Codec<Schema> wireEncoding (ConstCast<PDU> (pdu));
+	      packet->AddHeader (wireEncoding);
+	      pdu->SetWire (packet);
+
+	      p = packet;
+	    }
+	  return p->Copy ();
+	}
+
+	template <class Schema>
+	Ptr<typename Schema::PDU>
+	Codec<Schema>::FromWire (Ptr<Packet> packet)
+	{
+	  Ptr<PDU> pdu = Create<PDU> ();
+	  Ptr<Packet> wire = packet->Copy ();
+
+	  Codec<Schema> wireEncoding (pdu);
+	  packet->RemoveHeader (wireEncoding);
+
+	  Schema::Payload::Keep (pdu, packet);
+	  pdu->SetWire (wire);
+
+	  return pdu;
+	}
+
+	template <class Schema>
+	uint32_t
+	Codec<Schema>::GetSerializedSize (void) const
+	{
+	  if (m_size == 0)
+	    {
+	      schema::Context ctx (this->m_ptr->GetVersion ());
+	      m_size = this->CommonGetSerializedSize () + Schema::Body::Size (*this->m_ptr, ctx);
+	    }
+
+	  return m_size;
+	}
+
+	template <class Schema>
+	void
+	Codec<Schema>::Serialize (Buffer::Iterator start) const
+	{
+	  // Serialize the header
+	  this->CommonSerialize (start);
+
+	  // Remember that CommonSerialize doesn't write the Packet length
+	  // Move the iterator forward
+	  start.Next (this->CommonGetSerializedSize () - 2);
+
+	  NS_LOG_INFO ("Serialize -> " << Schema::TypeName () << " PktID = " << this->m_ptr->GetPacketId ()
+		       << " Version = " << this->m_ptr->GetVersion () << " Pkt Len = " << GetSerializedSize ());
+
+	  // Serialize the packet size
+	  start.WriteU16 (GetSerializedSize ());
+
+	  schema::Context ctx (this->m_ptr->GetVersion ());
+	  Schema::Body::Write (start, *this->m_ptr, ctx);
+	}
+
+	template <class Schema>
+	uint32_t
+	Codec<Schema>::Deserialize (Buffer::Iterator start)
+	{
+	  // Check packet ID
+	  Buffer::Iterator id = start;
+	  if (id.ReadU32 () != Schema::Id)
+	    throw new typename Schema::Exception ();
+
+	  Buffer::Iterator i = start;
+
+	  // Deserialize the header
+	  uint32_t skip = this->CommonDeserialize (i);
+
+	  NS_LOG_INFO ("Deserialize -> " << Schema::TypeName () << " PktID = " << this->m_ptr->GetPacketId ()
+		       << " Version = " << this->m_ptr->GetVersion () << " Pkt Len = " << this->m_packet_len);
+
+	  // Move the iterator forward
+	  i.Next (skip);
+
+	  // The version just read says how the fields are encoded, and the
+	  // packet length where the optional fields end
+	  schema::Context ctx (this->m_ptr->GetVersion (), i.GetRemainingSize () - (this->m_packet_len - skip));
+	  try
+	    {
+	      Schema::Body::Read (i, *this->m_ptr, ctx);
+	    }
+	  catch (schema::MalformedField)
+	    {
+	      throw new typename Schema::Exception ();
+	    }
+
+	  m_size = i.GetDistanceFrom (start);
+	  NS_ASSERT (this->m_packet_len == m_size);
+
+	  return m_size;
+	}
+
+	template class Codec<schema::NULLp>;
+	template class Codec<schema::SO>;
+	template class Codec<schema::DO>;
+	template class Codec<schema::DU>;
+	template class Codec<schema::EN>;
+	template class Codec<schema::AEN>;
+	template class Codec<schema::REN>;
+	template class Codec<schema::DEN>;
+	template class Codec<schema::OEN>;
+	template class Codec<schema::INF>;
+
+	NS_OBJECT_ENSURE_REGISTERED (NULLp);
+	NS_OBJECT_ENSURE_REGISTERED (SO);
+	NS_OBJECT_ENSURE_REGISTERED (DO);
+	NS_OBJECT_ENSURE_REGISTERED (DU);
+	NS_OBJECT_ENSURE_REGISTERED (EN);
+	NS_OBJECT_ENSURE_REGISTERED (AEN);
+	NS_OBJECT_ENSURE_REGISTERED (REN);
+	NS_OBJECT_ENSURE_REGISTERED (DEN);
+	NS_OBJECT_ENSURE_REGISTERED (OEN);
+	NS_OBJECT_ENSURE_REGISTERED (INF);
+      } /* namespace nnnSIM */
+    } /* namespace wire */
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnnsim-codec.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnnsim-codec.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnnsim-codec.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNNSIM_CODEC_H_
+#define NNNSIM_CODEC_H_
+
+#include "nnnsim-common-hdr.h"
+#include "nnnsim-common.h"
+#include "nnnsim-schema.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace wire
+    {
+      namespace nnnSIM
+      {
+	/**
+	 * \brief nnnSIM wire encoding of the PDU described by Schema
+	 *
+	 * The size of the header is computed once, the first time ns-3 asks
+	 * for it, and reused for the Packet Length field and the
+	 * serialization that follow.
+	 */
+	template <class Schema>
+	class Codec : public CommonHeader<typename Schema::PDU>
+	{
+	public:
+	  typedef typename Schema::PDU PDU;
+
+	  Codec ();
+
+	  Codec (Ptr<PDU> pdu);
+
+	  static Ptr<Packet>
+	  ToWire (Ptr<const PDU> pdu);
+
+	  static Ptr<PDU>
+	  FromWire (Ptr<Packet> packet);
+
+	  // from Header
+	  static TypeId GetTypeId (void);
+	  TypeId GetInstanceTypeId (void) const;
+	  uint32_t GetSerializedSize (void) const;
+	  void Serialize (Buffer::Iterator start) const;
+	  uint32_t Deserialize (Buffer::Iterator start);
+
+	private:
+	  mutable uint32_t m_size; ///< \brief Serialized size, 0 until computed
+	};
+
+	typedef Codec<schema::NULLp> NULLp;
+	typedef Codec<schema::SO> SO;
+	typedef Codec<schema::DO> DO;
+	typedef Codec<schema::DU> DU;
+	typedef Codec<schema::EN> EN;
+	typedef Codec<schema::AEN> AEN;
+	typedef Codec<schema::REN> REN;
+	typedef Codec<schema::DEN> DEN;
+	typedef Codec<schema::OEN> OEN;
+	typedef Codec<schema::INF> INF;
+      } /* namespace nnnSIM */
+    } /* namespace wire */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNNSIM_CODEC_H_ */
@@ -0,0 +1,533 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnnsim-schema.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnnsim-schema.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnnsim-schema.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NNNSIM_SCHEMA_H_
+#define NNNSIM_SCHEMA_H_
+
+#include <vector>
+
+#include <ns3-dev/ns3/address.h>
+#include <ns3-dev/ns3/nstime.h>
+
+#include "nnnsim-common.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace wire
+    {
+      namespace nnnSIM
+      {
+	/**
+	 * \brief Layout of the 3N PDUs in the nnnSIM wire format
+	 *
+	 * Every PDU is the common header (PacketId, TTL, Version and
+	 * Packet Length) followed by the fields listed in its entry below,
+	 * in order. Codec<> encodes, decodes and sizes a PDU from its entry
+	 * alone, so a new PDU type is one more entry here and one more
+	 * instantiation in nnnsim-codec.cc. PDUs of version B_NNN carry
+	 * their PoA lists and names in the compact encoding. Optional
+	 * fields go last, and are only on the wire when the PDU has them.
+	 */
+	namespace schema
+	{
+	  // Accessors, naming which member of the PDU a field holds
+
+	  struct PayloadType
+	  {
+	    template <class T> static uint16_t Get (const T &pdu) { return pdu.GetPDUPayloadType (); }
+	    template <class T> static void Set (T &pdu, uint16_t value) { pdu.SetPDUPayloadType (value); }
+	  };
+
+	  struct Name
+	  {
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetName (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetName (name); }
+	  };
+
+	  struct SrcName
+	  {
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetSrcName (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetSrcName (name); }
+	  };
+
+	  struct DstName
+	  {
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetDstName (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetDstName (name); }
+	  };
+
+	  struct OldName
+	  {
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetOldName (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetOldName (name); }
+	  };
+
+	  struct NewName
+	  {
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetNewName (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetNewName (name); }
+	  };
+
+	  struct NextSector
+	  {
+	    template <class T> static bool Has (const T &pdu) { return pdu.HasNextSector (); }
+	    template <class T> static const NNNAddress& Get (const T &pdu) { return pdu.GetNextSector (); }
+	    template <class T> static void Set (T &pdu, Ptr<NNNAddress> name) { pdu.SetNextSector (name); }
+	  };
+
+	  struct Leasetime
+	  {
+	    template <class T> static Time Get (const T &pdu) { return pdu.GetLeasetime (); }
+	    template <class T> static void Set (T &pdu, Time lease) { pdu.SetLeasetime (lease); }
+	  };
+
+	  struct RemainLease
+	  {
+	    template <class T> static Time Get (const T &pdu) { return pdu.GetRemainLease (); }
+	    template <class T> static void Set (T &pdu, Time lease) { pdu.SetRemainLease (lease); }
+	  };
+
+	  struct Poas
+	  {
+	    template <class T> static uint32_t Count (const T &pdu) { return pdu.GetNumPoa (); }
+	    template <class T> static Address Get (const T &pdu, uint32_t index) { return pdu.GetOnePoa (index); }
+	    template <class T> static void Add (T &pdu, const Address &poa) { pdu.AddPoa (poa); }
+	  };
+
+	  struct PersonalPoas
+	  {
+	    template <class T> static uint32_t Count (const T &pdu) { return pdu.GetPersonalNumPoa (); }
+	    template <class T> static Address Get (const T &pdu, uint32_t index) { return pdu.GetPersonalOnePoa (index); }
+	    template <class T> static void Add (T &pdu, const Address &poa) { pdu.AddPersonalPoa (poa); }
+	  };
+
+	  /// Thrown by a field that cannot be read, Codec<> turns it into the
+	  /// Exception of the PDU
+	  class MalformedField {};
+
+	  /// State shared by the fields of one PDU while it is sized, written or read
+	  struct Context
+	  {
+	    Context (uint16_t version, uint32_t after = 0)
+	    : compact (version == B_NNN)
+	    , after (after)
+	    {
+	    }
+
+	    bool compact;                    ///< PoA lists and names in compact encoding
+	    uint32_t after;                  ///< Bytes in the buffer after the PDU, when reading
+	    std::vector<NNNAddress> names;   ///< Names already in the PDU, for compact names
+	  };
+
+	  // Encodings of the fields
+
+	  /// 16 bit value
+	  template <class Access>
+	  struct U16Field
+	  {
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      return 2;
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      i.WriteU16 (Access::Get (pdu));
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      Access::Set (pdu, i.ReadU16 ());
+	    }
+	  };
+
+	  /// Time rounded to seconds, as a 64 bit value
+	  template <class Access>
+	  struct SecondsField
+	  {
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      return 8;
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      uint64_t lease = static_cast<uint64_t> (Access::Get (pdu).ToInteger (Time::S));
+
+	      NS_ASSERT_MSG (lease < 0x7fffffffffffffffLL,
+			     "Incorrect Lease time (should not be smaller than 0 and larger than UINT64_MAX");
+
+	      i.WriteU64 (lease);
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      Access::Set (pdu, Seconds (i.ReadU64 ()));
+	    }
+	  };
+
+	  /// 3N name, as written by NnnSim::SerializeName or SerializeCompactName
+	  template <class Access>
+	  struct NameField
+	  {
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		return NnnSim::SerializedSizeCompactName (Access::Get (pdu), ctx.names);
+
+	      return NnnSim::SerializedSizeName (Access::Get (pdu));
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		NnnSim::SerializeCompactName (i, Access::Get (pdu), ctx.names);
+	      else
+		NnnSim::SerializeName (i, Access::Get (pdu));
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		Access::Set (pdu, NnnSim::DeserializeCompactName (i, ctx.names));
+	      else
+		Access::Set (pdu, NnnSim::DeserializeName (i));
+	    }
+	  };
+
+	  /// Number of PoAs, then every PoA as type, length and bytes, or as
+	  /// written by NnnSim::SerializeCompactPoas
+	  template <class Access>
+	  struct PoAListField
+	  {
+	    template <class T>
+	    static std::vector<Address>
+	    GetAll (const T &pdu)
+	    {
+	      std::vector<Address> poas;
+	      uint32_t total = Access::Count (pdu);
+	      for (uint32_t k = 0; k < total; k++)
+		poas.push_back (Access::Get (pdu, k));
+	      return poas;
+	    }
+
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		return NnnSim::SerializedSizeCompactPoas (GetAll (pdu));
+
+	      uint32_t size = 2;
+	      uint32_t total = Access::Count (pdu);
+	      for (uint32_t k = 0; k < total; k++)
+		size += Access::Get (pdu, k).GetSerializedSize ();
+	      return size;
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		{
+		  NnnSim::SerializeCompactPoas (i, GetAll (pdu));
+		  return;
+		}
+
+	      uint32_t total = Access::Count (pdu);
+	      i.WriteU16 (total);
+
+	      uint8_t buffer[Address::MAX_SIZE + 2];
+	      for (uint32_t k = 0; k < total; k++)
+		{
+		  // CopyAllTo gives the type, the length and the bytes
+		  uint32_t size = Access::Get (pdu, k).CopyAllTo (buffer, sizeof (buffer));
+		  i.Write (buffer, size);
+		}
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      if (ctx.compact)
+		{
+		  std::vector<Address> poas = NnnSim::DeserializeCompactPoas (i);
+		  for (size_t k = 0; k < poas.size (); k++)
+		    Access::Add (pdu, poas[k]);
+		  return;
+		}
+
+	      uint16_t total = i.ReadU16 ();
+
+	      uint8_t buffer[Address::MAX_SIZE];
+	      for (uint16_t k = 0; k < total; k++)
+		{
+		  uint8_t type = i.ReadU8 ();
+		  uint8_t length = i.ReadU8 ();
+
+		  // PoA longer than an Address can hold
+		  if (length > Address::MAX_SIZE)
+		    throw MalformedField ();
+
+		  i.Read (buffer, length);
+		  Access::Add (pdu, Address (type, buffer, length));
+		}
+	    }
+	  };
+
+	  /// Field only written when the PDU has it, and only read when the PDU
+	  /// has bytes left. Goes after all the other fields
+	  template <class Field, class Access>
+	  struct OptionalField
+	  {
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      return Access::Has (pdu) ? Field::Size (pdu, ctx) : 0;
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      if (Access::Has (pdu))
+		Field::Write (i, pdu, ctx);
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      if (i.GetRemainingSize () > ctx.after)
+		Field::Read (i, pdu, ctx);
+	    }
+	  };
+
+	  /// No more fields
+	  struct End
+	  {
+	    template <class T> static uint32_t Size (const T &pdu, Context &ctx) { return 0; }
+	    template <class T> static void Write (Buffer::Iterator &i, const T &pdu, Context &ctx) { }
+	    template <class T> static void Read (Buffer::Iterator &i, T &pdu, Context &ctx) { }
+	  };
+
+	  /// Fields of a PDU after the common header, in wire order
+	  template <class F1, class F2 = End, class F3 = End, class F4 = End, class F5 = End>
+	  struct Fields
+	  {
+	    template <class T>
+	    static uint32_t
+	    Size (const T &pdu, Context &ctx)
+	    {
+	      return F1::Size (pdu, ctx) + F2::Size (pdu, ctx) + F3::Size (pdu, ctx) + F4::Size (pdu, ctx) + F5::Size (pdu, ctx);
+	    }
+
+	    template <class T>
+	    static void
+	    Write (Buffer::Iterator &i, const T &pdu, Context &ctx)
+	    {
+	      F1::Write (i, pdu, ctx);
+	      F2::Write (i, pdu, ctx);
+	      F3::Write (i, pdu, ctx);
+	      F4::Write (i, pdu, ctx);
+	      F5::Write (i, pdu, ctx);
+	    }
+
+	    template <class T>
+	    static void
+	    Read (Buffer::Iterator &i, T &pdu, Context &ctx)
+	    {
+	      F1::Read (i, pdu, ctx);
+	      F2::Read (i, pdu, ctx);
+	      F3::Read (i, pdu, ctx);
+	      F4::Read (i, pdu, ctx);
+	      F5::Read (i, pdu, ctx);
+	    }
+	  };
+
+	  // What follows the header in the packet
+
+	  /// Data PDUs carry their payload after the header
+	  struct DataPayload
+	  {
+	    template <class T>
+	    static Ptr<Packet>
+	    Copy (Ptr<const T> pdu)
+	    {
+	      return Create<Packet> (*pdu->GetPayload ());
+	    }
+
+	    template <class T>
+	    static void
+	    Keep (Ptr<T> pdu, Ptr<Packet> rest)
+	    {
+	      pdu->SetPayload (rest);
+	    }
+	  };
+
+	  /// Mechanism PDUs have no payload
+	  struct NoPayload
+	  {
+	    template <class T>
+	    static Ptr<Packet>
+	    Copy (Ptr<const T> pdu)
+	    {
+	      return Create<Packet> ();
+	    }
+
+	    template <class T>
+	    static void
+	    Keep (Ptr<T> pdu, Ptr<Packet> rest)
+	    {
+	    }
+	  };
+
+	  // The PDUs
+
+	  struct NULLp
+	  {
+	    typedef nnn::NULLp PDU;
+	    typedef NULLpException Exception;
+	    typedef DataPayload Payload;
+	    typedef Fields<U16Field<PayloadType> > Body;
+	    static const uint32_t Id = NULL_NNN;
+	    static const char *TypeName () { return "ns3::nnn::NULLp::nnnSIM"; }
+	  };
+
+	  struct SO
+	  {
+	    typedef nnn::SO PDU;
+	    typedef SOException Exception;
+	    typedef DataPayload Payload;
+	    typedef Fields<U16Field<PayloadType>, NameField<Name> > Body;
+	    static const uint32_t Id = SO_NNN;
+	    static const char *TypeName () { return "ns3::nnn::SO::nnnSIM"; }
+	  };
+
+	  struct DO
+	  {
+	    typedef nnn::DO PDU;
+	    typedef DOException Exception;
+	    typedef DataPayload Payload;
+	    typedef Fields<U16Field<PayloadType>, NameField<Name> > Body;
+	    static const uint32_t Id = DO_NNN;
+	    static const char *TypeName () { return "ns3::nnn::DO::nnnSIM"; }
+	  };
+
+	  struct DU
+	  {
+	    typedef nnn::DU PDU;
+	    typedef DUException Exception;
+	    typedef DataPayload Payload;
+	    typedef Fields<U16Field<PayloadType>, NameField<SrcName>, NameField<DstName> > Body;
+	    static const uint32_t Id = DU_NNN;
+	    static const char *TypeName () { return "ns3::nnn::DU::nnnSIM"; }
+	  };
+
+	  struct EN
+	  {
+	    typedef nnn::EN PDU;
+	    typedef ENException Exception;
+	    typedef NoPayload Payload;
+	    typedef Fields<PoAListField<Poas> > Body;
+	    static const uint32_t Id = EN_NNN;
+	    static const char *TypeName () { return "ns3::nnn::EN::nnnSIM"; }
+	  };
+
+	  struct AEN
+	  {
+	    typedef nnn::AEN PDU;
+	    typedef AENException Exception;
+	    typedef NoPayload Payload;
+	    typedef Fields<PoAListField<Poas>, SecondsField<Leasetime>, NameField<Name> > Body;
+	    static const uint32_t Id = AEN_NNN;
+	    static const char *TypeName () { return "ns3::nnn::AEN::nnnSIM"; }
+	  };
+
+	  struct REN
+	  {
+	    typedef nnn::REN PDU;
+	    typedef RENException Exception;
+	    typedef NoPayload Payload;
+	    typedef Fields<PoAListField<Poas>, SecondsField<RemainLease>, NameField<Name> > Body;
+	    static const uint32_t Id = REN_NNN;
+	    static const char *TypeName () { return "ns3::nnn::REN::nnnSIM"; }
+	  };
+
+	  struct DEN
+	  {
+	    typedef nnn::DEN PDU;
+	    typedef DENException Exception;
+	    typedef NoPayload Payload;
+	    // The predicted next sector only follows the DEN fields when there is one
+	    typedef Fields<PoAListField<Poas>, NameField<Name>, OptionalField<NameField<NextSector>, NextSector> > Body;
+	    static const uint32_t Id = DEN_NNN;
+	    static const char *TypeName () { return "ns3::nnn::DEN::nnnSIM"; }
+	  };
+
+	  struct OEN
+	  {
+	    typedef nnn::OEN PDU;
+	    typedef OENException Exception;
+	    typedef NoPayload Payload;
+	    typedef Fields<PoAListField<Poas>, SecondsField<Leasetime>, NameField<Name>,
+			   PoAListField<PersonalPoas>, NameField<SrcName> > Body;
+	    static const uint32_t Id = OEN_NNN;
+	    static const char *TypeName () { return "ns3::nnn::OEN::nnnSIM"; }
+	  };
+
+	  struct INF
+	  {
+	    typedef nnn::INF PDU;
+	    typedef INFException Exception;
+	    typedef NoPayload Payload;
+	    typedef Fields<SecondsField<RemainLease>, NameField<OldName>, NameField<NewName> > Body;
+	    static const uint32_t Id = INF_NNN;
+	    static const char *TypeName () { return "ns3::nnn::INF::nnnSIM"; }
+	  };
+	} /* namespace schema */
+      } /* namespace nnnSIM */
+    } /* namespace wire */
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNNSIM_SCHEMA_H_ */
@@ -21,15 +21,6 @@
 #ifndef NNN_WIRE_NNNSIM_H
 #define NNN_WIRE_NNNSIM_H
 
-#include "nullp/nnnsim-nullp.h"
-#include "so/nnnsim-so.h"
-#include "do/nnnsim-do.h"
-#include "du/nnnsim-du.h"
-#include "en/nnnsim-en.h"
-#include "aen/nnnsim-aen.h"
-#include "ren/nnnsim-ren.h"
-#include "den/nnnsim-den.h"
-#include "oen/nnnsim-oen.h"
-#include "inf/nnnsim-inf.h"
+#include "nnnsim-codec.h"
 
 #endif // NNN_WIRE_NNNSIM_H
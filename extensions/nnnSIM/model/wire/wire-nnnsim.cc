@@ -18,8 +18,12 @@
  */
 
 #include "wire-nnnsim.h"
+#include <ns3-dev/ns3/fatal-error.h>
 #include <boost/foreach.hpp>
 
+#include <cstring>
+#include <iterator>
+
 NNN_NAMESPACE_BEGIN
 
 namespace wire {
@@ -79,6 +83,279 @@ namespace wire {
 
     return name;
   }
+
+  size_t
+  NnnSim::SerializeVarint (Buffer::Iterator &i, uint64_t value)
+  {
+    size_t written = 1;
+    while (value >= 0x80)
+      {
+	i.WriteU8 (static_cast<uint8_t> (value | 0x80));
+	value >>= 7;
+	written++;
+      }
+    i.WriteU8 (static_cast<uint8_t> (value));
+
+    return written;
+  }
+
+  size_t
+  NnnSim::SerializedSizeVarint (uint64_t value)
+  {
+    size_t size = 1;
+    while (value >= 0x80)
+      {
+	value >>= 7;
+	size++;
+      }
+    return size;
+  }
+
+  uint64_t
+  NnnSim::DeserializeVarint (Buffer::Iterator &i)
+  {
+    uint64_t value = 0;
+    uint8_t byte;
+    uint32_t shift = 0;
+    do
+      {
+	byte = i.ReadU8 ();
+	value |= static_cast<uint64_t> (byte & 0x7f) << shift;
+	shift += 7;
+      }
+    while ((byte & 0x80) && shift < 64);
+
+    return value;
+  }
+
+  void
+  NnnSim::FindPrefix (const NNNAddress &name, const std::vector<NNNAddress> &dictionary,
+                      size_t &ref, size_t &shared)
+  {
+    ref = 0;
+    shared = 0;
+
+    // Most recent names first, they are the likeliest to share
+    for (size_t k = 1; k <= dictionary.size (); k++)
+      {
+	const NNNAddress &other = dictionary[dictionary.size () - k];
+
+	size_t common = 0;
+	NNNAddress::const_iterator a = name.begin ();
+	NNNAddress::const_iterator b = other.begin ();
+	while (a != name.end () && b != other.end ()
+	    && a->size () == b->size ()
+	    && std::memcmp (a->buf (), b->buf (), a->size ()) == 0)
+	  {
+	    common++;
+	    a++;
+	    b++;
+	  }
+
+	if (common > shared)
+	  {
+	    ref = k;
+	    shared = common;
+	  }
+      }
+  }
+
+  size_t
+  NnnSim::SerializeCompactName (Buffer::Iterator &i, const NNNAddress &name,
+                                std::vector<NNNAddress> &dictionary)
+  {
+    Buffer::Iterator start = i;
+
+    size_t ref, shared;
+    FindPrefix (name, dictionary, ref, shared);
+
+    SerializeVarint (i, ref);
+    if (ref != 0)
+      SerializeVarint (i, shared);
+
+    SerializeVarint (i, name.size () - shared);
+
+    NNNAddress::const_iterator item = name.begin ();
+    std::advance (item, shared);
+    for (; item != name.end (); item++)
+      {
+	SerializeVarint (i, item->size ());
+	i.Write (reinterpret_cast<const uint8_t*> (item->buf ()), item->size ());
+      }
+
+    dictionary.push_back (name);
+
+    return i.GetDistanceFrom (start);
+  }
+
+  size_t
+  NnnSim::SerializedSizeCompactName (const NNNAddress &name, std::vector<NNNAddress> &dictionary)
+  {
+    size_t ref, shared;
+    FindPrefix (name, dictionary, ref, shared);
+
+    size_t size = SerializedSizeVarint (ref);
+    if (ref != 0)
+      size += SerializedSizeVarint (shared);
+
+    size += SerializedSizeVarint (name.size () - shared);
+
+    NNNAddress::const_iterator item = name.begin ();
+    std::advance (item, shared);
+    for (; item != name.end (); item++)
+      size += SerializedSizeVarint (item->size ()) + item->size ();
+
+    dictionary.push_back (name);
+
+    return size;
+  }
+
+  Ptr<NNNAddress>
+  NnnSim::DeserializeCompactName (Buffer::Iterator &i, std::vector<NNNAddress> &dictionary)
+  {
+    Ptr<NNNAddress> name = Create<NNNAddress> ();
+
+    size_t ref = DeserializeVarint (i);
+    if (ref != 0)
+      {
+	if (ref > dictionary.size ())
+	  NS_FATAL_ERROR ("Compact name refers to a name not in the PDU");
+
+	const NNNAddress &other = dictionary[dictionary.size () - ref];
+	size_t shared = DeserializeVarint (i);
+
+	if (shared > other.size ())
+	  NS_FATAL_ERROR ("Compact name shares more components than it has");
+
+	NNNAddress::const_iterator end = other.begin ();
+	std::advance (end, shared);
+	name->append (other.begin (), end);
+      }
+
+    size_t rest = DeserializeVarint (i);
+    for (size_t k = 0; k < rest; k++)
+      {
+	// The length comes from the PDU, so it cannot be trusted to size a stack array
+	size_t length = DeserializeVarint (i);
+	if (length > i.GetRemainingSize ())
+	  NS_FATAL_ERROR ("Compact name component is longer than the rest of the PDU");
+
+	std::vector<uint8_t> tmp (length);
+	if (length > 0)
+	  i.Read (&tmp[0], length);
+
+	name->append (tmp.empty () ? 0 : &tmp[0], length);
+      }
+
+    dictionary.push_back (*name);
+
+    return name;
+  }
+
+  size_t
+  NnnSim::SerializeCompactPoas (Buffer::Iterator &i, const std::vector<Address> &poas)
+  {
+    Buffer::Iterator start = i;
+
+    SerializeVarint (i, poas.size ());
+
+    // Type, length and bytes of the PoA before, as CopyAllTo gives them
+    uint8_t previous[Address::MAX_SIZE + 2];
+    uint8_t current[Address::MAX_SIZE + 2];
+
+    for (size_t k = 0; k < poas.size (); k++)
+      {
+	poas[k].CopyAllTo (current, sizeof (current));
+	uint8_t length = current[1];
+
+	if (k > 0 && previous[0] == current[0] && previous[1] == length)
+	  {
+	    uint8_t shared = 0;
+	    while (shared < length && previous[2 + shared] == current[2 + shared])
+	      shared++;
+
+	    // 1 + the number of bytes shared with the PoA before
+	    SerializeVarint (i, shared + 1);
+	    i.Write (current + 2 + shared, length - shared);
+	  }
+	else
+	  {
+	    SerializeVarint (i, 0);
+	    i.Write (current, length + 2);
+	  }
+
+	std::memcpy (previous, current, length + 2);
+      }
+
+    return i.GetDistanceFrom (start);
+  }
+
+  size_t
+  NnnSim::SerializedSizeCompactPoas (const std::vector<Address> &poas)
+  {
+    size_t size = SerializedSizeVarint (poas.size ());
+
+    uint8_t previous[Address::MAX_SIZE + 2];
+    uint8_t current[Address::MAX_SIZE + 2];
+
+    for (size_t k = 0; k < poas.size (); k++)
+      {
+	poas[k].CopyAllTo (current, sizeof (current));
+	uint8_t length = current[1];
+
+	if (k > 0 && previous[0] == current[0] && previous[1] == length)
+	  {
+	    uint8_t shared = 0;
+	    while (shared < length && previous[2 + shared] == current[2 + shared])
+	      shared++;
+
+	    size += SerializedSizeVarint (shared + 1) + length - shared;
+	  }
+	else
+	  size += 1 + length + 2;
+
+	std::memcpy (previous, current, length + 2);
+      }
+
+    return size;
+  }
+
+  std::vector<Address>
+  NnnSim::DeserializeCompactPoas (Buffer::Iterator &i)
+  {
+    std::vector<Address> poas;
+
+    uint8_t current[Address::MAX_SIZE + 2];
+
+    size_t total = DeserializeVarint (i);
+    for (size_t k = 0; k < total; k++)
+      {
+	size_t shared = DeserializeVarint (i);
+	if (shared == 0)
+	  {
+	    current[0] = i.ReadU8 ();
+	    current[1] = i.ReadU8 ();
+
+	    if (current[1] > Address::MAX_SIZE)
+	      NS_FATAL_ERROR ("PoA longer than an Address can hold");
+
+	    i.Read (current + 2, current[1]);
+	  }
+	else
+	  {
+	    // Same type and length as the PoA before, and its first bytes
+	    if (k == 0 || shared - 1 > current[1])
+	      NS_FATAL_ERROR ("Compact PoA refers to a PoA not in the list");
+
+	    shared--;
+	    i.Read (current + 2 + shared, current[1] - shared);
+	  }
+
+	poas.push_back (Address (current[0], current + 2, current[1]));
+      }
+
+    return poas;
+  }
 }
 
 NNN_NAMESPACE_END
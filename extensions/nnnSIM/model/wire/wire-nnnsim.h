@@ -20,6 +20,9 @@
 #ifndef NNN_WIRE_NNNSIM_SYNTAX_H
 #define NNN_WIRE_NNNSIM_SYNTAX_H
 
+#include <vector>
+
+#include <ns3-dev/ns3/address.h>
 #include <ns3-dev/ns3/ptr.h>
 #include <ns3-dev/ns3/nstime.h>
 #include <ns3-dev/ns3/buffer.h>
@@ -62,6 +65,106 @@ namespace wire {
      */
     static Ptr<NNNAddress>
     DeserializeName (Buffer::Iterator &start);
+
+    /**
+     * @brief Append an unsigned integer 7 bits a byte, least significant
+     * first, the high bit set on all bytes but the last
+     * @param start Buffer to store the value
+     * @param value Value to write
+     *
+     * @returns written length
+     */
+    static size_t
+    SerializeVarint (Buffer::Iterator &start, uint64_t value);
+
+    /**
+     * @brief Size of an unsigned integer written by SerializeVarint
+     * @param value Value to write
+     */
+    static size_t
+    SerializedSizeVarint (uint64_t value);
+
+    /**
+     * @brief Read an unsigned integer written by SerializeVarint
+     * @param start Buffer that stores the value
+     */
+    static uint64_t
+    DeserializeVarint (Buffer::Iterator &start);
+
+    /**
+     * @brief Append Name in compact nnnSIM encoding
+     *
+     * The leading components the name shares with a name already in the
+     * PDU are written as a reference to that name, and the rest with
+     * varint lengths. The names of a PDU have to be written, sized and
+     * read in the same order, with the same dictionary.
+     *
+     * @param start Buffer to store serialized Name
+     * @param name constant reference to Name object
+     * @param dictionary Names already in the PDU, name is added to it
+     *
+     * @returns written length
+     */
+    static size_t
+    SerializeCompactName (Buffer::Iterator &start, const NNNAddress &name,
+                          std::vector<NNNAddress> &dictionary);
+
+    /**
+     * @brief Size of Name in compact nnnSIM encoding
+     * @param name constant reference to Name object
+     * @param dictionary Names already in the PDU, name is added to it
+     */
+    static size_t
+    SerializedSizeCompactName (const NNNAddress &name, std::vector<NNNAddress> &dictionary);
+
+    /**
+     * @brief Deserialize Name from compact nnnSIM encoding
+     * @param start Buffer that stores serialized Name
+     * @param dictionary Names already read from the PDU, the name is added to it
+     */
+    static Ptr<NNNAddress>
+    DeserializeCompactName (Buffer::Iterator &start, std::vector<NNNAddress> &dictionary);
+
+    /**
+     * @brief Append a list of PoAs in compact nnnSIM encoding
+     *
+     * A PoA of the same type and length as the one before it only
+     * carries the bytes after the prefix they share, so consecutive MAC
+     * addresses of one vendor cost a few bytes each.
+     *
+     * @param start Buffer to store the PoAs
+     * @param poas PoAs to write
+     *
+     * @returns written length
+     */
+    static size_t
+    SerializeCompactPoas (Buffer::Iterator &start, const std::vector<Address> &poas);
+
+    /**
+     * @brief Size of a list of PoAs in compact nnnSIM encoding
+     * @param poas PoAs to write
+     */
+    static size_t
+    SerializedSizeCompactPoas (const std::vector<Address> &poas);
+
+    /**
+     * @brief Deserialize a list of PoAs from compact nnnSIM encoding
+     * @param start Buffer that stores the PoAs
+     */
+    static std::vector<Address>
+    DeserializeCompactPoas (Buffer::Iterator &start);
+
+  private:
+    /**
+     * @brief Name of the dictionary sharing the most leading components
+     * with name
+     * @param ref Set to the position of that name counted from the
+     * last one (1), or 0 if no name shares a component
+     * @param shared Set to the number of components shared
+     */
+    static void
+    FindPrefix (const NNNAddress &name, const std::vector<NNNAddress> &dictionary,
+                size_t &ref, size_t &shared);
   }; // NnnSim
 
 } // wire
@@ -47,6 +47,7 @@
 #include "model/fib/nnn-fib.h"
 #include "model/fib/nnn-fib-entry.h"
 #include "model/fw/nnn-forwarding-strategy.h"
+#include "model/fw/nnn-rtt-multipath.h"
 #include "model/nnpt/nnn-nnpt.h"
 #include "model/nnpt/nnn-nnpt-entry.h"
 #include "model/nnst/nnn-nnst.h"
@@ -56,6 +57,9 @@
 #include "model/pit/nnn-pit-entry-incoming-face.h"
 #include "model/pit/nnn-pit-entry-outgoing-face.h"
 
+#include "utils/mobility/nnn-handoff-predictor.h"
+#include "utils/mobility/nnn-waypoint-stream-mobility-model.h"
+
 #include "model/nnn-ppp-header.h"
 #include "model/nnn-point2point-netdevice.h"
 
@@ -67,6 +71,7 @@
 #include "helper/nnn-names-container.h"
 #include "helper/nnn-names-container-entry.h"
 #include "helper/nnn-stack-helper.h"
+#include "helper/nnn-waypoint-stream-helper.h"
 
 #include "helper/nnn-point2point-helper.h"
 
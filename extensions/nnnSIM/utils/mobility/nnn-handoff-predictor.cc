@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-handoff-predictor.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-handoff-predictor.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-handoff-predictor.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <limits>
+
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/mobility-model.h>
+
+#include "nnn-handoff-predictor.h"
+#include "../../model/fw/nnn-forwarding-strategy.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.HandoffPredictor");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (HandoffPredictor);
+
+    TypeId
+    HandoffPredictor::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::HandoffPredictor")
+	.SetGroupName ("Nnn")
+	.SetParent<Object> ()
+	.AddConstructor<HandoffPredictor> ()
+
+	.AddAttribute ("Horizon", "How far ahead the position of the node is extrapolated",
+	               TimeValue (Seconds (1)),
+	               MakeTimeAccessor (&HandoffPredictor::m_horizon),
+	               MakeTimeChecker ())
+	;
+      return tid;
+    }
+
+    HandoffPredictor::HandoffPredictor ()
+    {
+    }
+
+    HandoffPredictor::~HandoffPredictor ()
+    {
+    }
+
+    void
+    HandoffPredictor::DoDispose ()
+    {
+      m_aps.clear ();
+      Object::DoDispose ();
+    }
+
+    void
+    HandoffPredictor::AddAccessPoint (Ptr<Node> ap)
+    {
+      NS_LOG_FUNCTION (this << ap->GetId ());
+      m_aps.push_back (ap);
+    }
+
+    Vector
+    HandoffPredictor::PredictPosition () const
+    {
+      Ptr<MobilityModel> mobility = GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (mobility != 0, "HandoffPredictor needs a MobilityModel on the node");
+
+      Vector position = mobility->GetPosition ();
+      Vector velocity = mobility->GetVelocity ();
+      double ahead = m_horizon.ToDouble (Time::S);
+
+      return Vector (position.x + velocity.x * ahead,
+                     position.y + velocity.y * ahead,
+                     position.z + velocity.z * ahead);
+    }
+
+    Ptr<const NNNAddress>
+    HandoffPredictor::PredictNextSector (const NNNAddress &current) const
+    {
+      Vector position = PredictPosition ();
+
+      Ptr<const NNNAddress> next;
+      double nearest = std::numeric_limits<double>::max ();
+
+      for (size_t i = 0; i < m_aps.size (); i++)
+	{
+	  Ptr<ForwardingStrategy> fw = m_aps[i]->GetObject<ForwardingStrategy> ();
+	  if (fw == 0 || !fw->Has3NName ())
+	    continue;
+
+	  Ptr<const NNNAddress> name = fw->GetNode3NNamePtr ();
+	  if (*name == current)
+	    continue;
+
+	  double distance = CalculateDistance (position, m_aps[i]->GetObject<MobilityModel> ()->GetPosition ());
+	  if (distance < nearest)
+	    {
+	      nearest = distance;
+	      next = name;
+	    }
+	}
+
+      if (next != 0)
+	NS_LOG_INFO ("Leaving (" << current << ") towards " << position << ", predicting (" << *next << ")");
+
+      return next;
+    }
+  } // namespace nnn
+} // namespace ns3
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-handoff-predictor.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-handoff-predictor.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-handoff-predictor.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_HANDOFF_PREDICTOR_H_
+#define _NNN_HANDOFF_PREDICTOR_H_
+
+#include <vector>
+
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/node.h>
+#include <ns3-dev/ns3/object.h>
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/vector.h>
+
+#include "../../model/nnn-naming.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * \ingroup nnn-mobility
+     * \brief Guess the access point a mobile node will attach to next
+     *
+     * Aggregated to a mobile node next to its MobilityModel. The position
+     * of the node is extrapolated Horizon ahead with its current velocity,
+     * and the access point nearest to it, other than the one being left,
+     * is the prediction. ForwardingStrategy::Disenroll puts the 3N name
+     * of that access point in the DEN, so the access router being left
+     * can migrate the PDUs it buffers for the node (see the
+     * BufferMigration attribute of ForwardingStrategy).
+     */
+    class HandoffPredictor : public Object
+    {
+    public:
+      static TypeId
+      GetTypeId ();
+
+      HandoffPredictor ();
+
+      virtual
+      ~HandoffPredictor ();
+
+      /**
+       * \brief Add an access point the node may attach to
+       *
+       * The node needs a MobilityModel, and a ForwardingStrategy with a
+       * 3N name by the time a prediction is made
+       */
+      void
+      AddAccessPoint (Ptr<Node> ap);
+
+      /**
+       * \brief Position of the node Horizon from now, at its current velocity
+       */
+      Vector
+      PredictPosition () const;
+
+      /**
+       * \brief Predict the sector the node will attach to next
+       * \param current 3N name of the sector being left
+       * \return 3N name of the predicted access point, 0 if there is none
+       */
+      Ptr<const NNNAddress>
+      PredictNextSector (const NNNAddress &current) const;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      Time m_horizon;
+      std::vector<Ptr<Node> > m_aps;
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* _NNN_HANDOFF_PREDICTOR_H_ */
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-format.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-format.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-format.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_WAYPOINT_FORMAT_H_
+#define _NNN_WAYPOINT_FORMAT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * This header must not depend on ns-3, it is shared with the trace
+ * compiler in random/
+ */
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace waypoint
+    {
+      /**
+       * \brief Layout of a compiled waypoint file
+       *
+       * All fields are in host byte order. The file is made of a FileHeader,
+       * followed by FileHeader::m_nodes FileNode structures sorted by node
+       * id, followed by FileHeader::m_waypoints FileRecord structures. The
+       * waypoints of one node are contiguous and sorted by time, so the
+       * whole file can be mapped into memory and read in place.
+       *
+       * Each FileRecord gives the position of the node at a certain time.
+       * Between two records the node moves in a straight line at constant
+       * velocity, after the last record it stays still.
+       */
+      static const char     FILE_MAGIC[8] = { 'N', 'N', 'N', 'W', 'A', 'Y', 'P', 'T' };
+      static const uint32_t FILE_VERSION  = 1;
+
+      struct FileHeader
+      {
+	char     m_magic[8];  ///< \brief Always FILE_MAGIC
+	uint32_t m_version;   ///< \brief Always FILE_VERSION
+	uint32_t m_nodes;     ///< \brief Number of FileNode structures
+	uint64_t m_waypoints; ///< \brief Number of FileRecord structures
+      };
+
+      struct FileNode
+      {
+	uint32_t m_node;      ///< \brief Node number as used in the ns-2 trace ($node_(i))
+	uint32_t m_count;     ///< \brief Number of waypoints of the node
+	uint64_t m_first;     ///< \brief Index of the first FileRecord of the node
+      };
+
+      struct FileRecord
+      {
+	double m_time;        ///< \brief Time in seconds
+	double m_x;
+	double m_y;
+	double m_z;
+      };
+
+      /**
+       * \brief Check that the header is a compiled waypoint file that fits
+       * in a buffer of the given size
+       */
+      inline bool
+      IsValid (const FileHeader *hdr, uint64_t size)
+      {
+	if (size < sizeof (FileHeader))
+	  return false;
+
+	if (memcmp (hdr->m_magic, FILE_MAGIC, sizeof (FILE_MAGIC)) != 0 || hdr->m_version != FILE_VERSION)
+	  return false;
+
+	return size == sizeof (FileHeader) + (uint64_t) hdr->m_nodes * sizeof (FileNode) +
+	    hdr->m_waypoints * sizeof (FileRecord);
+      }
+    } // namespace waypoint
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* _NNN_WAYPOINT_FORMAT_H_ */
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-stream-mobility-model.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-stream-mobility-model.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-stream-mobility-model.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+
+#include "nnn-waypoint-stream-mobility-model.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.WaypointStreamMobilityModel");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (WaypointStreamMobilityModel);
+
+    TypeId
+    WaypointStreamMobilityModel::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::WaypointStreamMobilityModel")
+	.SetGroupName ("Nnn")
+	.SetParent<MobilityModel> ()
+	.AddConstructor<WaypointStreamMobilityModel> ()
+	;
+      return tid;
+    }
+
+    WaypointStreamMobilityModel::WaypointStreamMobilityModel ()
+    : m_waypoints (0)
+    , m_count (0)
+    , m_current (0)
+    , m_detached (false)
+    {
+    }
+
+    WaypointStreamMobilityModel::~WaypointStreamMobilityModel ()
+    {
+    }
+
+    void
+    WaypointStreamMobilityModel::DoDispose ()
+    {
+      Simulator::Cancel (m_next);
+      m_waypoints = 0;
+      m_count = 0;
+      m_trace = 0;
+      MobilityModel::DoDispose ();
+    }
+
+    void
+    WaypointStreamMobilityModel::SetTrace (Ptr<const WaypointTrace> trace, const waypoint::FileNode &node)
+    {
+      NS_LOG_FUNCTION (this << node.m_node << node.m_count);
+      NS_ASSERT_MSG (m_trace == 0, "Trace has already been set");
+
+      m_trace = trace;
+      m_waypoints = trace->GetWaypoints (node);
+      m_count = node.m_count;
+      m_current = 0;
+
+      // In case we are installed in the middle of the simulation
+      double now = Simulator::Now ().GetSeconds ();
+      while (m_current + 1 < m_count && m_waypoints[m_current + 1].m_time <= now)
+	m_current++;
+
+      ScheduleNext ();
+    }
+
+    uint32_t
+    WaypointStreamMobilityModel::GetCurrentWaypoint () const
+    {
+      return m_current;
+    }
+
+    void
+    WaypointStreamMobilityModel::ScheduleNext ()
+    {
+      if (m_detached || m_current + 1 >= m_count)
+	return;
+
+      Time next = Seconds (m_waypoints[m_current + 1].m_time) - Simulator::Now ();
+      if (next.IsStrictlyNegative ())
+	next = Seconds (0);
+
+      m_next = Simulator::Schedule (next, &WaypointStreamMobilityModel::Advance, this);
+    }
+
+    void
+    WaypointStreamMobilityModel::Advance ()
+    {
+      double now = Simulator::Now ().GetSeconds ();
+
+      m_current++;
+      // Waypoints sharing the same time are jumps, only the last one counts
+      while (m_current + 1 < m_count && m_waypoints[m_current + 1].m_time <= now)
+	m_current++;
+
+      NS_LOG_DEBUG ("Reached waypoint " << m_current << " of " << m_count);
+
+      NotifyCourseChange ();
+      ScheduleNext ();
+    }
+
+    Vector
+    WaypointStreamMobilityModel::DoGetPosition () const
+    {
+      if (m_detached || m_count == 0)
+	return m_position;
+
+      const waypoint::FileRecord &from = m_waypoints[m_current];
+      double now = Simulator::Now ().GetSeconds ();
+
+      if (m_current + 1 >= m_count || now <= from.m_time)
+	return Vector (from.m_x, from.m_y, from.m_z);
+
+      const waypoint::FileRecord &to = m_waypoints[m_current + 1];
+      double span = to.m_time - from.m_time;
+      if (span <= 0)
+	return Vector (to.m_x, to.m_y, to.m_z);
+
+      double alpha = (now - from.m_time) / span;
+      return Vector (from.m_x + alpha * (to.m_x - from.m_x),
+                     from.m_y + alpha * (to.m_y - from.m_y),
+                     from.m_z + alpha * (to.m_z - from.m_z));
+    }
+
+    void
+    WaypointStreamMobilityModel::DoSetPosition (const Vector &position)
+    {
+      NS_LOG_FUNCTION (this << position);
+
+      Simulator::Cancel (m_next);
+      m_detached = (m_count != 0);
+      m_position = position;
+      NotifyCourseChange ();
+    }
+
+    Vector
+    WaypointStreamMobilityModel::DoGetVelocity () const
+    {
+      if (m_detached || m_current + 1 >= m_count)
+	return Vector (0.0, 0.0, 0.0);
+
+      const waypoint::FileRecord &from = m_waypoints[m_current];
+      const waypoint::FileRecord &to = m_waypoints[m_current + 1];
+      double span = to.m_time - from.m_time;
+      double now = Simulator::Now ().GetSeconds ();
+
+      if (span <= 0 || now < from.m_time)
+	return Vector (0.0, 0.0, 0.0);
+
+      return Vector ((to.m_x - from.m_x) / span,
+                     (to.m_y - from.m_y) / span,
+                     (to.m_z - from.m_z) / span);
+    }
+  } // namespace nnn
+} // namespace ns3
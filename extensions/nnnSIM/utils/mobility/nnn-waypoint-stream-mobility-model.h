@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-stream-mobility-model.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-stream-mobility-model.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-stream-mobility-model.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_WAYPOINT_STREAM_MOBILITY_MODEL_H_
+#define _NNN_WAYPOINT_STREAM_MOBILITY_MODEL_H_
+
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/mobility-model.h>
+#include <ns3-dev/ns3/ptr.h>
+
+#include "nnn-waypoint-trace.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * \ingroup nnn-mobility
+     * \brief Mobility model that follows the waypoints of one node of a
+     * compiled waypoint file
+     *
+     * Waypoints are read in place from the mapped file. Only the event for
+     * the next waypoint is ever scheduled, so the number of pending events
+     * is one per node instead of one per line of the ns-2 trace. Positions
+     * in between are interpolated when queried.
+     *
+     * Setting the position explicitly detaches the model from the trace,
+     * the node then stays at the given position.
+     */
+    class WaypointStreamMobilityModel : public MobilityModel
+    {
+    public:
+      static TypeId
+      GetTypeId ();
+
+      WaypointStreamMobilityModel ();
+
+      virtual
+      ~WaypointStreamMobilityModel ();
+
+      /**
+       * \brief Start following the waypoints of a node
+       * \param trace Mapped waypoint file
+       * \param node Index entry of the node inside the trace
+       *
+       * Must be called at most once, before the simulation reaches the
+       * time of the first waypoint
+       */
+      void
+      SetTrace (Ptr<const WaypointTrace> trace, const waypoint::FileNode &node);
+
+      /**
+       * \brief Number of waypoints already passed
+       */
+      uint32_t
+      GetCurrentWaypoint () const;
+
+    protected:
+      virtual void
+      DoDispose ();
+
+    private:
+      virtual Vector
+      DoGetPosition () const;
+
+      virtual void
+      DoSetPosition (const Vector &position);
+
+      virtual Vector
+      DoGetVelocity () const;
+
+      void
+      ScheduleNext ();
+
+      void
+      Advance ();
+
+      Ptr<const WaypointTrace> m_trace;
+      const waypoint::FileRecord *m_waypoints;
+      uint32_t m_count;
+      uint32_t m_current;   ///< \brief Index of the last waypoint reached
+      EventId m_next;
+
+      bool m_detached;
+      Vector m_position;    ///< \brief Position used when detached or without trace
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* _NNN_WAYPOINT_STREAM_MOBILITY_MODEL_H_ */
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-trace.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-trace.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-trace.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ns3-dev/ns3/abort.h>
+#include <ns3-dev/ns3/assert.h>
+#include <ns3-dev/ns3/fatal-error.h>
+#include <ns3-dev/ns3/log.h>
+
+#include "nnn-waypoint-trace.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.WaypointTrace");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    WaypointTrace::WaypointTrace (const std::string &filename)
+    : m_map (0)
+    , m_size (0)
+    , m_header (0)
+    , m_nodes (0)
+    , m_records (0)
+    {
+      NS_LOG_FUNCTION (this << filename);
+
+      int fd = open (filename.c_str (), O_RDONLY);
+      NS_ABORT_MSG_IF (fd < 0, "Unable to open waypoint file " << filename);
+
+      struct stat st;
+      if (fstat (fd, &st) < 0)
+	{
+	  close (fd);
+	  NS_FATAL_ERROR ("Unable to stat waypoint file " << filename);
+	}
+      m_size = st.st_size;
+
+      if (m_size >= sizeof (waypoint::FileHeader))
+	m_map = mmap (0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      // The mapping stays valid after the descriptor is closed
+      close (fd);
+
+      NS_ABORT_MSG_IF (m_map == 0 || m_map == MAP_FAILED, "Unable to map waypoint file " << filename);
+
+      m_header = static_cast<const waypoint::FileHeader *> (m_map);
+      if (!waypoint::IsValid (m_header, m_size))
+	{
+	  munmap (m_map, m_size);
+	  NS_FATAL_ERROR (filename << " is not a valid compiled waypoint file");
+	}
+
+      m_nodes = reinterpret_cast<const waypoint::FileNode *> (m_header + 1);
+      m_records = reinterpret_cast<const waypoint::FileRecord *> (m_nodes + m_header->m_nodes);
+
+      NS_LOG_INFO ("Mapped " << filename << ": " << m_header->m_nodes << " nodes, " <<
+                   m_header->m_waypoints << " waypoints");
+    }
+
+    WaypointTrace::~WaypointTrace ()
+    {
+      if (m_map != 0)
+	munmap (m_map, m_size);
+    }
+
+    uint32_t
+    WaypointTrace::GetNNodes () const
+    {
+      return m_header->m_nodes;
+    }
+
+    const waypoint::FileNode &
+    WaypointTrace::GetNode (uint32_t n) const
+    {
+      NS_ASSERT (n < m_header->m_nodes);
+      return m_nodes[n];
+    }
+
+    const waypoint::FileNode *
+    WaypointTrace::FindNode (uint32_t node) const
+    {
+      // The index is sorted by node number
+      uint32_t lo = 0;
+      uint32_t hi = m_header->m_nodes;
+      while (lo < hi)
+	{
+	  uint32_t mid = lo + (hi - lo) / 2;
+	  if (m_nodes[mid].m_node < node)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+
+      if (lo < m_header->m_nodes && m_nodes[lo].m_node == node)
+	return &m_nodes[lo];
+      else
+	return 0;
+    }
+
+    const waypoint::FileRecord *
+    WaypointTrace::GetWaypoints (const waypoint::FileNode &node) const
+    {
+      NS_ASSERT (node.m_first + node.m_count <= m_header->m_waypoints);
+      return m_records + node.m_first;
+    }
+  } // namespace nnn
+} // namespace ns3
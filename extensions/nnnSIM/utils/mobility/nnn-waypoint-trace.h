@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-waypoint-trace.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-waypoint-trace.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-waypoint-trace.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_WAYPOINT_TRACE_H_
+#define _NNN_WAYPOINT_TRACE_H_
+
+#include <string>
+
+#include <ns3-dev/ns3/simple-ref-count.h>
+
+#include "nnn-waypoint-format.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * \ingroup nnn-mobility
+     * \brief Read only view of a compiled waypoint file
+     *
+     * The file is mapped into memory, nothing is copied. Each
+     * WaypointStreamMobilityModel keeps a reference to the trace, so the
+     * mapping is released when the last model using it goes away.
+     */
+    class WaypointTrace : public SimpleRefCount<WaypointTrace>
+    {
+    public:
+      /**
+       * \brief Map the file into memory
+       * \param filename Compiled waypoint file (see random/ns2-waypoint-compiler)
+       *
+       * Aborts the simulation if the file cannot be opened or is not valid
+       */
+      WaypointTrace (const std::string &filename);
+
+      virtual
+      ~WaypointTrace ();
+
+      uint32_t
+      GetNNodes () const;
+
+      /**
+       * \brief Get the index entry for the n-th node of the file
+       */
+      const waypoint::FileNode &
+      GetNode (uint32_t n) const;
+
+      /**
+       * \brief Find the index entry for a ns-2 node number
+       * \return 0 if the node is not in the trace
+       */
+      const waypoint::FileNode *
+      FindNode (uint32_t node) const;
+
+      /**
+       * \brief Get the waypoints of one node, GetNode(n).m_count in total
+       */
+      const waypoint::FileRecord *
+      GetWaypoints (const waypoint::FileNode &node) const;
+
+    private:
+      WaypointTrace (const WaypointTrace &);
+      WaypointTrace &operator= (const WaypointTrace &);
+
+      void *m_map;
+      uint64_t m_size;
+      const waypoint::FileHeader *m_header;
+      const waypoint::FileNode *m_nodes;
+      const waypoint::FileRecord *m_records;
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif /* _NNN_WAYPOINT_TRACE_H_ */
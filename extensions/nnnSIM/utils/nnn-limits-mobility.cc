@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-limits-mobility.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-limits-mobility.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-limits-mobility.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-limits-mobility.h"
+
+#include <algorithm>
+
+#include <ns3-dev/ns3/double.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/trace-source-accessor.h>
+#include <ns3-dev/ns3/uinteger.h>
+
+NS_LOG_COMPONENT_DEFINE ("nnn.Limits.Mobility");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    NS_OBJECT_ENSURE_REGISTERED (LimitsMobility);
+
+    TypeId
+    LimitsMobility::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::Limits::Mobility")
+	.SetGroupName ("Nnn")
+	.SetParent <LimitsWindow> ()
+	.AddConstructor <LimitsMobility> ()
+
+	.AddAttribute ("BufferThreshold", "Number of PDUs held in the PDUBuffer above which the window is decreased",
+	               UintegerValue (50),
+	               MakeUintegerAccessor (&LimitsMobility::m_bufferThreshold),
+	               MakeUintegerChecker<uint32_t> ())
+
+	.AddAttribute ("HandoffBurst", "Number of DENs or INFs arriving within HandoffInterval that decrease the window",
+	               UintegerValue (3),
+	               MakeUintegerAccessor (&LimitsMobility::m_handoffBurst),
+	               MakeUintegerChecker<uint32_t> (1))
+
+	.AddAttribute ("HandoffInterval", "Interval in which DENs and INFs are counted",
+	               TimeValue (Seconds (1)),
+	               MakeTimeAccessor (&LimitsMobility::m_handoffInterval),
+	               MakeTimeChecker ())
+
+	.AddAttribute ("Decrease", "Multiplicative decrease factor of the window",
+	               DoubleValue (0.5),
+	               MakeDoubleAccessor (&LimitsMobility::m_decrease),
+	               MakeDoubleChecker<double> (0.0, 1.0))
+
+	.AddAttribute ("Increase", "Additive increase of the window for every window of returned Interests",
+	               DoubleValue (1.0),
+	               MakeDoubleAccessor (&LimitsMobility::m_increase),
+	               MakeDoubleChecker<double> (0.0))
+
+	.AddTraceSource ("Buffered",
+	                 "Number of PDUs held in the PDUBuffer, as last notified",
+	                 MakeTraceSourceAccessor (&LimitsMobility::m_buffered))
+
+	.AddTraceSource ("Handoffs",
+	                 "Number of DENs and INFs in the current HandoffInterval",
+	                 MakeTraceSourceAccessor (&LimitsMobility::m_handoffs))
+
+	.AddTraceSource ("Decreases",
+	                 "Number of times the window was decreased",
+	                 MakeTraceSourceAccessor (&LimitsMobility::m_decreases))
+	;
+      return tid;
+    }
+
+    LimitsMobility::LimitsMobility ()
+    : m_bufferThreshold (50)
+    , m_handoffBurst    (3)
+    , m_handoffInterval (Seconds (1))
+    , m_decrease        (0.5)
+    , m_increase        (1.0)
+    , m_window          (0)
+    , m_status          (nnst::FaceMetric::NNN_NNST_GREEN)
+    , m_buffered        (0)
+    , m_handoffs        (0)
+    , m_decreases       (0)
+    {
+    }
+
+    void
+    LimitsMobility::SetLimits (double rate, double delay)
+    {
+      super::SetLimits (rate, delay);
+
+      m_window = GetMaxLimit ();
+      ApplyWindow ();
+    }
+
+    void
+    LimitsMobility::ReturnLimit ()
+    {
+      if (IsEnabled () && m_status == nnst::FaceMetric::NNN_NNST_GREEN && m_buffered <= m_bufferThreshold)
+	{
+	  m_window = std::min (m_window + m_increase / std::max (m_window, 1.0), GetMaxLimit ());
+	  ApplyWindow ();
+	}
+
+      super::ReturnLimit ();
+    }
+
+    void
+    LimitsMobility::NotifyBufferOccupancy (uint32_t pdus)
+    {
+      m_buffered = pdus;
+
+      if (m_buffered > m_bufferThreshold)
+	Decrease ();
+    }
+
+    void
+    LimitsMobility::NotifyHandoff ()
+    {
+      Time now = Simulator::Now ();
+
+      if (now - m_handoffStart > m_handoffInterval)
+	{
+	  m_handoffStart = now;
+	  m_handoffs = 0;
+	}
+
+      m_handoffs++;
+
+      if (m_handoffs >= m_handoffBurst)
+	Decrease ();
+    }
+
+    void
+    LimitsMobility::NotifyFaceStatus (nnst::FaceMetric::Status status)
+    {
+      m_status = status;
+
+      if (!IsEnabled ())
+	return;
+
+      if (status == nnst::FaceMetric::NNN_NNST_RED)
+	{
+	  NS_LOG_DEBUG ("Face is RED, window from " << m_window << " to 1");
+	  m_window = 1.0;
+	  m_lastDecrease = Simulator::Now ();
+	  m_decreases++;
+	  ApplyWindow ();
+	}
+      else if (status == nnst::FaceMetric::NNN_NNST_YELLOW)
+	Decrease ();
+    }
+
+    void
+    LimitsMobility::Decrease ()
+    {
+      if (!IsEnabled ())
+	return;
+
+      Time now = Simulator::Now ();
+
+      // Like a congestion window, only react once per round trip
+      if (m_decreases > 0 && now - m_lastDecrease < Seconds (GetMaxDelay ()))
+	return;
+
+      NS_LOG_DEBUG ("Window from " << m_window << " to " << std::max (1.0, m_window * m_decrease));
+
+      m_window = std::max (1.0, m_window * m_decrease);
+      m_lastDecrease = now;
+      m_decreases++;
+      ApplyWindow ();
+    }
+
+    void
+    LimitsMobility::ApplyWindow ()
+    {
+      UpdateCurrentLimit (m_window);
+    }
+  } // namespace nnn
+} // namespace ns3
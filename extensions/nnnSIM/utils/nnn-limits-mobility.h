@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-limits-mobility.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-limits-mobility.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-limits-mobility.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _NNN_LIMITS_MOBILITY_H_
+#define	_NNN_LIMITS_MOBILITY_H_
+
+#include "nnn-limits-window.h"
+#include <ns3-dev/ns3/nstime.h>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * \ingroup nnn-fw
+     * \brief Window-based limits that adapt to the mobility of 3N nodes (AIMD)
+     *
+     * The window of outstanding Interests grows by Increase/window for every
+     * Interest that is satisfied or times out, up to the maximum limit. It is
+     * multiplied by Decrease, at most once per maximum delay, when:
+     * - the node holds more than BufferThreshold PDUs for moving destinations,
+     * - HandoffBurst DENs or INFs arrive on the Face within HandoffInterval,
+     * - the NNST marks a next hop on the Face YELLOW.
+     *
+     * A RED next hop brings the window down to 1 Interest. The window only
+     * grows while the Face is GREEN and the PDUBuffer is below the threshold.
+     */
+    class LimitsMobility : public LimitsWindow
+    {
+    public:
+      typedef LimitsWindow super;
+
+      static TypeId
+      GetTypeId ();
+
+      /**
+       * @brief Default Constructor
+       */
+      LimitsMobility ();
+
+      /**
+       * @brief Virtual destructor
+       */
+      virtual
+      ~LimitsMobility () { }
+
+      // from nnn::Limits
+      virtual void
+      SetLimits (double rate, double delay);
+
+      /**
+       * @brief Decrease current window of outstanding interests and grow the window
+       */
+      virtual void
+      ReturnLimit ();
+
+      virtual void
+      NotifyBufferOccupancy (uint32_t pdus);
+
+      virtual void
+      NotifyHandoff ();
+
+      virtual void
+      NotifyFaceStatus (nnst::FaceMetric::Status status);
+
+      /**
+       * @brief Get the window of outstanding Interests before it is limited to the maximum
+       */
+      double
+      GetWindow () const
+      {
+	return m_window;
+      }
+
+    private:
+      /**
+       * @brief Multiply the window by Decrease, unless it was already done within the maximum delay
+       */
+      void
+      Decrease ();
+
+      /**
+       * @brief Make the window the current limit
+       */
+      void
+      ApplyWindow ();
+
+    private:
+      uint32_t m_bufferThreshold;  ///< \brief PDUBuffer occupancy above which the window is decreased
+      uint32_t m_handoffBurst;     ///< \brief Number of handoffs within m_handoffInterval that decrease the window
+      Time m_handoffInterval;      ///< \brief Interval in which handoffs are counted
+      double m_decrease;           ///< \brief Multiplicative decrease factor
+      double m_increase;           ///< \brief Additive increase per window of returned Interests
+
+      double m_window;                  ///< \brief Window of outstanding Interests
+      nnst::FaceMetric::Status m_status; ///< \brief Last NNST status notified for the Face
+      Time m_handoffStart;              ///< \brief Start of the interval in which handoffs are counted
+      Time m_lastDecrease;              ///< \brief Time of the last decrease
+
+      TracedValue<uint32_t> m_buffered;  ///< \brief Last PDUBuffer occupancy notified
+      TracedValue<uint32_t> m_handoffs;  ///< \brief Handoffs counted in the current interval
+      TracedValue<uint32_t> m_decreases; ///< \brief Number of times the window was decreased
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif // _NNN_LIMITS_MOBILITY_H_
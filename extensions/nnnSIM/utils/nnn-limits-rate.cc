@@ -62,19 +62,17 @@ namespace ns3
 	      NS_ASSERT_MSG (GetObject<Face> ()->GetNode () != 0, "Node object should exist on the face");
 
 	      m_isLeakScheduled = true;
+	      m_leakInterval = 0.0;
 
 	      if (!m_leakRandomizationInteral.IsZero ())
 		{
 		  UniformVariable r (0.0, m_leakRandomizationInteral.ToDouble (Time::S));
-		  Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
-		                                  Seconds (r.GetValue ()), &LimitsRate::LeakBucket, this, 0.0);
+		  m_nextLeak = Simulator::Now () + Seconds (r.GetValue ());
 		}
 	      else
 		{
-		  Simulator::ScheduleWithContext (GetObject<Face> ()->GetNode ()->GetId (),
-		                                  Seconds (0), &LimitsRate::LeakBucket, this, 0.0);
+		  m_nextLeak = Simulator::Now ();
 		}
-
 	    }
 	}
     }
@@ -82,6 +80,8 @@ namespace ns3
     void
     LimitsRate::SetLimits (double rate, double delay)
     {
+      CatchUp (Simulator::Now ());
+
       super::SetLimits (rate, delay);
 
       // maximum allowed burst
@@ -97,6 +97,9 @@ namespace ns3
     {
       NS_ASSERT_MSG (limit >= 0.0, "Limit should be greater or equal to zero");
 
+      // Leakages up to now go at the old rate
+      CatchUp (Simulator::Now ());
+
       m_bucketLeak = std::min (limit, GetMaxRate ());
       m_bucketMax  = m_bucketLeak * GetMaxDelay ();
     }
@@ -106,6 +109,8 @@ namespace ns3
     {
       if (!IsEnabled ()) return true;
 
+      CatchUp (Simulator::Now ());
+
       return (m_bucketMax - m_bucket >= 1.0);
     }
 
@@ -114,8 +119,12 @@ namespace ns3
     {
       if (!IsEnabled ()) return;
 
+      CatchUp (Simulator::Now ());
+
       NS_ASSERT_MSG (m_bucketMax - m_bucket >= 1.0, "Should not be possible, unless we IsBelowLimit was not checked correctly");
       m_bucket += 1;
+
+      ScheduleLeak ();
     }
 
     void
@@ -124,21 +133,12 @@ namespace ns3
       // do nothing
     }
 
-    void
-    LimitsRate::LeakBucket (double interval)
+    double
+    LimitsRate::LeakBucket (double &bucket, double interval) const
     {
       const double leak = m_bucketLeak * interval;
 
-#ifdef NS3_LOG_ENABLE
-      if (m_bucket>1)
-	{
-	  NS_LOG_DEBUG ("Leak from " << m_bucket << " to " << std::max (0.0, m_bucket - leak));
-	}
-#endif
-
-      double bucketOld = m_bucket;
-
-      m_bucket = std::max (0.0, m_bucket - leak);
+      bucket = std::max (0.0, bucket - leak);
 
       // calculate interval so next time we will leak by 1.001, unless such interval would be more than 1 second
       double newInterval = 1.0;
@@ -147,13 +147,74 @@ namespace ns3
 	  newInterval = 1.001 / m_bucketLeak;
 	}
 
-      if (m_bucketMax - bucketOld < 1.0 &&
-	  m_bucketMax - m_bucket >= 1.0) // limit number of times this stuff is called
+      return newInterval;
+    }
+
+    void
+    LimitsRate::CatchUp (const Time &until)
+    {
+      if (!m_isLeakScheduled)
+	return;
+
+      while (m_nextLeak < until)
 	{
-	  this->FireAvailableSlotCallback ();
+	  double bucketOld = m_bucket;
+	  double newInterval = LeakBucket (m_bucket, m_leakInterval);
+
+	  if (m_bucket == 0.0 && bucketOld == 0.0 && newInterval == m_leakInterval)
+	    {
+	      // Nothing changes until the bucket is used again, skip to the
+	      // last leakage before until
+	      const int64_t step = Seconds (newInterval).GetTimeStep ();
+	      if (step > 0)
+		{
+		  int64_t skipped = (until - m_nextLeak).GetTimeStep () / step;
+		  if ((until - m_nextLeak).GetTimeStep () % step == 0)
+		    skipped--;
+		  m_nextLeak = TimeStep (m_nextLeak.GetTimeStep () + skipped * step);
+		}
+	    }
+
+#ifdef NS3_LOG_ENABLE
+	  if (bucketOld>1)
+	    {
+	      NS_LOG_DEBUG ("Leak from " << bucketOld << " to " << m_bucket);
+	    }
+#endif
+
+	  m_nextLeak += Seconds (newInterval);
+	  m_leakInterval = newInterval;
+
+	  if (m_bucketMax - bucketOld < 1.0 &&
+	      m_bucketMax - m_bucket >= 1.0) // limit number of times this stuff is called
+	    {
+	      this->FireAvailableSlotCallback ();
+	    }
 	}
+    }
+
+    void
+    LimitsRate::ScheduleLeak ()
+    {
+      if (!m_isLeakScheduled || m_leakEvent.IsRunning () || m_bucket <= 0.0)
+	return;
+
+      m_leakEvent = Simulator::Schedule (m_nextLeak - Simulator::Now (), &LimitsRate::Leak, this);
+    }
+
+    void
+    LimitsRate::Leak ()
+    {
+      bool hadTokens = m_bucket > 0.0;
+
+      // Here the leakage itself is the event, so it is applied now
+      CatchUp (Simulator::Now () + TimeStep (1));
 
-      Simulator::Schedule (Seconds (newInterval), &LimitsRate::LeakBucket, this, newInterval);
+      // One more step once the bucket is empty, so a borrow before it
+      // finds the next leakage where it always was. A borrow from the
+      // available slot callback may have scheduled it already
+      if ((hadTokens || m_bucket > 0.0) && !m_leakEvent.IsRunning ())
+	m_leakEvent = Simulator::Schedule (m_nextLeak - Simulator::Now (), &LimitsRate::Leak, this);
     }
 
   } // namespace nnn
@@ -21,6 +21,7 @@
 
 #include "nnn-limits.h"
 #include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/event-id.h>
 
 namespace ns3
 {
@@ -29,6 +30,15 @@ namespace ns3
     /**
      * \ingroup nnn-fw
      * \brief Structure to manage limits for outstanding interests
+     *
+     * The token bucket leaks in steps: the first one up to RandomizeLeak after
+     * the Limits are aggregated to a Face, then every 1.001/leak rate seconds
+     * (at most 1 second). While there are tokens in the bucket, each step is
+     * a simulator event scheduled by the previous one, so it is ordered
+     * against the other events of its time as it always was. Once a step
+     * finds the bucket empty the events stop, as further steps cannot change
+     * it, and the steps are only counted when the bucket is next looked at.
+     * A face that is idle costs nothing.
      */
     class LimitsRate : public Limits
     {
@@ -47,10 +57,14 @@ namespace ns3
       , m_bucketMax (0)
       , m_bucketLeak (1)
       , m_bucket (0)
+      , m_leakInterval (0)
       { }
 
       virtual
-      ~LimitsRate () { }
+      ~LimitsRate ()
+      {
+	m_leakEvent.Cancel ();
+      }
 
       virtual void
       SetLimits (double rate, double delay);
@@ -110,17 +124,46 @@ namespace ns3
       /**
        * @brief Leak bucket, assuming `interval' seconds between leakages
        *
+       * @param bucket Size of the token bucket to leak
        * @param interval Time interval for leakage. Used to calculate size of the leak
+       * @returns Interval until the next leakage
+       */
+      double
+      LeakBucket (double &bucket, double interval) const;
+
+      /**
+       * @brief Apply all the leakages due before until
+       *
+       * A leakage due exactly now is left to its event, if the bucket
+       * has tokens, which runs in its place among the events of now
+       */
+      void
+      CatchUp (const Time &until);
+
+      /**
+       * @brief Schedule Leak for the next leakage, unless it is already
+       * scheduled or the bucket is empty
+       */
+      void
+      ScheduleLeak ();
+
+      /**
+       * @brief Apply the leakage due now, fire the available slot callback if
+       * it frees a slot, and schedule the next one while there are tokens
        */
       void
-      LeakBucket (double interval);
+      Leak ();
     private:
-      bool m_isLeakScheduled;
+      bool m_isLeakScheduled;   ///< \brief True once the leakages have started
 
       double m_bucketMax;   ///< \brief Maximum Interest allowance for this face (maximum tokens that can be issued at the same time)
       double m_bucketLeak;  ///< \brief Normalized amount that should be leaked every second (token bucket leak rate)
       double m_bucket;      ///< \brief Value representing current size of the Interest allowance for this face (current size of token bucket)
 
+      Time m_nextLeak;          ///< \brief Time of the next leakage not yet applied
+      double m_leakInterval;    ///< \brief Interval the next leakage accounts for
+      EventId m_leakEvent;      ///< \brief Pending Leak, while the bucket has tokens
+
       Time m_leakRandomizationInteral;
     };
   } // namespace nnn
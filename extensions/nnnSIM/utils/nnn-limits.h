@@ -23,6 +23,8 @@
 #include <ns3-dev/ns3/object.h>
 #include <ns3-dev/ns3/traced-value.h>
 
+#include "../model/nnst/nnn-nnst-entry-facemetric.h"
+
 namespace ns3
 {
   namespace nnn
@@ -173,6 +175,31 @@ namespace ns3
       ////////////////////////////////////////////////////////////////////////////
       ////////////////////////////////////////////////////////////////////////////
 
+      /**
+       * @brief Number of PDUs the node holds in its PDUBuffer for destinations that are moving
+       *
+       * This and the following notifications come from the forwarding strategy
+       * and the NNST. Realizations that do not adapt to mobility ignore them.
+       */
+      virtual void
+      NotifyBufferOccupancy (uint32_t pdus) {}
+
+      /**
+       * @brief A DEN or INF arrived on the Face
+       */
+      virtual void
+      NotifyHandoff () {}
+
+      /**
+       * @brief The NNST status of a next hop on the Face changed
+       */
+      virtual void
+      NotifyFaceStatus (nnst::FaceMetric::Status status) {}
+
+      ////////////////////////////////////////////////////////////////////////////
+      ////////////////////////////////////////////////////////////////////////////
+      ////////////////////////////////////////////////////////////////////////////
+
       /**
        * @brief Set callback which will be called when exhausted limit gets a new slot
        */
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pdu-type-tag.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pdu-type-tag.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pdu-type-tag.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-pdu-type-tag.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    TypeId
+    PDUTypeTag::GetTypeId ()
+    {
+      static TypeId tid = TypeId ("ns3::nnn::PDUTypeTag")
+	.SetParent<Tag> ()
+	.AddConstructor<PDUTypeTag> ()
+	;
+      return tid;
+    }
+
+    TypeId
+    PDUTypeTag::GetInstanceTypeId () const
+    {
+      return PDUTypeTag::GetTypeId ();
+    }
+
+    uint32_t
+    PDUTypeTag::GetSerializedSize () const
+    {
+      return 1 + 2;
+    }
+
+    void
+    PDUTypeTag::Serialize (TagBuffer i) const
+    {
+      i.WriteU8 (static_cast<uint8_t> (m_type));
+      i.WriteU16 (m_version);
+    }
+
+    void
+    PDUTypeTag::Deserialize (TagBuffer i)
+    {
+      m_type = static_cast<NNN_PDU_TYPE> (i.ReadU8 ());
+      m_version = i.ReadU16 ();
+    }
+
+    void
+    PDUTypeTag::Print (std::ostream &os) const
+    {
+      os << "Type " << m_type << " version " << m_version;
+    }
+  } // namespace nnn
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pdu-type-tag.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pdu-type-tag.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pdu-type-tag.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _NNN_PDU_TYPE_TAG_H_
+#define _NNN_PDU_TYPE_TAG_H_
+
+#include <ns3-dev/ns3/tag.h>
+
+#include "../model/pdus/nnn-pdu.h"
+
+namespace ns3
+{
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-helpers
+     * @brief Packet tag caching the 3N PDU type and version of a wire packet
+     *
+     * Wire::From* tag every packet they encode, and HeaderHelper tags the
+     * packets it had to classify from their bytes, so a PDU is classified
+     * only once however many times it is dispatched
+     */
+    class PDUTypeTag : public Tag
+    {
+    public:
+      static TypeId
+      GetTypeId ();
+
+      /**
+       * @brief Default constructor
+       */
+      PDUTypeTag ()
+      : m_type    (NULL_NNN)
+      , m_version (0)
+      { }
+
+      PDUTypeTag (NNN_PDU_TYPE type, uint16_t version)
+      : m_type    (type)
+      , m_version (version)
+      { }
+
+      /**
+       * @brief Destructor
+       */
+      ~PDUTypeTag () { }
+
+      /**
+       * @brief Get the PDU type of the tagged packet
+       */
+      NNN_PDU_TYPE
+      GetType () const
+      {
+	return m_type;
+      }
+
+      /**
+       * @brief Get the version in the CommonHeader of the tagged packet
+       */
+      uint16_t
+      GetVersion () const
+      {
+	return m_version;
+      }
+
+      ////////////////////////////////////////////////////////
+      // from ObjectBase
+      ////////////////////////////////////////////////////////
+      virtual TypeId
+      GetInstanceTypeId () const;
+
+      ////////////////////////////////////////////////////////
+      // from Tag
+      ////////////////////////////////////////////////////////
+
+      virtual uint32_t
+      GetSerializedSize () const;
+
+      virtual void
+      Serialize (TagBuffer i) const;
+
+      virtual void
+      Deserialize (TagBuffer i);
+
+      virtual void
+      Print (std::ostream &os) const;
+
+    private:
+      NNN_PDU_TYPE m_type;
+      uint16_t m_version;
+    };
+  } // namespace nnn
+} // namespace ns3
+
+#endif // _NNN_PDU_TYPE_TAG_H_
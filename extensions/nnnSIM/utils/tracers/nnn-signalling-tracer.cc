@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-signalling-tracer.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-signalling-tracer.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-signalling-tracer.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "nnn-signalling-tracer.h"
+
+#include <ns3-dev/ns3/packet.h>
+#include <ns3-dev/ns3/config.h>
+#include <ns3-dev/ns3/callback.h>
+#include <ns3-dev/ns3/log.h>
+
+#include "../../model/nnn-pdus.h"
+#include "../../model/nnn-face.h"
+
+NS_LOG_COMPONENT_DEFINE ("nnn.SignallingTracer");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    static const char *g_typeNames[] = { "EN", "AEN", "REN", "DEN", "OEN", "INF" };
+
+    Ptr<SignallingTracer>
+    SignallingTracer::InstallAll ()
+    {
+      Ptr<SignallingTracer> tracer = Create<SignallingTracer> ();
+      std::string fw = "/NodeList/*/$ns3::nnn::ForwardingStrategy/";
+
+      Config::ConnectWithoutContext (fw + "OutENs", MakeCallback (&SignallingTracer::OutENs, tracer));
+      Config::ConnectWithoutContext (fw + "OutAENs", MakeCallback (&SignallingTracer::OutAENs, tracer));
+      Config::ConnectWithoutContext (fw + "OutRENs", MakeCallback (&SignallingTracer::OutRENs, tracer));
+      Config::ConnectWithoutContext (fw + "OutDENs", MakeCallback (&SignallingTracer::OutDENs, tracer));
+      Config::ConnectWithoutContext (fw + "OutOENs", MakeCallback (&SignallingTracer::OutOENs, tracer));
+      Config::ConnectWithoutContext (fw + "OutINFs", MakeCallback (&SignallingTracer::OutINFs, tracer));
+
+      return tracer;
+    }
+
+    SignallingTracer::SignallingTracer ()
+    {
+      for (uint32_t t = 0; t < TYPES; t++)
+	{
+	  m_pdus[t] = 0;
+	  m_bytes[t] = 0;
+	}
+    }
+
+    uint64_t
+    SignallingTracer::GetPDUs () const
+    {
+      uint64_t pdus = 0;
+      for (uint32_t t = 0; t < TYPES; t++)
+	pdus += m_pdus[t];
+      return pdus;
+    }
+
+    uint64_t
+    SignallingTracer::GetBytes () const
+    {
+      uint64_t bytes = 0;
+      for (uint32_t t = 0; t < TYPES; t++)
+	bytes += m_bytes[t];
+      return bytes;
+    }
+
+    void
+    SignallingTracer::Print (std::ostream &os) const
+    {
+      os << "Type\tPDUs\tBytes" << std::endl;
+      for (uint32_t t = 0; t < TYPES; t++)
+	os << g_typeNames[t] << "\t" << m_pdus[t] << "\t" << m_bytes[t] << std::endl;
+      os << "Total\t" << GetPDUs () << "\t" << GetBytes () << std::endl;
+    }
+
+    void
+    SignallingTracer::Count (Type type, Ptr<const Packet> wire)
+    {
+      m_pdus[type]++;
+      // The wire is set once the Face has encoded the PDU
+      if (wire)
+	m_bytes[type] += wire->GetSize ();
+    }
+
+    void
+    SignallingTracer::OutENs (Ptr<const EN> en_p, Ptr<const Face> face)
+    {
+      Count (EN_TYPE, en_p->GetWire ());
+    }
+
+    void
+    SignallingTracer::OutAENs (Ptr<const AEN> aen_p, Ptr<const Face> face)
+    {
+      Count (AEN_TYPE, aen_p->GetWire ());
+    }
+
+    void
+    SignallingTracer::OutRENs (Ptr<const REN> ren_p, Ptr<const Face> face)
+    {
+      Count (REN_TYPE, ren_p->GetWire ());
+    }
+
+    void
+    SignallingTracer::OutDENs (Ptr<const DEN> den_p, Ptr<const Face> face)
+    {
+      Count (DEN_TYPE, den_p->GetWire ());
+    }
+
+    void
+    SignallingTracer::OutOENs (Ptr<const OEN> oen_p, Ptr<const Face> face)
+    {
+      Count (OEN_TYPE, oen_p->GetWire ());
+    }
+
+    void
+    SignallingTracer::OutINFs (Ptr<const INF> inf_p, Ptr<const Face> face)
+    {
+      Count (INF_TYPE, inf_p->GetWire ());
+    }
+
+  } /* namespace nnn */
+} /* namespace ns3 */
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-signalling-tracer.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-signalling-tracer.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-signalling-tracer.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_SIGNALLING_TRACER_H_
+#define NNN_SIGNALLING_TRACER_H_
+
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/simple-ref-count.h>
+
+#include <ostream>
+
+namespace ns3
+{
+  class Packet;
+
+  namespace nnn
+  {
+    class Face;
+    class EN;
+    class OEN;
+    class AEN;
+    class REN;
+    class DEN;
+    class INF;
+
+    /**
+     * @ingroup nnn-tracers
+     * @brief Totals of the mechanism PDUs (EN, AEN, REN, DEN, OEN and INF)
+     * sent by all the nodes, in PDUs and bytes on the wire
+     */
+    class SignallingTracer : public SimpleRefCount<SignallingTracer>
+    {
+    public:
+      /**
+       * @brief Connects to the ForwardingStrategy of every node. Call it
+       * once the 3N stack is installed, and keep the tracer until the
+       * simulation ends
+       */
+      static Ptr<SignallingTracer>
+      InstallAll ();
+
+      SignallingTracer ();
+
+      /**
+       * @brief Mechanism PDUs sent so far
+       */
+      uint64_t
+      GetPDUs () const;
+
+      /**
+       * @brief Bytes on the wire of the mechanism PDUs sent so far
+       */
+      uint64_t
+      GetBytes () const;
+
+      /**
+       * @brief Print the PDUs and bytes of each mechanism PDU type, and the totals
+       *
+       * @param os reference to output stream
+       */
+      void
+      Print (std::ostream &os) const;
+
+    private:
+      enum Type { EN_TYPE = 0, AEN_TYPE, REN_TYPE, DEN_TYPE, OEN_TYPE, INF_TYPE, TYPES };
+
+      void
+      Count (Type type, Ptr<const Packet> wire);
+
+      void OutENs  (Ptr<const EN> en_p, Ptr<const Face> face);
+      void OutAENs (Ptr<const AEN> aen_p, Ptr<const Face> face);
+      void OutRENs (Ptr<const REN> ren_p, Ptr<const Face> face);
+      void OutDENs (Ptr<const DEN> den_p, Ptr<const Face> face);
+      void OutOENs (Ptr<const OEN> oen_p, Ptr<const Face> face);
+      void OutINFs (Ptr<const INF> inf_p, Ptr<const Face> face);
+
+      uint64_t m_pdus[TYPES];
+      uint64_t m_bytes[TYPES];
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_SIGNALLING_TRACER_H_ */
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-table-size-tracer.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-size-tracer.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-table-size-tracer.cc.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nnn-table-size-tracer.h"
+
+#include <ns3-dev/ns3/node.h>
+#include <ns3-dev/ns3/names.h>
+#include <ns3-dev/ns3/callback.h>
+#include <ns3-dev/ns3/simulator.h>
+#include <ns3-dev/ns3/log.h>
+#include <ns3-dev/ns3/node-list.h>
+
+#include "../../model/fw/nnn-forwarding-strategy.h"
+#include "../../model/nnst/nnn-nnst.h"
+#include "../../model/nnpt/nnn-nnpt.h"
+#include "../../model/pit/nnn-pit.h"
+#include "../../model/buffers/nnn-pdu-buffer.h"
+#include "../../helper/nnn-names-container.h"
+
+#include <fstream>
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("nnn.TableSizeTracer");
+
+namespace ns3
+{
+  namespace nnn
+  {
+    static std::list< boost::tuple< boost::shared_ptr<std::ostream>, std::list<Ptr<TableSizeTracer> > > > g_tracers;
+
+    template<class T>
+    static inline void
+    NullDeleter (T *ptr)
+    {
+    }
+
+    TableSizeTracer::TableSizeTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node)
+    : m_os (os)
+    {
+      m_node = boost::lexical_cast<std::string> (node->GetId ());
+
+      std::string name = Names::FindName (node);
+      if (!name.empty ())
+	{
+	  m_node = name;
+	}
+
+      Connect ("NNST", node->GetObject<NNST> ());
+      Connect ("NNPT", node->GetObject<NNPT> ());
+
+      Ptr<Pit> pit = node->GetObject<Pit> ();
+      Connect ("PIT", pit);
+      if (pit != 0)
+	Connect ("PITNames", pit, "AggregatedNames", "AggregatedBytes", pit->GetAggregatedNames (), pit->GetAggregatedBytes ());
+
+      Ptr<ForwardingStrategy> fw = node->GetObject<ForwardingStrategy> ();
+      if (fw != 0)
+	{
+	  Connect ("PDUBuffer", fw->GetPDUBuffer ());
+	  Connect ("NodeNames", fw->GetNodeNames ());
+	  Connect ("LeasedNames", fw->GetLeasedNames ());
+	}
+
+      SetPeriod (Seconds (1.0));
+    }
+
+    TableSizeTracer::~TableSizeTracer ()
+    {
+      m_printEvent.Cancel ();
+    }
+
+    void
+    TableSizeTracer::InstallAll (const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      std::list<Ptr<TableSizeTracer> > tracers;
+      boost::shared_ptr<std::ostream> outputStream;
+      if (file != "-")
+	{
+	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+
+	  if (!os->is_open ())
+	    {
+	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+	      return;
+	    }
+
+	  outputStream = os;
+	}
+      else
+	{
+	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+	}
+
+      for (NodeList::Iterator node = NodeList::Begin ();
+	  node != NodeList::End ();
+	  node++)
+	{
+	  Ptr<TableSizeTracer> trace = Install (*node, outputStream, period);
+	  tracers.push_back (trace);
+	}
+
+      if (tracers.size () > 0)
+	{
+	  tracers.front ()->PrintHeader (*outputStream);
+	  *outputStream << "\n";
+	}
+
+      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+    void
+    TableSizeTracer::Install (const NodeContainer &nodes, const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      std::list<Ptr<TableSizeTracer> > tracers;
+      boost::shared_ptr<std::ostream> outputStream;
+      if (file != "-")
+	{
+	  boost::shared_ptr<std::ofstream> os (new std::ofstream ());
+	  os->open (file.c_str (), std::ios_base::out | std::ios_base::trunc);
+
+	  if (!os->is_open ())
+	    {
+	      NS_LOG_ERROR ("File " << file << " cannot be opened for writing. Tracing disabled");
+	      return;
+	    }
+
+	  outputStream = os;
+	}
+      else
+	{
+	  outputStream = boost::shared_ptr<std::ostream> (&std::cout, NullDeleter<std::ostream>);
+	}
+
+      for (NodeContainer::Iterator node = nodes.Begin ();
+	  node != nodes.End ();
+	  node++)
+	{
+	  Ptr<TableSizeTracer> trace = Install (*node, outputStream, period);
+	  tracers.push_back (trace);
+	}
+
+      if (tracers.size () > 0)
+	{
+	  tracers.front ()->PrintHeader (*outputStream);
+	  *outputStream << "\n";
+	}
+
+      g_tracers.push_back (boost::make_tuple (outputStream, tracers));
+    }
+
+    void
+    TableSizeTracer::Install (Ptr<Node> node, const std::string &file, Time period/* = Seconds (1.0)*/)
+    {
+      Install (NodeContainer (node), file, period);
+    }
+
+    void
+    TableSizeTracer::Destroy ()
+    {
+      g_tracers.clear ();
+    }
+
+    Ptr<TableSizeTracer>
+    TableSizeTracer::Install (Ptr<Node> node,
+                              boost::shared_ptr<std::ostream> outputStream,
+                              Time period/* = Seconds (1.0)*/)
+    {
+      NS_LOG_DEBUG ("Node: " << node->GetId ());
+
+      Ptr<TableSizeTracer> trace = Create<TableSizeTracer> (outputStream, node);
+      trace->SetPeriod (period);
+
+      return trace;
+    }
+
+    void
+    TableSizeTracer::PrintHeader (std::ostream &os) const
+    {
+      os << "Time" << "\t"
+
+	  << "Node" << "\t"
+	  << "Table" << "\t"
+
+	  << "Entries" << "\t"
+	  << "Bytes";
+    }
+
+    void
+    TableSizeTracer::Print (std::ostream &os) const
+    {
+      Time time = Simulator::Now ();
+
+      for (std::list<Table>::const_iterator table = m_tables.begin ();
+	  table != m_tables.end ();
+	  table++)
+	{
+	  os << time.ToDouble (Time::S) << "\t"
+	      << m_node << "\t"
+	      << table->m_name << "\t"
+	      << table->m_entries << "\t"
+	      << table->m_bytes << "\n";
+	}
+    }
+
+    uint32_t
+    TableSizeTracer::GetEntries (const std::string &table) const
+    {
+      for (std::list<Table>::const_iterator it = m_tables.begin (); it != m_tables.end (); ++it)
+	{
+	  if (it->m_name == table)
+	    return it->m_entries;
+	}
+      return 0;
+    }
+
+    uint64_t
+    TableSizeTracer::GetBytes (const std::string &table) const
+    {
+      for (std::list<Table>::const_iterator it = m_tables.begin (); it != m_tables.end (); ++it)
+	{
+	  if (it->m_name == table)
+	    return it->m_bytes;
+	}
+      return 0;
+    }
+
+    void
+    TableSizeTracer::Connect (const std::string &table, Ptr<Object> object,
+                              const std::string &entries, const std::string &bytes,
+                              uint32_t initialEntries, uint64_t initialBytes)
+    {
+      // The trace sources only report changes, so start from the sizes the table already has
+      Table current = { table, initialEntries, initialBytes };
+      m_tables.push_back (current);
+      Table *added = &m_tables.back ();
+
+      if (!object->TraceConnectWithoutContext (entries, MakeBoundCallback (&TableSizeTracer::EntriesChanged, added))
+	  || !object->TraceConnectWithoutContext (bytes, MakeBoundCallback (&TableSizeTracer::BytesChanged, added)))
+	{
+	  NS_LOG_ERROR ("Node " << m_node << ": " << table << " has no " << entries << " and " << bytes << " trace sources");
+	}
+    }
+
+    void
+    TableSizeTracer::SetPeriod (const Time &period)
+    {
+      m_period = period;
+      m_printEvent.Cancel ();
+      m_printEvent = Simulator::Schedule (m_period, &TableSizeTracer::PeriodicPrinter, this);
+    }
+
+    void
+    TableSizeTracer::PeriodicPrinter ()
+    {
+      Print (*m_os);
+
+      m_printEvent = Simulator::Schedule (m_period, &TableSizeTracer::PeriodicPrinter, this);
+    }
+
+    void
+    TableSizeTracer::EntriesChanged (Table *table, uint32_t oldValue, uint32_t newValue)
+    {
+      table->m_entries = newValue;
+    }
+
+    void
+    TableSizeTracer::BytesChanged (Table *table, uint64_t oldValue, uint64_t newValue)
+    {
+      table->m_bytes = newValue;
+    }
+  } /* namespace nnn */
+} /* namespace ns3 */
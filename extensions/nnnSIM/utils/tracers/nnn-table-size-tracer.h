@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-table-size-tracer.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-size-tracer.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-table-size-tracer.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NNN_TABLE_SIZE_TRACER_H_
+#define NNN_TABLE_SIZE_TRACER_H_
+
+#include <ns3-dev/ns3/ptr.h>
+#include <ns3-dev/ns3/object.h>
+#include <ns3-dev/ns3/simple-ref-count.h>
+#include <ns3-dev/ns3/nstime.h>
+#include <ns3-dev/ns3/event-id.h>
+#include <ns3-dev/ns3/node-container.h>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <string>
+
+namespace ns3
+{
+  class Node;
+
+  namespace nnn
+  {
+    /**
+     * @ingroup nnn-tracers
+     * @brief Entries and approximate bytes of the tables of a node (NNST,
+     * NNPT, PIT, 3N names aggregated in the PIT, PDUBuffer and the two
+     * NamesContainers), written every period
+     *
+     * The tracer starts from the sizes the tables have when it is
+     * installed and then follows the Entries and Bytes trace sources of
+     * each table, so sampling never walks the tables. Install it once
+     * the 3N stack is installed
+     */
+    class TableSizeTracer : public SimpleRefCount<TableSizeTracer>
+    {
+    public:
+      /**
+       * @brief Trace constructor that attaches to the tables of the node
+       * @param os    reference to the output stream
+       * @param node  pointer to the node
+       */
+      TableSizeTracer (boost::shared_ptr<std::ostream> os, Ptr<Node> node);
+
+      /**
+       * @brief Destructor
+       */
+      ~TableSizeTracer ();
+
+      /**
+       * @brief Helper method to install tracers on all simulation nodes
+       *
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the sizes will be written into the trace file (default, every second)
+       */
+      static void
+      InstallAll (const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Helper method to install tracers on the selected simulation nodes
+       *
+       * @param nodes Nodes on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the sizes will be written into the trace file (default, every second)
+       */
+      static void
+      Install (const NodeContainer &nodes, const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Helper method to install tracers on a specific simulation node
+       *
+       * @param node Node on which to install tracer
+       * @param file File to which traces will be written.  If filename is -, then std::out is used
+       * @param period How often the sizes will be written into the trace file (default, every second)
+       */
+      static void
+      Install (Ptr<Node> node, const std::string &file, Time period = Seconds (1.0));
+
+      /**
+       * @brief Explicit request to remove all statically created tracers
+       *
+       * This method can be helpful if simulation scenario contains several independent run,
+       * or if it is desired to do a postprocessing of the resulting data
+       */
+      static void
+      Destroy ();
+
+      /**
+       * @brief Helper method to install tracers on a specific simulation node
+       *
+       * @param node Node on which to install tracer
+       * @param outputStream Smart pointer to a stream
+       * @param period How often the sizes will be written into the trace file (default, every second)
+       *
+       * @returns the tracer, which has to be kept for the lifetime of the simulation
+       */
+      static Ptr<TableSizeTracer>
+      Install (Ptr<Node> node, boost::shared_ptr<std::ostream> outputStream, Time period = Seconds (1.0));
+
+      /**
+       * @brief Print the names of the columns
+       */
+      void
+      PrintHeader (std::ostream &os) const;
+
+      /**
+       * @brief Print one line per table with its current size
+       */
+      void
+      Print (std::ostream &os) const;
+
+      /**
+       * @brief Last number of entries seen for a table, 0 if the node does
+       * not have it
+       */
+      uint32_t
+      GetEntries (const std::string &table) const;
+
+      /**
+       * @brief Last approximate bytes seen for a table, 0 if the node does
+       * not have it
+       */
+      uint64_t
+      GetBytes (const std::string &table) const;
+
+    private:
+      struct Table
+      {
+	std::string m_name;
+	uint32_t m_entries;
+	uint64_t m_bytes;
+      };
+
+      void
+      Connect (const std::string &table, Ptr<Object> object,
+               const std::string &entries, const std::string &bytes,
+               uint32_t initialEntries, uint64_t initialBytes);
+
+      /// Connect to the Entries and Bytes trace sources of a table, if the node has it
+      template <class T>
+      void
+      Connect (const std::string &table, Ptr<T> object)
+      {
+	if (object != 0)
+	  Connect (table, object, "Entries", "Bytes", object->GetEntries (), object->GetBytes ());
+      }
+
+      void
+      SetPeriod (const Time &period);
+
+      void
+      PeriodicPrinter ();
+
+      static void
+      EntriesChanged (Table *table, uint32_t oldValue, uint32_t newValue);
+
+      static void
+      BytesChanged (Table *table, uint64_t oldValue, uint64_t newValue);
+
+    private:
+      boost::shared_ptr<std::ostream> m_os;
+      std::string m_node;
+      Time m_period;
+      EventId m_printEvent;
+
+      std::list<Table> m_tables; ///< \brief Connected tables, a list so the bound callbacks stay valid
+    };
+
+  } /* namespace nnn */
+} /* namespace ns3 */
+
+#endif /* NNN_TABLE_SIZE_TRACER_H_ */
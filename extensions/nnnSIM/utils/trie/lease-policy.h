@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  lease-policy.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lease-policy.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with lease-policy.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEASE_POLICY_3N_H_
+#define LEASE_POLICY_3N_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/set.hpp>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnnSIM
+    {
+      /**
+       * @brief Traits for policy that keeps the nodes ordered by the lease
+       * of their payload, earliest first
+       *
+       * Lease is a functor giving the lease of a payload (which can be
+       * empty), with the type of the lease as Lease::value_type.
+       *
+       * The lease of each node is taken when the node is inserted or
+       * updated (trie_with_policy::modify), and kept in the node hook, so a
+       * payload changed behind the policy's back never breaks the order,
+       * it only leaves the node at its old place until the next update.
+       */
+      template<class Lease>
+      struct lease_policy_traits
+      {
+	/// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+	static std::string GetName () { return "Lease"; }
+
+	typedef typename Lease::value_type lease_type;
+
+	struct policy_hook_type : public boost::intrusive::set_member_hook<>
+	{
+	  lease_type lease_;
+	};
+
+	template<class Container>
+	struct container_hook
+	{
+	  typedef boost::intrusive::member_hook< Container,
+	      policy_hook_type,
+	      &Container::policy_hook_ > type;
+	};
+
+	template<class Base,
+	class Container,
+	class Hook>
+	struct policy
+	{
+	  static lease_type &
+	  get_lease (typename Container::iterator item)
+	  {
+	    return item->policy_hook_.lease_;
+	  }
+
+	  static const lease_type &
+	  get_lease (typename Container::const_iterator item)
+	  {
+	    return item->policy_hook_.lease_;
+	  }
+
+	  template<class Key>
+	  struct MemberHookLess
+	  {
+	    bool operator () (const Key &a, const Key &b) const
+	    {
+	      return get_lease (&a) < get_lease (&b);
+	    }
+	  };
+
+	  typedef boost::intrusive::multiset< Container,
+	      boost::intrusive::compare< MemberHookLess< Container > >,
+	      Hook > policy_container;
+
+	  class type : public policy_container
+	  {
+	  public:
+	    typedef policy policy_base; // to get access to get_lease methods from outside
+	    typedef Container parent_trie;
+
+	    type (Base &base)
+	    : base_ (base)
+	    {
+	    }
+
+	    inline void
+	    update (typename parent_trie::iterator item)
+	    {
+	      // the lease may have moved, put the node back at its place
+	      if (item->policy_hook_.is_linked ())
+		policy_container::erase (policy_container::s_iterator_to (*item));
+
+	      insert (item);
+	    }
+
+	    inline bool
+	    insert (typename parent_trie::iterator item)
+	    {
+	      get_lease (item) = Lease () (item->payload ());
+	      policy_container::insert (*item);
+	      return true;
+	    }
+
+	    inline void
+	    lookup (typename parent_trie::iterator item)
+	    {
+	      // do nothing
+	    }
+
+	    inline void
+	    erase (typename parent_trie::iterator item)
+	    {
+	      // nodes given out by pop_expired are no longer linked
+	      if (item->policy_hook_.is_linked ())
+		policy_container::erase (policy_container::s_iterator_to (*item));
+	    }
+
+	    inline void
+	    clear ()
+	    {
+	      policy_container::clear ();
+	    }
+
+	    /**
+	     * @brief Take out the node with the earliest lease if it is at or
+	     * before now
+	     *
+	     * The caller either erases the node from the trie or hands it back
+	     * with update () once its payload has been cleaned.
+	     *
+	     * @returns the node, 0 if no lease is due
+	     */
+	    inline typename parent_trie::iterator
+	    pop_expired (const lease_type &now)
+	    {
+	      if (policy_container::empty ())
+		return 0;
+
+	      typename parent_trie::iterator item = &(*policy_container::begin ());
+	      if (now < get_lease (item))
+		return 0;
+
+	      policy_container::erase (policy_container::begin ());
+	      return item;
+	    }
+
+	  private:
+	    type () : base_(*((Base*)0)) { };
+
+	  private:
+	    Base &base_;
+	  };
+	};
+      };
+
+    } // nnnSIM
+  } // nnn
+} // ns3
+
+#endif // LEASE_POLICY_3N_H_
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  trie-allocator.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  trie-allocator.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with trie-allocator.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRIE_ALLOCATOR_3N_H_
+#define TRIE_ALLOCATOR_3N_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    namespace nnnSIM
+    {
+      /**
+       * @brief Allocator policy for trie that uses the global heap for every
+       * node and bucket array
+       *
+       * An allocator policy gives raw memory through allocate (bytes) and
+       * takes it back through deallocate (pointer, bytes). One instance is
+       * shared by all the nodes of a trie.
+       */
+      class trie_heap_allocator : boost::noncopyable
+      {
+      public:
+	static const char *
+	GetName () { return "Heap"; }
+
+	inline void *
+	allocate (std::size_t bytes)
+	{
+	  return ::operator new (bytes);
+	}
+
+	inline void
+	deallocate (void *p, std::size_t /*bytes*/)
+	{
+	  ::operator delete (p);
+	}
+      };
+
+      /**
+       * @brief Allocator policy for trie that carves nodes and bucket arrays
+       * out of contiguous pages
+       *
+       * Requests are rounded up to a multiple of granularity bytes and each
+       * size gets its own free list, so a node or bucket array released by
+       * prune is handed out again to the next insert of the same size.
+       * Requests larger than max_block go to the global heap.
+       *
+       * Pages start at first_page bytes and double up to page_size, so
+       * small tables do not each hold a full page. Pages are only returned
+       * when the allocator (and so the table that owns it) is destroyed.
+       *
+       * Every instance costs a free list per size class and at least one
+       * page, so it is meant for the per node tables (NNST, PDUBuffer).
+       * Tables kept in large numbers, such as the NNNAddrAggregator of
+       * each PIT incoming face, use trie_heap_allocator.
+       */
+      class trie_slab_allocator : boost::noncopyable
+      {
+      public:
+	static const std::size_t granularity = 16;
+	static const std::size_t max_block = 1024;
+	static const std::size_t first_page = 512;
+	static const std::size_t page_size = 16384;
+
+	static const char *
+	GetName () { return "Slab"; }
+
+	trie_slab_allocator ()
+	: free_ (max_block / granularity + 1, static_cast<free_block*> (0))
+	, cursor_ (0)
+	, left_ (0)
+	, next_page_ (first_page)
+	{
+	}
+
+	~trie_slab_allocator ()
+	{
+	  for (std::vector<char*>::iterator it = pages_.begin (); it != pages_.end (); ++it)
+	    ::operator delete (*it);
+	}
+
+	inline void *
+	allocate (std::size_t bytes)
+	{
+	  if (bytes > max_block)
+	    return ::operator new (bytes);
+
+	  std::size_t cls = size_class (bytes);
+	  free_block *block = free_[cls];
+	  if (block != 0)
+	    {
+	      free_[cls] = block->next;
+	      return block;
+	    }
+
+	  std::size_t size = cls * granularity;
+	  if (left_ < size)
+	    {
+	      std::size_t bytes_page = next_page_ < size ? size : next_page_;
+	      cursor_ = static_cast<char*> (::operator new (bytes_page));
+	      left_ = bytes_page;
+	      pages_.push_back (cursor_);
+
+	      if (next_page_ < page_size)
+		next_page_ *= 2;
+	    }
+
+	  void *p = cursor_;
+	  cursor_ += size;
+	  left_ -= size;
+	  return p;
+	}
+
+	inline void
+	deallocate (void *p, std::size_t bytes)
+	{
+	  if (bytes > max_block)
+	    {
+	      ::operator delete (p);
+	      return;
+	    }
+
+	  std::size_t cls = size_class (bytes);
+	  free_block *block = static_cast<free_block*> (p);
+	  block->next = free_[cls];
+	  free_[cls] = block;
+	}
+
+	/**
+	 * @brief Number of pages taken from the heap so far
+	 */
+	std::size_t
+	pages () const
+	{
+	  return pages_.size ();
+	}
+
+      private:
+	struct free_block
+	{
+	  free_block *next;
+	};
+
+	static inline std::size_t
+	size_class (std::size_t bytes)
+	{
+	  return bytes == 0 ? 1 : (bytes + granularity - 1) / granularity;
+	}
+
+	std::vector<free_block*> free_; ///< @brief Free list for each size class
+	std::vector<char*> pages_;      ///< @brief Pages to release on destruction
+	char *cursor_;                  ///< @brief Next free byte of the current page
+	std::size_t left_;              ///< @brief Bytes left in the current page
+	std::size_t next_page_;         ///< @brief Size of the next page to take
+      };
+
+    } // nnnSIM
+  } // nnn
+} // ns3
+
+#endif // TRIE_ALLOCATOR_3N_H_
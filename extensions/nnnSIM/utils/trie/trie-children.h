@@ -0,0 +1,575 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  trie-children.h is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  trie-children.h is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with trie-children.h.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRIE_CHILDREN_3N_H_
+#define TRIE_CHILDREN_3N_H_
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+#include <stdint.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace ns3
+{
+  namespace nnn
+  {
+    class NNNAddress;
+
+    namespace nnnSIM
+    {
+      /**
+       * @brief Children of a trie node kept in a boost::intrusive::unordered_set
+       *
+       * Works for any key type with boost::hash_value and operator==. The
+       * bucket array is taken from the allocator of the trie and grows
+       * as children are added.
+       */
+      template<class Node, class Set, class Allocator>
+      class hashed_children : boost::noncopyable
+      {
+      public:
+	typedef typename Set::iterator iterator;
+	typedef typename Set::const_iterator const_iterator;
+
+	hashed_children (Allocator *allocator, size_t bucketSize, size_t bucketIncrement)
+	: bucketSize_ (bucketSize)
+	, bucketIncrement_ (bucketIncrement)
+	, buckets_ (allocator, bucketSize_) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
+	, set_ (bucket_traits (buckets_.get (), bucketSize_))
+	{
+	}
+
+	iterator begin () { return set_.begin (); }
+	const_iterator begin () const { return set_.begin (); }
+	iterator end () { return set_.end (); }
+	const_iterator end () const { return set_.end (); }
+
+	size_t size () const { return set_.size (); }
+
+	template<class Key>
+	iterator
+	find (const Key &key)
+	{
+	  return set_.find (key, key_hash<Key> (), key_equal<Key> ());
+	}
+
+	iterator
+	insert (Node &node)
+	{
+	  if (set_.size () >= bucketSize_)
+	    {
+	      bucketSize_ += bucketIncrement_;
+	      bucketIncrement_ *= 2; // increase bucketIncrement exponentially
+
+	      buckets_array newBuckets (buckets_.get_allocator (), bucketSize_);
+	      set_.rehash (bucket_traits (newBuckets.get (), bucketSize_));
+	      buckets_.swap (newBuckets);
+	    }
+
+	  return set_.insert (node).first;
+	}
+
+	template<class Disposer>
+	void
+	erase_and_dispose (Node &node, Disposer disposer)
+	{
+	  set_.erase_and_dispose (set_.iterator_to (node), disposer);
+	}
+
+	template<class Disposer>
+	void
+	clear_and_dispose (Disposer disposer)
+	{
+	  set_.clear_and_dispose (disposer);
+	}
+
+	iterator iterator_to (Node &node) { return set_.iterator_to (node); }
+	const_iterator iterator_to (const Node &node) const { return set_.iterator_to (node); }
+
+	Allocator *
+	get_allocator () const
+	{
+	  return buckets_.get_allocator ();
+	}
+
+	void
+	print_stat (std::ostream &os) const
+	{
+	  for (size_t bucket = 0, maxbucket = set_.bucket_count ();
+	      bucket < maxbucket;
+	      bucket++)
+	    {
+	      os << " " << set_.bucket_size (bucket);
+	    }
+	}
+
+      private:
+	typedef typename Set::bucket_type   bucket_type;
+	typedef typename Set::bucket_traits bucket_traits;
+
+	// Lookups by component, without building a temporary node
+	template<class Key>
+	struct key_hash
+	{
+	  std::size_t operator() (const Key &key) const { return boost::hash_value (key); }
+	};
+
+	template<class Key>
+	struct key_equal
+	{
+	  bool operator() (const Key &key, const Node &node) const { return key == node.key (); }
+	  bool operator() (const Node &node, const Key &key) const { return key == node.key (); }
+	};
+
+	/**
+	 * @brief Bucket array of a node, taken from and given back to the
+	 * allocator of the node (which it also keeps for the node)
+	 */
+	class buckets_array : boost::noncopyable
+	{
+	public:
+	  buckets_array (Allocator *allocator, size_t size)
+	  : allocator_ (allocator)
+	  , size_ (size)
+	  , array_ (static_cast<bucket_type*> (allocator->allocate (size * sizeof (bucket_type))))
+	  {
+	    for (size_t i = 0; i < size_; i++)
+	      new (array_ + i) bucket_type ();
+	  }
+
+	  ~buckets_array ()
+	  {
+	    for (size_t i = 0; i < size_; i++)
+	      array_[i].~bucket_type ();
+	    allocator_->deallocate (array_, size_ * sizeof (bucket_type));
+	  }
+
+	  bucket_type *
+	  get () const { return array_; }
+
+	  Allocator *
+	  get_allocator () const { return allocator_; }
+
+	  void
+	  swap (buckets_array &other)
+	  {
+	    std::swap (allocator_, other.allocator_);
+	    std::swap (size_, other.size_);
+	    std::swap (array_, other.array_);
+	  }
+
+	private:
+	  Allocator *allocator_;
+	  size_t size_;
+	  bucket_type *array_;
+	};
+
+	size_t bucketSize_;
+	size_t bucketIncrement_;
+	buckets_array buckets_;
+	Set set_;
+      };
+
+      /**
+       * @brief Children of a trie node keyed by the numeric value of the
+       * name component
+       *
+       * 3N names are made of components created with fromNumber, so every
+       * component is a distinct uint64_t label. The children are kept as
+       * (label, node) pairs in one array taken from the allocator of the
+       * trie:
+       *
+       *  - up to max_sorted children, the array is sorted by label and
+       *    searched in place
+       *  - above that, the array becomes an open addressing table with
+       *    linear probing, kept at most half full
+       *
+       * A lookup decodes the component once and then only reads the array,
+       * instead of hashing the blob and comparing it against the key of
+       * each node in the bucket. Nodes without children hold no array.
+       */
+      template<class Node, class Allocator>
+      class label_children : boost::noncopyable
+      {
+	struct slot
+	{
+	  uint64_t label;
+	  Node *node;  ///< @brief 0 for free slots of the table
+	};
+
+      public:
+	static const uint32_t max_sorted = 8;
+	static const uint32_t first_table = 32;
+
+	template<class N, class S>
+	class iterator_base : public std::iterator<std::forward_iterator_tag, N>
+	{
+	public:
+	  iterator_base () : pos_ (0), end_ (0) {}
+	  iterator_base (S *pos, S *end) : pos_ (pos), end_ (end) { skip (); }
+
+	  template<class N2, class S2>
+	  iterator_base (const iterator_base<N2, S2> &other) : pos_ (other.pos_), end_ (other.end_) {}
+
+	  N & operator* () const { return *pos_->node; }
+	  N * operator-> () const { return pos_->node; }
+
+	  iterator_base & operator++ () { ++pos_; skip (); return *this; }
+	  iterator_base operator++ (int) { iterator_base tmp (*this); ++(*this); return tmp; }
+
+	  bool operator== (const iterator_base &other) const { return pos_ == other.pos_; }
+	  bool operator!= (const iterator_base &other) const { return pos_ != other.pos_; }
+
+	private:
+	  template<class N2, class S2>
+	  friend class iterator_base;
+
+	  void
+	  skip ()
+	  {
+	    while (pos_ != end_ && pos_->node == 0)
+	      ++pos_;
+	  }
+
+	  S *pos_;
+	  S *end_;
+	};
+
+	typedef iterator_base<Node, slot> iterator;
+	typedef iterator_base<const Node, const slot> const_iterator;
+
+	label_children (Allocator *allocator, size_t /*bucketSize*/, size_t /*bucketIncrement*/)
+	: allocator_ (allocator)
+	, slots_ (0)
+	, size_ (0)
+	, capacity_ (0)
+	, table_ (false)
+	{
+	}
+
+	~label_children ()
+	{
+	  release ();
+	}
+
+	iterator begin () { return iterator (slots_, slots_ + extent ()); }
+	const_iterator begin () const { return const_iterator (slots_, slots_ + extent ()); }
+	iterator end () { return iterator (slots_ + extent (), slots_ + extent ()); }
+	const_iterator end () const { return const_iterator (slots_ + extent (), slots_ + extent ()); }
+
+	size_t size () const { return size_; }
+
+	template<class Key>
+	iterator
+	find (const Key &key)
+	{
+	  slot *s = lookup (key.toNumber ());
+	  return (s != 0) ? iterator (s, slots_ + extent ()) : end ();
+	}
+
+	iterator
+	insert (Node &node)
+	{
+	  uint64_t label = node.key ().toNumber ();
+	  slot *s = lookup (label);
+	  if (s == 0)
+	    s = table_ ? table_insert (label, &node) : sorted_insert (label, &node);
+	  return iterator (s, slots_ + extent ());
+	}
+
+	template<class Disposer>
+	void
+	erase_and_dispose (Node &node, Disposer disposer)
+	{
+	  slot *s = lookup (node.key ().toNumber ());
+	  if (s == 0)
+	    return;
+
+	  if (table_)
+	    table_erase (s);
+	  else
+	    {
+	      std::memmove (s, s + 1, (slots_ + size_ - s - 1) * sizeof (slot));
+	      size_ --;
+	      if (size_ == 0)
+		release ();
+	    }
+	  disposer (&node);
+	}
+
+	template<class Disposer>
+	void
+	clear_and_dispose (Disposer disposer)
+	{
+	  slot *slots = slots_;
+	  uint32_t count = extent ();
+	  uint32_t capacity = capacity_;
+
+	  // Detach the array first, the disposer may walk back to this node
+	  slots_ = 0;
+	  size_ = capacity_ = 0;
+	  table_ = false;
+
+	  for (uint32_t i = 0; i < count; i++)
+	    if (slots[i].node != 0)
+	      disposer (slots[i].node);
+
+	  if (slots != 0)
+	    allocator_->deallocate (slots, capacity * sizeof (slot));
+	}
+
+	iterator
+	iterator_to (Node &node)
+	{
+	  return iterator (lookup (node.key ().toNumber ()), slots_ + extent ());
+	}
+
+	const_iterator
+	iterator_to (const Node &node) const
+	{
+	  return const_iterator (const_cast<label_children*> (this)->lookup (node.key ().toNumber ()),
+				 slots_ + extent ());
+	}
+
+	Allocator *
+	get_allocator () const
+	{
+	  return allocator_;
+	}
+
+	void
+	print_stat (std::ostream &os) const
+	{
+	  os << " " << (table_ ? "table " : "sorted ") << capacity_;
+	}
+
+      private:
+	uint32_t
+	extent () const
+	{
+	  return table_ ? capacity_ : size_;
+	}
+
+	static inline uint64_t
+	mix (uint64_t z)
+	{
+	  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	  return z ^ (z >> 31);
+	}
+
+	struct label_less
+	{
+	  bool operator() (const slot &s, uint64_t label) const { return s.label < label; }
+	};
+
+	slot *
+	lookup (uint64_t label)
+	{
+	  if (!table_)
+	    {
+	      slot *s = std::lower_bound (slots_, slots_ + size_, label, label_less ());
+	      return (s != slots_ + size_ && s->label == label) ? s : 0;
+	    }
+
+	  uint32_t mask = capacity_ - 1;
+	  for (uint32_t i = mix (label) & mask; slots_[i].node != 0; i = (i + 1) & mask)
+	    {
+	      if (slots_[i].label == label)
+		return &slots_[i];
+	    }
+	  return 0;
+	}
+
+	slot *
+	sorted_insert (uint64_t label, Node *node)
+	{
+	  if (size_ == max_sorted)
+	    {
+	      to_table (first_table);
+	      return table_insert (label, node);
+	    }
+
+	  if (size_ == capacity_)
+	    resize (capacity_ == 0 ? 1 : capacity_ * 2);
+
+	  slot *s = std::lower_bound (slots_, slots_ + size_, label, label_less ());
+	  std::memmove (s + 1, s, (slots_ + size_ - s) * sizeof (slot));
+	  s->label = label;
+	  s->node = node;
+	  size_ ++;
+	  return s;
+	}
+
+	slot *
+	table_insert (uint64_t label, Node *node)
+	{
+	  if ((size_ + 1) * 2 > capacity_)
+	    to_table (capacity_ * 2);
+
+	  uint32_t mask = capacity_ - 1;
+	  uint32_t i = mix (label) & mask;
+	  while (slots_[i].node != 0)
+	    i = (i + 1) & mask;
+
+	  slots_[i].label = label;
+	  slots_[i].node = node;
+	  size_ ++;
+	  return &slots_[i];
+	}
+
+	void
+	table_erase (slot *s)
+	{
+	  // Backward shift deletion, so the table never holds tombstones
+	  uint32_t mask = capacity_ - 1;
+	  uint32_t i = s - slots_;
+	  uint32_t j = i;
+	  slots_[i].node = 0;
+	  size_ --;
+
+	  for (;;)
+	    {
+	      j = (j + 1) & mask;
+	      if (slots_[j].node == 0)
+		break;
+
+	      uint32_t k = mix (slots_[j].label) & mask;
+	      // The entry at j can fill the hole at i only if its home k is not in (i, j]
+	      if ((i < j) ? (k <= i || k > j) : (k <= i && k > j))
+		{
+		  slots_[i] = slots_[j];
+		  slots_[j].node = 0;
+		  i = j;
+		}
+	    }
+
+	  if (size_ <= max_sorted / 2)
+	    to_sorted ();
+	}
+
+	void
+	resize (uint32_t capacity)
+	{
+	  slot *slots = static_cast<slot*> (allocator_->allocate (capacity * sizeof (slot)));
+	  if (size_ > 0)
+	    std::memcpy (slots, slots_, size_ * sizeof (slot));
+	  release ();
+	  slots_ = slots;
+	  capacity_ = capacity;
+	}
+
+	void
+	to_table (uint32_t capacity)
+	{
+	  slot *old = slots_;
+	  uint32_t count = extent ();
+	  uint32_t oldCapacity = capacity_;
+
+	  slots_ = static_cast<slot*> (allocator_->allocate (capacity * sizeof (slot)));
+	  for (uint32_t i = 0; i < capacity; i++)
+	    slots_[i].node = 0;
+	  capacity_ = capacity;
+	  size_ = 0;
+	  table_ = true;
+
+	  for (uint32_t i = 0; i < count; i++)
+	    if (old[i].node != 0)
+	      table_insert (old[i].label, old[i].node);
+
+	  if (old != 0)
+	    allocator_->deallocate (old, oldCapacity * sizeof (slot));
+	}
+
+	void
+	to_sorted ()
+	{
+	  slot *old = slots_;
+	  uint32_t oldCapacity = capacity_;
+
+	  slots_ = static_cast<slot*> (allocator_->allocate (max_sorted * sizeof (slot)));
+	  capacity_ = max_sorted;
+	  table_ = false;
+
+	  uint32_t n = 0;
+	  for (uint32_t i = 0; i < oldCapacity; i++)
+	    if (old[i].node != 0)
+	      slots_[n++] = old[i];
+	  std::sort (slots_, slots_ + n, slot_order ());
+
+	  allocator_->deallocate (old, oldCapacity * sizeof (slot));
+	}
+
+	struct slot_order
+	{
+	  bool operator() (const slot &a, const slot &b) const { return a.label < b.label; }
+	};
+
+	void
+	release ()
+	{
+	  if (slots_ != 0)
+	    allocator_->deallocate (slots_, capacity_ * sizeof (slot));
+	  slots_ = 0;
+	  capacity_ = 0;
+	}
+
+	Allocator *allocator_;
+	slot *slots_;
+	uint32_t size_;
+	uint32_t capacity_;
+	bool table_;   ///< @brief true once slots_ is an open addressing table
+      };
+
+      /**
+       * @brief Selects how a trie keeps the children of each node for a
+       * given full key type
+       */
+      template<class FullKey>
+      struct trie_children_traits
+      {
+	template<class Node, class Set, class Allocator>
+	struct container
+	{
+	  typedef hashed_children<Node, Set, Allocator> type;
+	};
+      };
+
+      /**
+       * @brief 3N names are looked up by the numeric label of each component
+       */
+      template<>
+      struct trie_children_traits<NNNAddress>
+      {
+	template<class Node, class Set, class Allocator>
+	struct container
+	{
+	  typedef label_children<Node, Allocator> type;
+	};
+      };
+
+    } // nnnSIM
+  } // nnn
+} // ns3
+
+#endif // TRIE_CHILDREN_3N_H_
@@ -33,26 +33,28 @@ namespace ns3
     {
       template<typename FullKey,
       typename PayloadTraits,
-      typename PolicyTraits
+      typename PolicyTraits,
+      typename Allocator = trie_slab_allocator
       >
       class trie_with_policy
       {
       public:
 	typedef trie< FullKey,
 	    PayloadTraits,
-	    typename PolicyTraits::policy_hook_type > parent_trie;
+	    typename PolicyTraits::policy_hook_type,
+	    Allocator > parent_trie;
 
 	typedef typename parent_trie::iterator iterator;
 	typedef typename parent_trie::const_iterator const_iterator;
 
 	typedef typename PolicyTraits::template policy<
-	    trie_with_policy<FullKey, PayloadTraits, PolicyTraits>,
+	    trie_with_policy<FullKey, PayloadTraits, PolicyTraits, Allocator>,
 	    parent_trie,
 	    typename PolicyTraits::template container_hook<parent_trie>::type >::type policy_container;
 
 	inline
 	trie_with_policy (size_t bucketSize = 1, size_t bucketIncrement = 1)
-	: trie_ (nnn::name::Component (), bucketSize, bucketIncrement)
+	: trie_ (nnn::name::Component (), bucketSize, bucketIncrement, &allocator_)
 	, policy_ (*this)
 	{
 	}
@@ -291,6 +293,7 @@ namespace ns3
 	}
 
       private:
+	Allocator        allocator_; ///< @brief Per table allocator, has to outlive trie_
 	parent_trie      trie_;
 	mutable policy_container policy_;
       };
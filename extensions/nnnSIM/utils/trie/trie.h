@@ -29,11 +29,13 @@
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
 
+#include "trie-allocator.h"
+#include "trie-children.h"
+
 namespace ns3
 {
   namespace nnn
@@ -109,22 +111,23 @@ namespace ns3
       //
       template<typename FullKey,
       typename PayloadTraits,
-      typename PolicyHook >
+      typename PolicyHook,
+      typename Allocator = trie_slab_allocator >
       class trie;
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       inline std::ostream&
       operator << (std::ostream &os,
-		   const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+		   const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &trie_node);
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       bool
-      operator== (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-	  const trie<FullKey, PayloadTraits, PolicyHook> &b);
+      operator== (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &a,
+	  const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &b);
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook >
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       std::size_t
-      hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+      hash_value (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &trie_node);
 
       ///////////////////////////////////////////////////
       // actual definition
@@ -135,13 +138,26 @@ namespace ns3
       template<class T>
       class trie_point_iterator;
 
+      /**
+       * @brief Trie with hashed children
+       *
+       * Nodes and bucket arrays are obtained from Allocator (see
+       * trie-allocator.h). The root is given the allocator, all the nodes
+       * created under it share the same instance.
+       *
+       * How the children of a node are stored is chosen from FullKey by
+       * trie_children_traits (see trie-children.h): NNNAddress keys use
+       * the numeric label of the component, other keys a hash set.
+       */
       template<typename FullKey,
       typename PayloadTraits,
-      typename PolicyHook >
+      typename PolicyHook,
+      typename Allocator >
       class trie
       {
       public:
 	typedef typename FullKey::partial_type Key;
+	typedef Allocator allocator_type;
 
 	typedef trie*       iterator;
 	typedef const trie* const_iterator;
@@ -154,14 +170,16 @@ namespace ns3
 
 	typedef PayloadTraits payload_traits;
 
+	/**
+	 * @param allocator Allocator for this node and its children. If 0, an
+	 * instance shared by all the tries of this type is used
+	 */
 	inline
-	trie (const Key &key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+	trie (const Key &key, size_t bucketSize = 1, size_t bucketIncrement = 1, Allocator *allocator = 0)
 	: key_ (key)
 	, initialBucketSize_ (bucketSize)
 	, bucketIncrement_ (bucketIncrement)
-	, bucketSize_ (initialBucketSize_)
-	, buckets_ (new bucket_type [bucketSize_]) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
-	, children_ (bucket_traits (buckets_.get (), bucketSize_))
+	, children_ (allocator != 0 ? allocator : &default_allocator (), initialBucketSize_, bucketIncrement_)
 	, payload_ (PayloadTraits::empty_payload)
 	, parent_ (0)
 	{
@@ -199,11 +217,11 @@ namespace ns3
 
 	// actual entry
 	friend bool
-	operator== <> (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-	    const trie<FullKey, PayloadTraits, PolicyHook> &b);
+	operator== <> (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &a,
+	    const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &b);
 
 	friend std::size_t
-	hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+	hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &trie_node);
 
 	inline std::pair<iterator, bool>
 	insert (const FullKey &key,
@@ -216,24 +234,12 @@ namespace ns3
 	    typename unordered_set::iterator item = trieNode->children_.find (subkey);
 	    if (item == trieNode->children_.end ())
 	      {
-		trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
+		Allocator *allocator = children_.get_allocator ();
+		trie *newNode = new (allocator->allocate (sizeof (trie))) trie (subkey, initialBucketSize_, bucketIncrement_, allocator);
 		// std::cout << "new " << newNode << "\n";
 		newNode->parent_ = trieNode;
 
-		if (trieNode->children_.size () >= trieNode->bucketSize_)
-		  {
-		    trieNode->bucketSize_ += trieNode->bucketIncrement_;
-		    trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-		    buckets_array newBuckets (new bucket_type [trieNode->bucketSize_]);
-		    trieNode->children_.rehash (bucket_traits (newBuckets.get (), trieNode->bucketSize_));
-		    trieNode->buckets_.swap (newBuckets);
-		  }
-
-		std::pair< typename unordered_set::iterator, bool > ret =
-		    trieNode->children_.insert (*newNode);
-
-		trieNode = &(*ret.first);
+		trieNode = &(*trieNode->children_.insert (*newNode));
 	      }
 	    else
 	      trieNode = &(*item);
@@ -379,7 +385,7 @@ namespace ns3
 	  if (payload_ != PayloadTraits::empty_payload)
 	    return this;
 
-	  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+	  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 	  for (typename trie::unordered_set::iterator subnode = children_.begin ();
 	      subnode != children_.end ();
 	      subnode++ )
@@ -405,7 +411,7 @@ namespace ns3
 	  if (payload_ != PayloadTraits::empty_payload && pred (payload_))
 	    return this;
 
-	  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+	  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 	  for (typename trie::unordered_set::iterator subnode = children_.begin ();
 	      subnode != children_.end ();
 	      subnode++ )
@@ -431,7 +437,7 @@ namespace ns3
 	inline const iterator
 	find_if_next_level (Predicate pred)
 	{
-	  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+	  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 	  for (typename trie::unordered_set::iterator subnode = children_.begin ();
 	      subnode != children_.end ();
 	      subnode++ )
@@ -473,7 +479,8 @@ namespace ns3
 	  payload_ = payload;
 	}
 
-	Key key () const
+	const Key &
+	key () const
 	{
 	  return key_;
 	}
@@ -487,18 +494,18 @@ namespace ns3
 	{
 	  void operator() (trie *delete_this)
 	  {
-	    delete delete_this;
+	    Allocator *allocator = delete_this->children_.get_allocator ();
+	    delete_this->~trie ();
+	    allocator->deallocate (delete_this, sizeof (trie));
 	  }
 	};
 
-	template<class D>
-	struct array_disposer
+	static Allocator &
+	default_allocator ()
 	{
-	  void operator() (D *array)
-	  {
-	    delete [] array;
-	  }
-	};
+	  static Allocator allocator;
+	  return allocator;
+	}
 
 	friend
 	std::ostream&
@@ -516,9 +523,8 @@ namespace ns3
 	    boost::intrusive::unordered_set_member_hook< >,
 	    &trie::unordered_set_member_hook_ > member_hook;
 
-	typedef boost::intrusive::unordered_set< trie, member_hook > unordered_set;
-	typedef typename unordered_set::bucket_type   bucket_type;
-	typedef typename unordered_set::bucket_traits bucket_traits;
+	typedef boost::intrusive::unordered_set< trie, member_hook > hashed_set;
+	typedef typename trie_children_traits<FullKey>::template container<trie, hashed_set, Allocator>::type unordered_set;
 
 	template<class T, class NonConstT>
 	friend class trie_iterator;
@@ -535,9 +541,6 @@ namespace ns3
 	size_t initialBucketSize_;
 	size_t bucketIncrement_;
 
-	size_t bucketSize_;
-	typedef boost::interprocess::unique_ptr< bucket_type, array_disposer<bucket_type> > buckets_array;
-	buckets_array buckets_;
 	unordered_set children_;
 
 	typename PayloadTraits::storage_type payload_;
@@ -547,12 +550,12 @@ namespace ns3
 
 
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       inline std::ostream&
-      operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+      operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &trie_node)
       {
 	os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << std::endl;
-	typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+	typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 
 	for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin ();
 	    subnode != trie_node.children_.end ();
@@ -569,21 +572,16 @@ namespace ns3
 	return os;
       }
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       inline void
-      trie<FullKey, PayloadTraits, PolicyHook>
+      trie<FullKey, PayloadTraits, PolicyHook, Allocator>
       ::PrintStat (std::ostream &os) const
        {
 	os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children" << std::endl;
-	for (size_t bucket = 0, maxbucket = children_.bucket_count ();
-	    bucket < maxbucket;
-	    bucket++)
-	  {
-	    os << " " << children_.bucket_size (bucket);
-	  }
+	children_.print_stat (os);
 	os << "\n";
 
-	typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+	typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 	for (typename trie::unordered_set::const_iterator subnode = children_.begin ();
 	    subnode != children_.end ();
 	    subnode++ )
@@ -594,17 +592,17 @@ namespace ns3
        }
 
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       inline bool
-      operator == (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-	  const trie<FullKey, PayloadTraits, PolicyHook> &b)
+      operator == (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &a,
+	  const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &b)
 	  {
 	return a.key_ == b.key_;
 	  }
 
-      template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+      template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
       inline std::size_t
-      hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+      hash_value (const trie<FullKey, PayloadTraits, PolicyHook, Allocator> &trie_node)
       {
 	return boost::hash_value (trie_node.key_);
       }
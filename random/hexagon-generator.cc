@@ -0,0 +1,207 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Copyright (c) 2015 Waseda University
+ * Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ * hexagon-generator.cc
+ *
+ *  Bulk version of hexagon-random.py and content-size-generator. Places the
+ *  gateways of a hexagon grid and the wireless stations inside each hexagon
+ *  and writes them in the rand-hex.txt format read by the scenarios.
+ *  Optionally also writes a list of content sizes following a geometric
+ *  distribution.
+ *
+ *  Instead of a sequential generator, every random number is a hash of
+ *  (seed, stream, counter). Each hexagon and the content sizes use their
+ *  own stream, so the same seed always gives the same placement for a
+ *  hexagon no matter how many other hexagons or sizes are generated, and
+ *  all the numbers of a batch can be computed independently.
+ */
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+#include <stdint.h>
+#include <boost/program_options.hpp>
+
+using namespace std;
+namespace po = boost::program_options;
+
+// Stream used for the content sizes, hexagons use streams 0...n-1
+const uint64_t SIZE_STREAM = 0xffffffffffffffffULL;
+
+// Counter based generator: SplitMix64 finalizer over (seed, stream, counter)
+inline uint64_t mix(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+inline uint64_t draw(uint64_t seed, uint64_t stream, uint64_t counter)
+{
+	return mix(mix(seed ^ mix(stream + 0x9e3779b97f4a7c15ULL)) + counter * 0x9e3779b97f4a7c15ULL);
+}
+
+// Uniform double in [0,1)
+inline double uniform(uint64_t seed, uint64_t stream, uint64_t counter)
+{
+	return (draw(seed, stream, counter) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniform integer in [lo,hi), same as Python's randrange
+inline long randrange(uint64_t seed, uint64_t stream, uint64_t counter, long lo, long hi)
+{
+	return lo + (long) (uniform(seed, stream, counter) * (hi - lo));
+}
+
+// Vectors that define a hexagon
+const double vectors[3][2] = { { 0, -1 }, { -sqrt(3.)/2., .5 }, { sqrt(3.)/2., .5 } };
+
+struct Point
+{
+	double x;
+	double y;
+};
+
+int main(int ac, char* av[])
+{
+	po::variables_map vm;
+
+	try {
+
+		po::options_description desc("Allowed options");
+		desc.add_options()
+	            		("help", "Produce this help message")
+	            		("radius,r", po::value<double>()->default_value(100.0), "Radius of the range of the Wireless station (meters)")
+	            		("xaxis,x", po::value<double>()->default_value(1000.0), "Size of the X axis for the area to use (meters)")
+	            		("yaxis,y", po::value<double>()->default_value(1000.0), "Size of the Y axis for the area to use (meters)")
+	            		("wireless,w", po::value<int>()->default_value(6), "Number of wireless stations to put in one hexagon area")
+	            		("output,o", po::value<string>()->default_value("rand-hex.txt"), "File to write the positions to (- for stdout)")
+	            		("seed,s", po::value<uint64_t>(), "Seed, by default based on the time and pid")
+	            		("sizes", po::value<uint64_t>()->default_value(0), "Number of content sizes to generate")
+	            		("avg", po::value<double>()->default_value(1.0), "Average content size (MB) for the geometric distribution")
+	            		("sizes-output", po::value<string>()->default_value("content-sizes.txt"), "File to write the content sizes to (- for stdout)")
+	            		;
+
+		po::store(po::parse_command_line(ac, av, desc), vm);
+		po::notify(vm);
+
+		if (vm.count("help")) {
+			cout << desc << "\n";
+			return 0;
+		}
+	}
+	catch(std::exception& e) {
+		cerr << "error: " << e.what() << "\n";
+		return 1;
+	}
+	catch(...) {
+		cerr << "Exception of unknown type!\n";
+	}
+
+	double r = vm["radius"].as<double>();
+	double xaxis = vm["xaxis"].as<double>();
+	double yaxis = vm["yaxis"].as<double>();
+	int w = vm["wireless"].as<int>();
+	uint64_t seed = vm.count("seed") ? vm["seed"].as<uint64_t>() : (uint64_t) std::time(0) + ((uint64_t) getpid() << 32);
+
+	if (r < 2 || w < 0) {
+		cerr << "Radius must be at least 2 and the number of wireless stations positive\n";
+		return 1;
+	}
+
+	long size = (long) r;
+
+	// The rhombus of the hexagon used by each wireless station
+	vector<int> sides;
+	for (int i = 0; i < w / 3; i++)
+		for (int j = 0; j < 3; j++)
+			sides.push_back(j);
+	for (int i = 0; i < w % 3; i++)
+		sides.push_back(i);
+
+	// Hexagon centers, same order as hexagon-random.py
+	vector<Point> gws;
+	Point spoints[2] = { { r*sqrt(3.), 2*r }, { 0, 5*r } };
+	for (int p = 0; p < 2; p++)
+		for (double i = spoints[p].y; i < yaxis; i += 6*r)
+			for (double j = spoints[p].x; j < xaxis; j += 2*r*sqrt(3.)) {
+				Point c = { j, i };
+				gws.push_back(c);
+			}
+
+	// Wireless stations, stream g draws 2 numbers per station
+	vector<Point> nodes(gws.size() * sides.size());
+	for (size_t g = 0; g < gws.size(); g++) {
+		for (size_t s = 0; s < sides.size(); s++) {
+			const double *v1 = vectors[sides[s]];
+			const double *v2 = vectors[(sides[s]+1)%3];
+			long a = randrange(seed, g, 2*s, 0, size);
+			long b = randrange(seed, g, 2*s + 1, 1, size);
+
+			Point &n = nodes[g * sides.size() + s];
+			n.x = a*v1[0] + b*v2[0] + gws[g].x;
+			n.y = a*v1[1] + b*v2[1] + gws[g].y;
+		}
+	}
+
+	string output = vm["output"].as<string>();
+	FILE *out = (output == "-") ? stdout : fopen(output.c_str(), "w");
+	if (out == 0) {
+		cerr << "ERROR: Error opening file -> " << output << endl;
+		return 1;
+	}
+
+	fprintf(out, "%.17g\n%.17g\n%lu\n", xaxis, yaxis, (unsigned long) gws.size());
+	for (size_t i = 0; i < gws.size(); i++)
+		fprintf(out, "%.17g,%.17g\n", gws[i].x, gws[i].y);
+	fprintf(out, "%d\n%lu\n", w, (unsigned long) nodes.size());
+	for (size_t i = 0; i < nodes.size(); i++)
+		fprintf(out, "%.17g,%.17g\n", nodes[i].x, nodes[i].y);
+
+	if (out != stdout)
+		fclose(out);
+
+	uint64_t nsizes = vm["sizes"].as<uint64_t>();
+	if (nsizes > 0) {
+		// Geometric distribution by inversion, same mean as content-size-generator
+		double p = 1.0 / (vm["avg"].as<double>() * 1048576);
+		double denom = log1p(-p);
+
+		vector<uint64_t> sizes(nsizes);
+		for (uint64_t i = 0; i < nsizes; i++) {
+			double u = 1.0 - uniform(seed, SIZE_STREAM, i);
+			sizes[i] = (uint64_t) floor(log(u) / denom);
+		}
+
+		string soutput = vm["sizes-output"].as<string>();
+		FILE *sout = (soutput == "-") ? stdout : fopen(soutput.c_str(), "w");
+		if (sout == 0) {
+			cerr << "ERROR: Error opening file -> " << soutput << endl;
+			return 1;
+		}
+
+		for (uint64_t i = 0; i < nsizes; i++)
+			fprintf(sout, "%llu\n", (unsigned long long) sizes[i]);
+
+		if (sout != stdout)
+			fclose(sout);
+	}
+
+	return 0;
+}
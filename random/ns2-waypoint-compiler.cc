@@ -0,0 +1,265 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Copyright (c) 2015 Waseda University
+ * Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ * ns2-waypoint-compiler.cc
+ *
+ *  Compiles ns-2 movement traces (as created by Bonnmotion) into the binary
+ *  waypoint format read by nnn::WaypointStreamHelper. Every setdest is
+ *  turned into the position of the node at the time of the command and
+ *  the position and time at which it arrives, so the simulator does not
+ *  need to parse or schedule anything but the next waypoint of each node.
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/program_options.hpp>
+
+#include "../extensions/nnnSIM/utils/mobility/nnn-waypoint-format.h"
+
+using namespace std;
+using namespace ns3::nnn::waypoint;
+namespace po = boost::program_options;
+
+// One line of the ns-2 trace
+struct Command
+{
+	double time;
+	unsigned line;
+	unsigned node;
+	bool setdest;
+	char axis;
+	double x, y, speed;
+};
+
+bool operator< (const Command &a, const Command &b)
+{
+	if (a.time != b.time)
+		return a.time < b.time;
+	return a.line < b.line;
+}
+
+// Movement state of one node while compiling
+struct Node
+{
+	vector<FileRecord> waypoints;
+	bool initialized;
+
+	Node () : initialized (false) {}
+
+	FileRecord position (double t) const
+	{
+		const FileRecord &last = waypoints.back ();
+		FileRecord res = last;
+		res.m_time = t;
+
+		if (waypoints.size () < 2 || t >= last.m_time)
+			return res;
+
+		// Still moving towards the last waypoint
+		const FileRecord &prev = waypoints[waypoints.size () - 2];
+		double alpha = (t - prev.m_time) / (last.m_time - prev.m_time);
+		res.m_x = prev.m_x + alpha * (last.m_x - prev.m_x);
+		res.m_y = prev.m_y + alpha * (last.m_y - prev.m_y);
+		res.m_z = prev.m_z + alpha * (last.m_z - prev.m_z);
+		return res;
+	}
+
+	// Stop the current movement at time t
+	FileRecord stop (double t)
+	{
+		FileRecord cur = position (t);
+		if (waypoints.back ().m_time > t)
+			waypoints.back () = cur;
+		else if (waypoints.back ().m_time < t)
+			waypoints.push_back (cur);
+		return cur;
+	}
+};
+
+bool parse (const string &line, unsigned num, Command &cmd)
+{
+	char axis;
+	cmd.line = num;
+	cmd.time = 0;
+	cmd.setdest = false;
+
+	if (sscanf (line.c_str (), " $ns_ at %lf \"$node_(%u) setdest %lf %lf %lf",
+	            &cmd.time, &cmd.node, &cmd.x, &cmd.y, &cmd.speed) == 5) {
+		cmd.setdest = true;
+		return true;
+	}
+
+	if (sscanf (line.c_str (), " $ns_ at %lf \"$node_(%u) set %c_ %lf",
+	            &cmd.time, &cmd.node, &axis, &cmd.x) == 4 ||
+	    sscanf (line.c_str (), " $node_(%u) set %c_ %lf", &cmd.node, &axis, &cmd.x) == 3) {
+		cmd.axis = axis;
+		return axis == 'X' || axis == 'Y' || axis == 'Z';
+	}
+
+	return false;
+}
+
+int main(int ac, char* av[])
+{
+	po::variables_map vm;
+
+	try {
+
+		po::options_description desc("Allowed options");
+		desc.add_options()
+	            		("help", "Produce this help message")
+	            		("input", po::value<string>(), "ns-2 movement trace (.ns_movements)")
+	            		("output", po::value<string>(), "Compiled waypoint file to write")
+	            		;
+
+		po::store(po::parse_command_line(ac, av, desc), vm);
+		po::notify(vm);
+
+		if (vm.count("help")) {
+			cout << desc << "\n";
+			return 0;
+		}
+
+		if (! vm.count("input")) {
+			cout << "Input trace was not set!.\n";
+			return 1;
+		}
+
+		if (! vm.count("output")) {
+			cout << "Output file was not set!.\n";
+			return 1;
+		}
+	}
+	catch(std::exception& e) {
+		cerr << "error: " << e.what() << "\n";
+		return 1;
+	}
+	catch(...) {
+		cerr << "Exception of unknown type!\n";
+	}
+
+	string input = vm["input"].as<string>();
+	string output = vm["output"].as<string>();
+
+	ifstream in (input.c_str ());
+	if (!in.is_open ()) {
+		cerr << "ERROR: Error opening file -> " << input << endl;
+		return 1;
+	}
+
+	vector<Command> commands;
+	string line;
+	unsigned num = 0;
+	unsigned skipped = 0;
+	while (getline (in, line)) {
+		Command cmd;
+		num++;
+		if (line.find_first_not_of (" \t\r") == string::npos || line[line.find_first_not_of (" \t")] == '#')
+			continue;
+		if (parse (line, num, cmd))
+			commands.push_back (cmd);
+		else
+			skipped++;
+	}
+
+	// Traces are normally sorted already, but ns-2 does not require it
+	stable_sort (commands.begin (), commands.end ());
+
+	map<unsigned, Node> nodes;
+	for (vector<Command>::iterator it = commands.begin (); it != commands.end (); ++it) {
+		Node &n = nodes[it->node];
+
+		if (!n.initialized) {
+			FileRecord origin = { 0.0, 0.0, 0.0, 0.0 };
+			n.waypoints.push_back (origin);
+			n.initialized = true;
+		}
+
+		FileRecord cur = n.stop (it->time);
+
+		if (it->setdest) {
+			double dx = it->x - cur.m_x;
+			double dy = it->y - cur.m_y;
+			double dist = sqrt (dx * dx + dy * dy);
+
+			if (it->speed <= 0 || dist == 0)
+				continue;
+
+			FileRecord dst = { it->time + dist / it->speed, it->x, it->y, cur.m_z };
+			n.waypoints.push_back (dst);
+		} else {
+			// Position changes are jumps: keep the old position up to
+			// now and add a waypoint with the same time for the new one
+			size_t sz = n.waypoints.size ();
+			if (sz > 1 && n.waypoints[sz - 2].m_time != it->time)
+				n.waypoints.push_back (cur);
+
+			FileRecord &last = n.waypoints.back ();
+			if (it->axis == 'X')
+				last.m_x = it->x;
+			else if (it->axis == 'Y')
+				last.m_y = it->x;
+			else
+				last.m_z = it->x;
+		}
+	}
+
+	FileHeader hdr;
+	memcpy (hdr.m_magic, FILE_MAGIC, sizeof (FILE_MAGIC));
+	hdr.m_version = FILE_VERSION;
+	hdr.m_nodes = nodes.size ();
+	hdr.m_waypoints = 0;
+
+	vector<FileNode> index;
+	for (map<unsigned, Node>::iterator it = nodes.begin (); it != nodes.end (); ++it) {
+		FileNode fn;
+		fn.m_node = it->first;
+		fn.m_count = it->second.waypoints.size ();
+		fn.m_first = hdr.m_waypoints;
+		hdr.m_waypoints += fn.m_count;
+		index.push_back (fn);
+	}
+
+	ofstream out (output.c_str (), ios::out | ios::binary | ios::trunc);
+	if (!out.is_open ()) {
+		cerr << "ERROR: Error opening file -> " << output << endl;
+		return 1;
+	}
+
+	out.write (reinterpret_cast<const char *> (&hdr), sizeof (hdr));
+	if (!index.empty ())
+		out.write (reinterpret_cast<const char *> (&index[0]), index.size () * sizeof (FileNode));
+	for (map<unsigned, Node>::iterator it = nodes.begin (); it != nodes.end (); ++it)
+		out.write (reinterpret_cast<const char *> (&it->second.waypoints[0]),
+		           it->second.waypoints.size () * sizeof (FileRecord));
+
+	if (!out.good ()) {
+		cerr << "ERROR: Error writing file -> " << output << endl;
+		return 1;
+	}
+
+	cout << input << ": " << commands.size () << " commands (" << skipped << " skipped), "
+	     << hdr.m_nodes << " nodes, " << hdr.m_waypoints << " waypoints" << endl;
+
+	return 0;
+}
@@ -21,11 +21,170 @@
 // Extensions
 #include "nnnSIM/nnnSIM-module.h"
 #include "nnnSIM/model/addr-aggr/nnn-addr-aggregator.h"
+#include "nnnSIM/model/pit/nnn-pit-entry-incoming-face.h"
+#include "nnnSIM/model/fw/nnn-forwarding-strategy.h"
+
+#include <set>
+#include <sstream>
+
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
 
 using namespace ns3;
 using namespace std;
 using namespace nnn;
 
+// Prints the (sector, label) pairs given by NNNAddrAggregator::VisitDestinations
+struct PrintDestination
+{
+  uint32_t count;
+
+  PrintDestination () : count (0) {}
+
+  void
+  operator () (const NNNAddress &sector, const NNNAddress &label)
+  {
+    std::cout << sector << " + " << label << std::endl;
+    count++;
+  }
+};
+
+// Keeps a copy of the 3N names given by pit::IncomingFace::VisitDestinations
+struct CollectDestinations
+{
+  std::set<NNNAddress> names;
+  uint32_t count;
+
+  CollectDestinations () : count (0) {}
+
+  void
+  operator () (Ptr<const NNNAddress> dst)
+  {
+    names.insert (*dst);
+    count++;
+  }
+};
+
+Ptr<const NNNAddress>
+Name (uint32_t n)
+{
+  std::ostringstream name;
+  name << std::hex << "ae." << (n % 3) << "." << n;
+  return Create<const NNNAddress> (name.str ());
+}
+
+// Visits count 3N names on an IncomingFace and on a copy of it, which puts
+// them in the inline, flat or NNNAddrAggregator tier depending on count
+uint32_t
+CheckIncomingFace (uint32_t count)
+{
+  uint32_t errors = 0;
+  pit::IncomingFace incoming ((Ptr<Face> ()));
+
+  for (uint32_t n = 0; n < count; n++)
+    incoming.AddDestination (Name (n));
+
+  pit::IncomingFace copy (incoming);
+
+  CollectDestinations visited;
+  incoming.VisitDestinations (visited);
+  CollectDestinations copied;
+  copy.VisitDestinations (copied);
+
+  if (visited.count != count || visited.names.size () != count)
+    {
+      std::cout << "ERROR: IncomingFace with " << count << " names visited " << visited.count << " names, "
+	  << visited.names.size () << " distinct" << std::endl;
+      errors++;
+    }
+
+  for (uint32_t n = 0; n < count; n++)
+    {
+      if (visited.names.find (*Name (n)) == visited.names.end ())
+	{
+	  std::cout << "ERROR: IncomingFace with " << count << " names did not visit " << *Name (n) << std::endl;
+	  errors++;
+	}
+    }
+
+  if (copied.count != count || copied.names != visited.names)
+    {
+      std::cout << "ERROR: copy of an IncomingFace with " << count << " names visited other names" << std::endl;
+      errors++;
+    }
+
+  return errors;
+}
+
+// Gives access to how SatisfyPendingInterest skips next hops already used
+class SkipStrategy : public ForwardingStrategy
+{
+public:
+  typedef ForwardingStrategy::SentNextHops SentNextHops;
+  using ForwardingStrategy::SkipSentNextHop;
+};
+
+Ptr<Face>
+MakeFace ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  device->SetAddress (Mac48Address::Allocate ());
+  node->AddDevice (device);
+  return CreateObject<NetDeviceFace> (node, device);
+}
+
+// Aggregated names redirected to a next hop that already got the Data are
+// not sent again, but the Face they came from still gets the NULLp fallback
+// unless the next hop is on that Face
+uint32_t
+CheckSentNextHops ()
+{
+  uint32_t errors = 0;
+  Ptr<Face> incoming = MakeFace ();
+  Ptr<Face> out = MakeFace ();
+  Address poa = Mac48Address::Allocate ();
+  NNNAddress dst ("ae.1.2");
+
+  SkipStrategy::SentNextHops sentTo;
+  bool satisfied = true;
+
+  if (SkipStrategy::SkipSentNextHop (sentTo, incoming, out, poa, dst, satisfied) || satisfied)
+    {
+      std::cout << "ERROR: skipped a next hop that was not used" << std::endl;
+      errors++;
+    }
+
+  sentTo.push_back (boost::make_tuple (out, poa, dst));
+
+  if (!SkipStrategy::SkipSentNextHop (sentTo, incoming, out, poa, dst, satisfied))
+    {
+      std::cout << "ERROR: sent twice to the same next hop" << std::endl;
+      errors++;
+    }
+  if (satisfied)
+    {
+      std::cout << "ERROR: skipped name satisfied without the NULLp fallback" << std::endl;
+      errors++;
+    }
+
+  if (SkipStrategy::SkipSentNextHop (sentTo, incoming, out, poa, NNNAddress ("ae.1.3"), satisfied))
+    {
+      std::cout << "ERROR: skipped a 3N name that was not sent" << std::endl;
+      errors++;
+    }
+
+  sentTo.push_back (boost::make_tuple (incoming, poa, dst));
+
+  if (!SkipStrategy::SkipSentNextHop (sentTo, incoming, incoming, poa, dst, satisfied) || !satisfied)
+    {
+      std::cout << "ERROR: next hop on the incoming Face did not satisfy it" << std::endl;
+      errors++;
+    }
+
+  return errors;
+}
+
 int main (int argc, char *argv[])
 {
   Ptr<NNNAddress> addr01 = Create<NNNAddress> ("ae.34.21");
@@ -111,4 +270,23 @@ int main (int argc, char *argv[])
     {
       std::cout << **it << std::endl;
     }
+
+  PrintDestination visitor;
+  std::cout << "Visiting aggregation (sector, label) pairs" << std::endl;
+  aggregation->VisitDestinations (visitor);
+
+  uint32_t errors = 0;
+
+  if (visitor.count != distinct.size ())
+    {
+      std::cout << "ERROR: visited " << visitor.count << " pairs, expected " << distinct.size () << std::endl;
+      errors++;
+    }
+
+  errors += CheckIncomingFace (pit::IncomingFace::InlineSize);
+  errors += CheckIncomingFace (pit::IncomingFace::FlatSize);
+  errors += CheckIncomingFace (2 * pit::IncomingFace::FlatSize);
+  errors += CheckSentNextHops ();
+
+  return errors == 0 ? 0 : 1;
 }
@@ -0,0 +1,355 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-buffer-migration-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-buffer-migration-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-buffer-migration-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  A mobile consumer crosses a row of access points at constant velocity
+ *  (ns3::ConstantVelocityMobilityModel), changing to the nearest one as it
+ *  goes. The same run is made with the access routers buffering the Data
+ *  for the consumer until its INF arrives, and with BufferMigration, where
+ *  the HandoffPredictor on the consumer names the next access point in
+ *  the DEN and the Data wait there. Every prediction has to be right, and
+ *  the delays AppDelayTracer reports right after the handoffs have to be
+ *  shorter with migration.
+ */
+
+// Standard C++ modules
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/shared_ptr.hpp>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/mobility-module.h>
+#include <ns3-dev/ns3/network-module.h>
+#include <ns3-dev/ns3/wifi-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/utils/mobility/nnn-handoff-predictor.h"
+#include "nnnSIM/utils/tracers/nnn-app-delay-tracer.h"
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("nnn.BufferMigrationTest");
+
+uint32_t errors = 0;
+
+// State of the run in progress
+map<string, Ptr<Node> > apsBySsid;
+string lastSsid;
+Address lastAp;
+vector<Time> handoffs;
+uint32_t predicted = 0;
+
+// Change to the SSID of the nearest access point, disenrolling when it changes
+void
+FollowNearestAp (Ptr<Node> mobile, Time interval)
+{
+  Ptr<MobilityModel> position = mobile->GetObject<MobilityModel> ();
+  Ptr<nnn::ForwardingStrategy> fw = mobile->GetObject<nnn::ForwardingStrategy> ();
+
+  string ssid;
+  double nearest = 0;
+  for (map<string, Ptr<Node> >::iterator i = apsBySsid.begin (); i != apsBySsid.end (); ++i)
+    {
+      double distance = position->GetDistanceFrom (i->second->GetObject<MobilityModel> ());
+      if (ssid.empty () || distance < nearest)
+	{
+	  ssid = i->first;
+	  nearest = distance;
+	}
+    }
+
+  if (!lastSsid.empty () && ssid != lastSsid && fw->Has3NName ())
+    {
+      // What the DEN will carry, against where the consumer is going
+      Ptr<const nnn::NNNAddress> next = mobile->GetObject<nnn::HandoffPredictor> ()
+	  ->PredictNextSector (fw->GetNode3NName ().getSectorName ());
+      const nnn::NNNAddress &expected = apsBySsid[ssid]->GetObject<nnn::ForwardingStrategy> ()->GetNode3NName ();
+
+      if (next != 0 && *next == expected)
+	predicted++;
+      else
+	{
+	  cout << "ERROR: at " << Simulator::Now ().GetSeconds () << "s predicted ("
+	      << (next != 0 ? next->toDotHex () : string ("none")) << "), moving to (" << expected << ")" << endl;
+	  errors++;
+	}
+
+      handoffs.push_back (Simulator::Now ());
+      Simulator::ScheduleNow (&nnn::ForwardingStrategy::Disenroll, fw);
+    }
+
+  if (ssid != lastSsid)
+    {
+      lastSsid = ssid;
+      ostringstream path;
+      path << "/NodeList/" << mobile->GetId () << "/DeviceList/0/$ns3::WifiNetDevice/Mac/Ssid";
+      Config::Set (path.str (), SsidValue (Ssid (ssid)));
+    }
+
+  Simulator::Schedule (interval, &FollowNearestAp, mobile, interval);
+}
+
+// Enroll on the first association, reenroll on every other one
+void
+ApAssociation (Ptr<nnn::ForwardingStrategy> fw, const Mac48Address mac)
+{
+  Address ap = mac;
+
+  if (lastAp.IsInvalid ())
+    Simulator::ScheduleNow (&nnn::ForwardingStrategy::Enroll, fw);
+  else if (ap != lastAp)
+    Simulator::ScheduleNow (&nnn::ForwardingStrategy::Reenroll, fw);
+  else if (!fw->Has3NName ())
+    Simulator::ScheduleNow (&nnn::ForwardingStrategy::Enroll, fw);
+
+  lastAp = ap;
+}
+
+struct Result
+{
+  uint32_t handoffs;
+  uint32_t predicted;
+  double meanDelay;
+  double maxDelay;
+  uint32_t data;
+};
+
+// Longest full delay of the Data arriving within window of each handoff,
+// read from the AppDelayTracer output
+Result
+HandoffDelays (const string &trace, Time window)
+{
+  Result result = { handoffs.size (), predicted, 0, 0, 0 };
+
+  vector<double> worst (handoffs.size (), 0);
+  istringstream lines (trace);
+  string line;
+  getline (lines, line); // header
+
+  while (getline (lines, line))
+    {
+      vector<string> columns;
+      boost::split (columns, line, boost::is_any_of ("\t"));
+      if (columns.size () < 6 || columns[4] != "FullDelay")
+	continue;
+
+      result.data++;
+      Time at = Seconds (boost::lexical_cast<double> (columns[0]));
+      double delay = boost::lexical_cast<double> (columns[5]);
+
+      for (size_t h = 0; h < handoffs.size (); h++)
+	{
+	  if (at >= handoffs[h] && at < handoffs[h] + window)
+	    worst[h] = std::max (worst[h], delay);
+	}
+    }
+
+  for (size_t h = 0; h < worst.size (); h++)
+    {
+      result.meanDelay += worst[h] / worst.size ();
+      result.maxDelay = std::max (result.maxDelay, worst[h]);
+    }
+
+  return result;
+}
+
+Result
+Run (bool migrate, uint32_t aps, double spacing, double speed, double rate, Time window)
+{
+  apsBySsid.clear ();
+  lastSsid.clear ();
+  lastAp = Address ();
+  handoffs.clear ();
+  predicted = 0;
+
+  // Enough time to cross the row, from the first access point to the last
+  double endTime = 1 + spacing * (aps - 1) / speed;
+
+  NodeContainer server;
+  server.Create (1);
+  NodeContainer apNodes;
+  apNodes.Create (aps);
+  NodeContainer mobile;
+  mobile.Create (1);
+
+  MobilityHelper apMobility;
+  Ptr<ListPositionAllocator> apPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < aps; i++)
+    apPositions->Add (Vector (spacing * i, 0.0, 0.0));
+  apMobility.SetPositionAllocator (apPositions);
+  apMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  apMobility.Install (apNodes);
+
+  MobilityHelper mobileMobility;
+  mobileMobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobileMobility.Install (mobile);
+  mobile.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetPosition (Vector (0.0, 10.0, 0.0));
+  mobile.Get (0)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (speed, 0.0, 0.0));
+
+  // No fading, so the handoffs only depend on the positions
+  WifiHelper wifi;
+  wifi.SetRemoteStationManager ("ns3::ArfWifiManager");
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss ("ns3::ThreeLogDistancePropagationLossModel");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  wifiPhy.Set ("TxPowerStart", DoubleValue (16.0206));
+  wifiPhy.Set ("TxPowerEnd", DoubleValue (16.0206));
+  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+
+  for (uint32_t i = 0; i < aps; i++)
+    {
+      string ssid ("ap-" + boost::lexical_cast<string> (i));
+      apsBySsid[ssid] = apNodes.Get (i);
+      wifiMac.SetType ("ns3::ApWifiMac",
+                       "Ssid", SsidValue (Ssid (ssid)),
+                       "BeaconGeneration", BooleanValue (true),
+                       "BeaconInterval", TimeValue (Seconds (0.102)));
+      wifi.Install (wifiPhy, wifiMac, apNodes.Get (i));
+    }
+
+  wifiMac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (Ssid ("ap-0")),
+                   "ActiveProbing", BooleanValue (true));
+  wifi.Install (wifiPhy, wifiMac, mobile.Get (0));
+
+  nnn::FlexPointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("5ms"));
+  for (uint32_t i = 0; i < aps; i++)
+    p2p.Install (server.Get (0), apNodes.Get (i));
+
+  nnn::NNNStackHelper serverStack;
+  serverStack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "3NLeasetime", "120s");
+  serverStack.SetContentStore ("ns3::ndn::cs::Nocache");
+  serverStack.SetDefaultRoutes (true);
+  serverStack.Install (server);
+  server.Get (0)->GetObject<nnn::ForwardingStrategy> ()
+      ->SetNode3NName (Create<nnn::NNNAddress> ("a"), Seconds (endTime + 5), true);
+
+  nnn::NNNStackHelper apStack;
+  apStack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "3NLeasetime", "80s",
+                                 "BufferMigration", migrate ? "true" : "false");
+  apStack.SetContentStore ("ns3::ndn::cs::Nocache");
+  apStack.SetDefaultRoutes (true);
+  apStack.Install (apNodes);
+  for (uint32_t i = 0; i < aps; i++)
+    Simulator::ScheduleNow (&nnn::ForwardingStrategy::Enroll, apNodes.Get (i)->GetObject<nnn::ForwardingStrategy> ());
+
+  nnn::NNNStackHelper mobileStack;
+  mobileStack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "Produce3Nnames", "false");
+  mobileStack.SetContentStore ("ns3::ndn::cs::Nocache");
+  mobileStack.SetDefaultRoutes (true);
+  mobileStack.Install (mobile);
+
+  // The consumer predicts in both runs, only the access routers differ
+  Ptr<nnn::HandoffPredictor> predictor = CreateObject<nnn::HandoffPredictor> ();
+  for (uint32_t i = 0; i < aps; i++)
+    predictor->AddAccessPoint (apNodes.Get (i));
+  mobile.Get (0)->AggregateObject (predictor);
+
+  nnn::AppHelper producerHelper ("ns3::nnn::Producer");
+  producerHelper.SetPrefix ("/waseda/sato");
+  producerHelper.SetAttribute ("PayloadSize", UintegerValue (1024));
+  producerHelper.Install (server);
+
+  nnn::AppHelper consumerHelper ("ns3::nnn::ConsumerCbr");
+  consumerHelper.SetPrefix ("/waseda/sato");
+  consumerHelper.SetAttribute ("Frequency", DoubleValue (rate));
+  consumerHelper.SetAttribute ("StartTime", TimeValue (Seconds (1)));
+  consumerHelper.SetAttribute ("StopTime", TimeValue (Seconds (endTime)));
+  consumerHelper.SetAttribute ("RetxTimer", TimeValue (MilliSeconds (50)));
+  consumerHelper.SetAttribute ("IsMobile", BooleanValue (true));
+  consumerHelper.Install (mobile);
+
+  ostringstream path;
+  path << "/NodeList/" << mobile.Get (0)->GetId () << "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/Assoc";
+  Config::ConnectWithoutContext (path.str (), MakeBoundCallback (&ApAssociation, mobile.Get (0)->GetObject<nnn::ForwardingStrategy> ()));
+
+  Simulator::Schedule (Seconds (0.5), &FollowNearestAp, mobile.Get (0), MilliSeconds (100));
+
+  boost::shared_ptr<ostringstream> trace (new ostringstream ());
+  Ptr<nnn::AppDelayTracer> tracer = nnn::AppDelayTracer::Install (mobile.Get (0), trace);
+  tracer->PrintHeader (*trace);
+  *trace << "\n";
+
+  Simulator::Stop (Seconds (endTime + 1));
+  Simulator::Run ();
+
+  Result result = HandoffDelays (trace->str (), window);
+
+  tracer = 0;
+  Simulator::Destroy ();
+
+  return result;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t aps = 4;
+  double spacing = 50;
+  double speed = 10;
+  double rate = 100;
+  double window = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("aps", "Number of access points in the row", aps);
+  cmd.AddValue ("spacing", "Meters between access points", spacing);
+  cmd.AddValue ("speed", "Meters per second of the consumer", speed);
+  cmd.AddValue ("rate", "Interests per second of the consumer", rate);
+  cmd.AddValue ("window", "Seconds after each handoff in which delays are taken", window);
+  cmd.Parse (argc, argv);
+
+  Result buffered = Run (false, aps, spacing, speed, rate, Seconds (window));
+  Result migrated = Run (true, aps, spacing, speed, rate, Seconds (window));
+
+  cout << "Run\tHandoffs\tPredicted\tData\tMean handoff delay (s)\tMax handoff delay (s)" << endl;
+  cout << "Buffered\t" << buffered.handoffs << "\t" << buffered.predicted << "\t" << buffered.data
+      << "\t" << buffered.meanDelay << "\t" << buffered.maxDelay << endl;
+  cout << "Migrated\t" << migrated.handoffs << "\t" << migrated.predicted << "\t" << migrated.data
+      << "\t" << migrated.meanDelay << "\t" << migrated.maxDelay << endl;
+
+  if (buffered.handoffs != aps - 1 || migrated.handoffs != aps - 1)
+    {
+      cout << "ERROR: expected " << aps - 1 << " handoffs" << endl;
+      errors++;
+    }
+
+  if (migrated.meanDelay >= buffered.meanDelay)
+    {
+      cout << "ERROR: migrating the buffer did not shorten the handoff delay" << endl;
+      errors++;
+    }
+
+  if (errors == 0)
+    cout << "Migration cut the mean handoff delay by "
+	<< 1000 * (buffered.meanDelay - migrated.meanDelay) << " ms" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
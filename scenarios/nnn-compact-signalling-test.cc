@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-compact-signalling-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-compact-signalling-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-compact-signalling-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Encodes the mobility signalling of a node with one to eight PoAs (EN,
+ *  AEN, REN, DEN, OEN and INF) as version A_NNN and as version B_NNN,
+ *  which carries PoA lists and names in the compact encoding, and prints
+ *  the bytes on the wire of both. The compact PDUs have to be smaller,
+ *  and decode to PDUs that encode as A_NNN to the same bytes as the
+ *  originals.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+
+vector<uint8_t>
+Bytes (Ptr<const Packet> packet)
+{
+  vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+  return bytes;
+}
+
+// Encodes pdu in both versions and checks the compact one decodes back
+template <class Codec>
+void
+Compare (const string &what, uint32_t poas, Ptr<typename Codec::PDU> pdu)
+{
+  pdu->SetVersion (A_NNN);
+  vector<uint8_t> full = Bytes (Codec::ToWire (pdu));
+
+  pdu->SetVersion (B_NNN);
+  Ptr<Packet> compact = Codec::ToWire (pdu);
+  uint32_t compactSize = compact->GetSize ();
+
+  Ptr<typename Codec::PDU> decoded = Codec::FromWire (compact);
+  bool same = decoded->GetVersion () == B_NNN;
+  decoded->SetVersion (A_NNN);
+  same = same && Bytes (Codec::ToWire (decoded)) == full;
+
+  cout << what << "\t" << poas << "\t" << full.size () << "\t" << compactSize << "\t"
+      << 100 - 100 * compactSize / full.size () << "%" << endl;
+
+  if (!same)
+    {
+      cout << "ERROR: compact " << what << " with " << poas << " PoAs does not decode to the same PDU" << endl;
+      errors++;
+    }
+  if (compactSize >= full.size ())
+    {
+      cout << "ERROR: compact " << what << " with " << poas << " PoAs is not smaller" << endl;
+      errors++;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t maxPoas = 8;
+
+  CommandLine cmd;
+  cmd.AddValue ("maxPoas", "Largest number of PoAs of the node (starting at 1, times 2 each step)", maxPoas);
+  cmd.Parse (argc, argv);
+
+  // The node and the names it is renamed to share their first components
+  Ptr<NNNAddress> name = Create<NNNAddress> ("1.2.3f.4a");
+  Ptr<NNNAddress> newName = Create<NNNAddress> ("1.2.3f.4b");
+  Ptr<NNNAddress> parent = Create<NNNAddress> ("1.2.3f");
+  Time ttl = Seconds (3);
+  Time lease = Seconds (300);
+
+  cout << "PDU\tPoAs\tFull (bytes)\tCompact (bytes)\tSaved" << endl;
+
+  for (uint32_t n = 1; n <= maxPoas; n *= 2)
+    {
+      // Interfaces of one device, consecutive MAC addresses
+      vector<Address> poas;
+      for (uint32_t k = 0; k < n; k++)
+	poas.push_back (Mac48Address::Allocate ());
+
+      Ptr<EN> en_p = Create<EN> ();
+      en_p->SetLifetime (ttl);
+      en_p->AddPoa (poas);
+      Compare<wire::nnnSIM::EN> ("EN", n, en_p);
+
+      Ptr<AEN> aen_p = Create<AEN> (*name);
+      aen_p->SetLifetime (ttl);
+      aen_p->SetLeasetime (lease);
+      aen_p->AddPoa (poas);
+      Compare<wire::nnnSIM::AEN> ("AEN", n, aen_p);
+
+      Ptr<REN> ren_p = Create<REN> ();
+      ren_p->SetLifetime (ttl);
+      ren_p->SetName (name);
+      ren_p->SetRemainLease (lease);
+      ren_p->AddPoa (poas);
+      Compare<wire::nnnSIM::REN> ("REN", n, ren_p);
+
+      Ptr<DEN> den_p = Create<DEN> ();
+      den_p->SetLifetime (ttl);
+      den_p->SetName (name);
+      den_p->AddPoa (poas);
+      Compare<wire::nnnSIM::DEN> ("DEN", n, den_p);
+
+      Ptr<OEN> oen_p = Create<OEN> (*newName);
+      oen_p->SetLifetime (ttl);
+      oen_p->SetLeasetime (lease);
+      oen_p->SetSrcName (parent);
+      oen_p->AddPoa (poas);
+      oen_p->AddPersonalPoa (poas);
+      Compare<wire::nnnSIM::OEN> ("OEN", n, oen_p);
+
+      Ptr<INF> inf_p = Create<INF> ();
+      inf_p->SetLifetime (ttl);
+      inf_p->SetOldName (name);
+      inf_p->SetNewName (newName);
+      inf_p->SetRemainLease (lease);
+      Compare<wire::nnnSIM::INF> ("INF", n, inf_p);
+    }
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "Compact signalling is smaller and decodes to the same PDUs" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-fib-remove-face-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-fib-remove-face-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-fib-remove-face-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Fills the FIB of a node with routes through two Faces, then removes
+ *  the Faces through L3Protocol::RemoveFace and checks that the FIB no
+ *  longer uses them: entries that only went through a removed Face are
+ *  gone, and the others keep their remaining next hops.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <string>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+#include <ns3-dev/ns3/ndn-name.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+
+void
+Check (bool ok, const string &what)
+{
+  if (!ok)
+    {
+      cout << "ERROR: " << what << endl;
+      errors++;
+    }
+}
+
+// Number of next hops of the FIB entry for prefix, 0 if there is none
+uint32_t
+NextHops (Ptr<Fib> fib, const string &prefix)
+{
+  Ptr<fib::Entry> entry = fib->Find (ndn::Name (prefix));
+  return entry == 0 ? 0 : entry->m_faces.size ();
+}
+
+int main (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (3);
+  FlexPointToPointHelper p2p;
+  NetDeviceContainer first = p2p.Install (nodes.Get (0), nodes.Get (1));
+  NetDeviceContainer second = p2p.Install (nodes.Get (0), nodes.Get (2));
+
+  NNNStackHelper stack;
+  stack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "Produce3Nnames", "false");
+  stack.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  Ptr<L3Protocol> nnn = node->GetObject<L3Protocol> ();
+  Ptr<Fib> fib = node->GetObject<Fib> ();
+  Ptr<Face> face1 = nnn->GetFaceByNetDevice (first.Get (0));
+  Ptr<Face> face2 = nnn->GetFaceByNetDevice (second.Get (0));
+
+  fib->Add (ndn::Name ("/a"), face1, 1);
+  fib->Add (ndn::Name ("/b"), face1, 1);
+  fib->Add (ndn::Name ("/b"), face2, 2);
+  fib->Add (ndn::Name ("/c"), face2, 1);
+  fib->Add (ndn::Name ("/d"), face1, 1);
+  fib->Add (ndn::Name ("/d"), face2, 1);
+  Check (fib->GetSize () == 4, "FIB not filled");
+
+  // A next hop removed from the entry itself no longer ties it to the Face
+  fib->Find (ndn::Name ("/d"))->RemoveFace (face2);
+
+  nnn->RemoveFace (face1);
+  Check (NextHops (fib, "/a") == 0, "/a still goes through the removed Face");
+  Check (NextHops (fib, "/b") == 1, "/b lost the next hop through the remaining Face");
+  Check (fib->Find (ndn::Name ("/b"))->m_faces.begin ()->GetFace () == face2, "/b does not go through the remaining Face");
+  Check (NextHops (fib, "/c") == 1, "/c changed by the removal of a Face it does not use");
+  Check (NextHops (fib, "/d") == 0, "/d still goes through the removed Face");
+  Check (fib->GetSize () == 2, "FIB entries left without next hops");
+
+  nnn->RemoveFace (face2);
+  Check (fib->GetSize () == 0, "FIB not empty once all the Faces are removed");
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "Removing a Face cleared it from the FIB" << endl;
+  else
+    cout << errors << " checks failed" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -62,6 +62,7 @@
 #include "nnnSIM/utils/tracers/nnn-l3-rate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-l3-aggregate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-app-delay-tracer.h"
+#include "nnnSIM/utils/tracers/nnn-signalling-tracer.h"
 
 using namespace ns3;
 using namespace boost;
@@ -293,6 +294,7 @@ int main (int argc, char *argv[])
   double retxtime = 0.05;                       // How frequent Interest retransmission timeouts should be checked (seconds)
   int csSize = 10000000;                        // How big the Content Store should be
   bool use3N = false;                           // Flags use of 3N based scenario
+  bool compact = false;                         // Sends 3N signalling with compact PoA lists and names
   bool useNDN = false;                          // Flags use of NDN based scenario
   bool producer = false;                        // Tells to run the simulation with the Provider moving
   double initialWait = 10;                      // How much time we should wait to start the simulation (Mostly to deal with 3N naming)
@@ -311,10 +313,13 @@ int main (int argc, char *argv[])
   cmd.AddValue ("retx", "How frequent Interest retransmission timeouts should be checked in seconds", retxtime);
   cmd.AddValue ("speed", "How fast in m/s the mobile node should go in X axis", speed);
   cmd.AddValue ("3n", "Uses 3N scenario", use3N);
+  cmd.AddValue ("compact", "Uses the compact PoA and name encoding (version B_NNN) for 3N signalling", compact);
   cmd.AddValue ("ndn", "Uses NDN scenario", useNDN);
   cmd.AddValue ("producer", "Makes the scenario with the Producer moving. By default it is the Consumer", producer);
   cmd.Parse (argc,argv);
 
+  Config::SetDefault ("ns3::nnn::ForwardingStrategy::CompactSignalling", BooleanValue (compact));
+
   if (! (use3N || useNDN))
     {
       cerr << "ERROR: Must choose a network type to test!" << endl;
@@ -909,6 +914,19 @@ int main (int argc, char *argv[])
   NS_LOG_INFO ("------Ready for execution!------");
 
   Simulator::Stop (Seconds (endTime));
+
+  // Signalling overhead of 3N, to compare runs with and without compact
+  Ptr<nnn::SignallingTracer> signalling;
+  if (use3N)
+    signalling = nnn::SignallingTracer::InstallAll ();
+
   Simulator::Run ();
+
+  if (use3N)
+    {
+      std::cout << "3N signalling bytes on the wire (" << (compact ? "compact" : "full") << " encoding)" << std::endl;
+      signalling->Print (std::cout);
+    }
+
   Simulator::Destroy ();
 }
@@ -0,0 +1,314 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-limits-mobility-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-limits-mobility-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-limits-mobility-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  An access router forwards the Interests of its mobile consumers up a
+ *  Face with limits, and holds the Data for the consumers that sent a DEN
+ *  in its PDUBuffer until their INF arrives. The same recorded trace,
+ *  with mass handoffs of all the consumers, is replayed with
+ *  ns3::nnn::Limits::Window and with ns3::nnn::Limits::Mobility on the
+ *  Face. Mobility has to keep the PDUBuffer smaller, and drop to one
+ *  Interest when the NNST marks the next hop RED.
+ */
+
+// Standard C++ modules
+#include <algorithm>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/buffers/nnn-pdu-buffer.h"
+#include "nnnSIM/model/nnst/nnn-nnst.h"
+#include "nnnSIM/utils/nnn-limits-mobility.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+// One line of a recorded trace: an Interest, a DEN or an INF of a consumer
+struct Step
+{
+  enum What { INTEREST, DEN, INF };
+
+  Time at;
+  uint32_t consumer;
+  What what;
+};
+
+/**
+ * Access router with one upstream Face. Admitted Interests come back as
+ * Data one RTT later, and are buffered if their consumer is moving.
+ */
+class AccessRouter
+{
+public:
+  AccessRouter (Ptr<Limits> limits, uint32_t consumers, Time rtt)
+  : m_limits (limits)
+  , m_buffer (CreateObject<PDUBuffer> ())
+  , m_rtt (rtt)
+  , m_peak (0)
+  , m_delivered (0)
+  , m_flushed (0)
+  , m_denied (0)
+  {
+    for (uint32_t c = 0; c < consumers; c++)
+      {
+	ostringstream name;
+	name << "1." << hex << c + 1;
+	m_names.push_back (Create<NNNAddress> (name.str ()));
+      }
+
+    // As the ForwardingStrategy does for the Limits of its Faces
+    m_buffer->TraceConnectWithoutContext ("Buffered", MakeCallback (&AccessRouter::Buffered, this));
+  }
+
+  void
+  Replay (const vector<Step> &trace)
+  {
+    for (size_t i = 0; i < trace.size (); i++)
+      {
+	if (trace[i].what == Step::INTEREST)
+	  Simulator::Schedule (trace[i].at, &AccessRouter::Interest, this, trace[i].consumer);
+	else if (trace[i].what == Step::DEN)
+	  Simulator::Schedule (trace[i].at, &AccessRouter::Leave, this, trace[i].consumer);
+	else
+	  Simulator::Schedule (trace[i].at, &AccessRouter::Arrive, this, trace[i].consumer);
+      }
+  }
+
+  uint32_t GetPeak () const { return m_peak; }
+  uint32_t GetDelivered () const { return m_delivered; }
+  uint32_t GetFlushed () const { return m_flushed; }
+  uint32_t GetDenied () const { return m_denied; }
+
+private:
+  void
+  Interest (uint32_t consumer)
+  {
+    if (!m_limits->IsBelowLimit ())
+      {
+	m_denied++;
+	return;
+      }
+
+    m_limits->BorrowLimit ();
+    Simulator::Schedule (m_rtt, &AccessRouter::Data, this, consumer);
+  }
+
+  void
+  Data (uint32_t consumer)
+  {
+    m_limits->ReturnLimit ();
+
+    if (m_buffer->DestinationExists (m_names[consumer]))
+      {
+	Ptr<DO> do_p = Create<DO> ();
+	do_p->SetName (*m_names[consumer]);
+	do_p->SetPayload (Create<Packet> (1024));
+	m_buffer->PushDO (m_names[consumer], do_p);
+      }
+    else
+      m_delivered++;
+  }
+
+  void
+  Leave (uint32_t consumer)
+  {
+    m_limits->NotifyHandoff ();
+    m_buffer->AddDestination (m_names[consumer]);
+  }
+
+  void
+  Arrive (uint32_t consumer)
+  {
+    m_limits->NotifyHandoff ();
+
+    if (m_buffer->DestinationExists (m_names[consumer]))
+      {
+	m_flushed += m_buffer->PopQueue (m_names[consumer]).size ();
+	m_buffer->RemoveDestination (m_names[consumer]);
+      }
+  }
+
+  void
+  Buffered (uint32_t oldValue, uint32_t newValue)
+  {
+    m_limits->NotifyBufferOccupancy (newValue);
+    m_peak = std::max (m_peak, newValue);
+  }
+
+  Ptr<Limits> m_limits;
+  Ptr<PDUBuffer> m_buffer;
+  vector<Ptr<NNNAddress> > m_names;
+  Time m_rtt;
+  uint32_t m_peak;
+  uint32_t m_delivered;
+  uint32_t m_flushed;
+  uint32_t m_denied;
+};
+
+bool
+EarlierStep (const Step &a, const Step &b)
+{
+  return a.at < b.at;
+}
+
+// Poisson Interests from every consumer, and every period all the
+// consumers move within spread, each one taking handoff to send its INF
+vector<Step>
+Record (uint32_t consumers, double rate, double duration, double period,
+        double spread, double handoff)
+{
+  ExponentialVariable interest (1.0 / rate);
+  UniformVariable leave (0, spread);
+
+  vector<Step> trace;
+  for (uint32_t c = 0; c < consumers; c++)
+    {
+      double now = 0;
+      while ((now += interest.GetValue ()) < duration)
+	{
+	  Step step = { Seconds (now), c, Step::INTEREST };
+	  trace.push_back (step);
+	}
+
+      for (double mass = period; mass + spread + handoff < duration; mass += period)
+	{
+	  double at = mass + leave.GetValue ();
+	  Step den = { Seconds (at), c, Step::DEN };
+	  Step inf = { Seconds (at + handoff), c, Step::INF };
+	  trace.push_back (den);
+	  trace.push_back (inf);
+	}
+    }
+
+  std::stable_sort (trace.begin (), trace.end (), EarlierStep);
+  return trace;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t consumers = 20;
+  double rate = 100;
+  double duration = 30;
+  double period = 10;
+  double spread = 0.1;
+  double handoff = 0.5;
+  double maxRate = 1000;
+  double rtt = 0.1;
+
+  CommandLine cmd;
+  cmd.AddValue ("consumers", "Number of mobile consumers behind the access router", consumers);
+  cmd.AddValue ("rate", "Interests per second of each consumer", rate);
+  cmd.AddValue ("duration", "Seconds of recorded trace", duration);
+  cmd.AddValue ("period", "Seconds between mass handoffs", period);
+  cmd.AddValue ("spread", "Seconds in which all the consumers send their DEN", spread);
+  cmd.AddValue ("handoff", "Seconds between the DEN and the INF of a consumer", handoff);
+  cmd.AddValue ("maxRate", "Interests per second the upstream Face can take", maxRate);
+  cmd.AddValue ("rtt", "Seconds for Data to come back", rtt);
+  cmd.Parse (argc, argv);
+
+  vector<Step> trace = Record (consumers, rate, duration, period, spread, handoff);
+
+  vector<string> classes;
+  classes.push_back ("ns3::nnn::Limits::Window");
+  classes.push_back ("ns3::nnn::Limits::Mobility");
+
+  vector<AccessRouter*> routers;
+  vector<Ptr<Limits> > limits;
+  vector<Ptr<Face> > faces;
+
+  for (size_t i = 0; i < classes.size (); i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      Ptr<Face> face = CreateObject<NetDeviceFace> (node, device);
+
+      ObjectFactory factory;
+      factory.SetTypeId (classes[i]);
+      Ptr<Limits> limit = factory.Create<Limits> ();
+      face->AggregateObject (limit);
+      limit->SetLimits (maxRate, rtt);
+
+      routers.push_back (new AccessRouter (limit, consumers, Seconds (rtt)));
+      routers.back ()->Replay (trace);
+      limits.push_back (limit);
+      faces.push_back (face);
+    }
+
+  Simulator::Stop (Seconds (duration) + Seconds (rtt));
+  Simulator::Run ();
+
+  uint32_t errors = 0;
+
+  cout << "Class\tPeak buffered\tDelivered\tFlushed\tDenied" << endl;
+  for (size_t i = 0; i < classes.size (); i++)
+    {
+      cout << classes[i] << "\t" << routers[i]->GetPeak () << "\t" << routers[i]->GetDelivered ()
+	  << "\t" << routers[i]->GetFlushed () << "\t" << routers[i]->GetDenied () << endl;
+    }
+
+  if (routers[1]->GetPeak () >= routers[0]->GetPeak ())
+    {
+      cout << "ERROR: Limits::Mobility did not keep the PDUBuffer below Limits::Window" << endl;
+      errors++;
+    }
+
+  // The NNST tells the Limits the strategy enforces on the Face when a next
+  // hop it knows goes RED
+  Ptr<NNST> nnst = CreateObject<NNST> ();
+  Ptr<ForwardingStrategy> strategy = CreateObject<ForwardingStrategy> ();
+  strategy->SetAttribute ("Limit", StringValue (classes[1]));
+  nnst->AggregateObject (strategy);
+  nnst->Add (Create<const NNNAddress> ("1"), faces[1], Mac48Address::Allocate (), Simulator::Now () + Seconds (10), 1);
+
+  Ptr<LimitsMobility> mobility = DynamicCast<LimitsMobility> (limits[1]);
+  double window = mobility->GetWindow ();
+  nnst->UpdateStatus (NNNAddress ("2"), faces[1], nnst::FaceMetric::NNN_NNST_RED);
+  if (mobility->GetWindow () != window)
+    {
+      cout << "ERROR: window changed after a next hop not in the NNST went RED" << endl;
+      errors++;
+    }
+
+  nnst->UpdateStatus (NNNAddress ("1"), faces[1], nnst::FaceMetric::NNN_NNST_RED);
+  if (mobility->GetWindow () != 1.0 || mobility->GetCurrentLimit () != 1.0)
+    {
+      cout << "ERROR: window is " << mobility->GetWindow () << " after the next hop went RED" << endl;
+      errors++;
+    }
+
+  for (size_t i = 0; i < routers.size (); i++)
+    delete routers[i];
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "Limits::Mobility bounded the PDUBuffer during " << consumers << " simultaneous handoffs" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
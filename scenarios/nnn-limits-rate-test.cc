@@ -0,0 +1,363 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-limits-rate-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-limits-rate-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-limits-rate-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Replays recorded Interest traces, with changes of the current limit,
+ *  through ns3::nnn::Limits::Rate and through the token bucket it
+ *  replaced, which leaked on a periodic event. Both have to accept and
+ *  deny the same Interests, and fire the available slot callback at the
+ *  same times, also when it is registered after the bucket is full.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/utils/nnn-limits-rate.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+/**
+ * Token bucket of Limits::Rate as it was, leaking on an event every
+ * 1.001/leak rate seconds
+ */
+class PeriodicLimitsRate : public Limits
+{
+public:
+  PeriodicLimitsRate ()
+  : m_bucketMax (0)
+  , m_bucketLeak (1)
+  , m_bucket (0)
+  , m_leaks (0)
+  { }
+
+  virtual void
+  SetLimits (double rate, double delay)
+  {
+    Limits::SetLimits (rate, delay);
+    m_bucketMax = GetMaxRate () * GetMaxDelay ();
+    m_bucketLeak = GetMaxRate ();
+  }
+
+  virtual double
+  GetMaxLimit () const
+  {
+    return GetMaxRate ();
+  }
+
+  virtual void
+  UpdateCurrentLimit (double limit)
+  {
+    m_bucketLeak = std::min (limit, GetMaxRate ());
+    m_bucketMax  = m_bucketLeak * GetMaxDelay ();
+  }
+
+  virtual double
+  GetCurrentLimit () const
+  {
+    return m_bucketLeak;
+  }
+
+  virtual double
+  GetCurrentLimitRate () const
+  {
+    return m_bucketLeak;
+  }
+
+  virtual bool
+  IsBelowLimit ()
+  {
+    if (!IsEnabled ()) return true;
+    return (m_bucketMax - m_bucket >= 1.0);
+  }
+
+  virtual void
+  BorrowLimit ()
+  {
+    if (!IsEnabled ()) return;
+    m_bucket += 1;
+  }
+
+  virtual void
+  ReturnLimit ()
+  {
+  }
+
+  void
+  LeakBucket (double interval)
+  {
+    m_leaks++;
+
+    double bucketOld = m_bucket;
+    m_bucket = std::max (0.0, m_bucket - m_bucketLeak * interval);
+
+    double newInterval = 1.0;
+    if (m_bucketLeak > 1.0)
+      newInterval = 1.001 / m_bucketLeak;
+
+    if (m_bucketMax - bucketOld < 1.0 && m_bucketMax - m_bucket >= 1.0)
+      FireAvailableSlotCallback ();
+
+    Simulator::Schedule (Seconds (newInterval), &PeriodicLimitsRate::LeakBucket, this, newInterval);
+  }
+
+  uint64_t
+  GetLeaks () const
+  {
+    return m_leaks;
+  }
+
+private:
+  double m_bucketMax;
+  double m_bucketLeak;
+  double m_bucket;
+  uint64_t m_leaks;
+};
+
+// One line of a recorded trace: an Interest if limit is negative,
+// otherwise a change of the current limit
+struct Step
+{
+  Time at;
+  double limit;
+};
+
+/**
+ * Sends the Interests of a trace through a Limits, logging what is
+ * accepted and when. Denied Interests wait for an available slot if
+ * wait is set, otherwise they are dropped. With late set, the available
+ * slot callback is only registered once the bucket is full.
+ */
+class Sender
+{
+public:
+  Sender (Ptr<Limits> limits, bool wait, bool late)
+  : m_limits (limits)
+  , m_wait (wait)
+  , m_registered (false)
+  , m_waiting (0)
+  , m_slots (0)
+  {
+    if (m_wait && !late)
+      Register ();
+  }
+
+  void
+  Replay (const vector<Step> &trace)
+  {
+    for (size_t i = 0; i < trace.size (); i++)
+      {
+	if (trace[i].limit < 0)
+	  Simulator::Schedule (trace[i].at, &Sender::Send, this);
+	else
+	  Simulator::Schedule (trace[i].at, &Sender::Update, this, trace[i].limit);
+      }
+  }
+
+  string
+  GetLog () const
+  {
+    return m_log.str ();
+  }
+
+  uint32_t
+  GetSlots () const
+  {
+    return m_slots;
+  }
+
+private:
+  void
+  Register ()
+  {
+    m_limits->RegisterAvailableSlotCallback (MakeCallback (&Sender::SlotAvailable, this));
+    m_registered = true;
+  }
+
+  void
+  Send ()
+  {
+    if (m_waiting == 0 && m_limits->IsBelowLimit ())
+      {
+	m_limits->BorrowLimit ();
+	m_log << Simulator::Now ().GetTimeStep () << "+ ";
+      }
+    else
+      {
+	m_log << Simulator::Now ().GetTimeStep () << "- ";
+	m_waiting++;
+
+	if (m_wait && !m_registered)
+	  Register ();
+      }
+  }
+
+  void
+  Update (double limit)
+  {
+    m_limits->UpdateCurrentLimit (limit);
+  }
+
+  void
+  SlotAvailable ()
+  {
+    m_slots++;
+    m_log << Simulator::Now ().GetTimeStep () << "s ";
+
+    while (m_waiting > 0 && m_limits->IsBelowLimit ())
+      {
+	m_limits->BorrowLimit ();
+	m_log << Simulator::Now ().GetTimeStep () << "w ";
+	m_waiting--;
+      }
+  }
+
+  Ptr<Limits> m_limits;
+  bool m_wait;
+  bool m_registered;
+  uint32_t m_waiting;
+  uint32_t m_slots;
+  ostringstream m_log;
+};
+
+// Poisson Interests at load times the rate, and a new current limit
+// about every second
+vector<Step>
+Record (double rate, double load, double duration)
+{
+  ExponentialVariable interest (1.0 / (rate * load));
+  UniformVariable change (0.5, 1.5);
+
+  vector<Step> trace;
+  double now = 0;
+  double nextChange = 1.0;
+  while (true)
+    {
+      now += interest.GetValue ();
+      if (now >= duration)
+	break;
+
+      if (now >= nextChange)
+	{
+	  Step step = { Seconds (now), rate * change.GetValue () };
+	  trace.push_back (step);
+	  nextChange += 1.0;
+	}
+      else
+	{
+	  Step step = { Seconds (now), -1 };
+	  trace.push_back (step);
+	}
+    }
+  return trace;
+}
+
+int main (int argc, char *argv[])
+{
+  double duration = 10;
+  double delay = 1.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("duration", "Seconds of recorded trace", duration);
+  cmd.AddValue ("delay", "Maximum delay given to SetLimits", delay);
+  cmd.Parse (argc, argv);
+
+  vector<double> rates;
+  rates.push_back (1);
+  rates.push_back (50);
+  rates.push_back (1000);
+
+  vector<double> loads;
+  loads.push_back (0.5);
+  loads.push_back (2);
+
+  vector<Sender*> lazy, periodic;
+  vector<Ptr<PeriodicLimitsRate> > references;
+  vector<string> names;
+
+  for (size_t r = 0; r < rates.size (); r++)
+    for (size_t l = 0; l < loads.size (); l++)
+      for (uint32_t wait = 0; wait < 3; wait++)
+	{
+	  vector<Step> trace = Record (rates[r], loads[l], duration);
+
+	  // Limits::Rate starts once it is on a Face
+	  Ptr<Node> node = CreateObject<Node> ();
+	  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+	  device->SetAddress (Mac48Address::Allocate ());
+	  node->AddDevice (device);
+	  Ptr<Face> face = CreateObject<NetDeviceFace> (node, device);
+
+	  Ptr<LimitsRate> limits = CreateObject<LimitsRate> ();
+	  limits->SetAttribute ("RandomizeLeak", TimeValue (Seconds (0)));
+	  face->AggregateObject (limits);
+	  limits->SetLimits (rates[r], delay);
+
+	  Ptr<PeriodicLimitsRate> reference = CreateObject<PeriodicLimitsRate> ();
+	  reference->SetLimits (rates[r], delay);
+	  Simulator::Schedule (Seconds (0), &PeriodicLimitsRate::LeakBucket, reference, 0.0);
+
+	  // wait 2 registers the available slot callback once the bucket is full
+	  lazy.push_back (new Sender (limits, wait > 0, wait == 2));
+	  periodic.push_back (new Sender (reference, wait > 0, wait == 2));
+	  lazy.back ()->Replay (trace);
+	  periodic.back ()->Replay (trace);
+	  references.push_back (reference);
+
+	  ostringstream name;
+	  name << "rate " << rates[r] << " load " << loads[l]
+	       << (wait == 0 ? " dropping" : wait == 1 ? " waiting" : " waiting, registered late");
+	  names.push_back (name.str ());
+	}
+
+  Simulator::Stop (Seconds (duration));
+  Simulator::Run ();
+
+  uint32_t errors = 0;
+  for (size_t i = 0; i < lazy.size (); i++)
+    {
+      bool same = lazy[i]->GetLog () == periodic[i]->GetLog ();
+      if (!same)
+	errors++;
+
+      cout << (same ? "" : "ERROR: ") << names[i] << ": "
+	  << references[i]->GetLeaks () << " leak events replaced by "
+	  << lazy[i]->GetSlots () << " available slot callbacks" << endl;
+
+      delete lazy[i];
+      delete periodic[i];
+    }
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "Same admission decisions on all " << lazy.size () << " traces" << endl;
+  else
+    cout << errors << " traces with different admission decisions" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-multipath-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-multipath-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-multipath-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Diamond of point-to-point links between a consumer node and a producer
+ *  node, with the NNST of the consumer node holding both middle nodes as
+ *  next hops of the producer's 3N name, and ns3::nnn::fw::RttMultipath on
+ *  every node. The flows have to be split over both paths, move to the
+ *  other path when LinkControlHelper fails one, without the consumers
+ *  losing their Data, and new flows have to use the link again once it is
+ *  back up.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("nnn.MultipathTest");
+
+uint32_t errors = 0;
+
+// Arrival times of what is counted
+vector<Time> viaFirst, viaSecond, data;
+
+void
+InInterest (vector<Time> *times, Ptr<const ndn::Interest> interest, Ptr<const nnn::Face> face)
+{
+  times->push_back (Simulator::Now ());
+}
+
+void
+ReceivedData (Ptr<const ndn::Data> data_p, Ptr<nnn::App> app, Ptr<nnn::Face> face)
+{
+  data.push_back (Simulator::Now ());
+}
+
+uint32_t
+Count (const vector<Time> &times, double from, double to)
+{
+  uint32_t count = 0;
+  for (size_t i = 0; i < times.size (); i++)
+    {
+      if (times[i] >= Seconds (from) && times[i] < Seconds (to))
+	count++;
+    }
+  return count;
+}
+
+// Next hop of the producer's 3N name on from, through the link to
+Ptr<nnn::Face>
+AddRoute (Ptr<Node> from, const NetDeviceContainer &link, const nnn::NNNAddress &name, Time lease)
+{
+  Ptr<NetDevice> local = (link.Get (0)->GetNode () == from) ? link.Get (0) : link.Get (1);
+  Ptr<NetDevice> remote = (local == link.Get (0)) ? link.Get (1) : link.Get (0);
+
+  Ptr<nnn::Face> face = from->GetObject<nnn::L3Protocol> ()->GetFaceByNetDevice (local);
+  from->GetObject<nnn::NNST> ()->Add (name, face, remote->GetAddress (), lease, 1);
+  return face;
+}
+
+void
+InstallConsumers (Ptr<Node> node, const string &group, uint32_t flows, double rate, double start, double stop)
+{
+  for (uint32_t f = 0; f < flows; f++)
+    {
+      ostringstream prefix;
+      prefix << "/" << group << f;
+
+      nnn::AppHelper consumerHelper ("ns3::nnn::ConsumerCbr");
+      consumerHelper.SetPrefix (prefix.str ());
+      consumerHelper.SetAttribute ("Frequency", DoubleValue (rate));
+      consumerHelper.SetAttribute ("StartTime", TimeValue (Seconds (start)));
+      consumerHelper.SetAttribute ("StopTime", TimeValue (Seconds (stop)));
+      consumerHelper.SetAttribute ("RetxTimer", TimeValue (MilliSeconds (100)));
+      ApplicationContainer apps = consumerHelper.Install (node);
+
+      apps.Get (0)->TraceConnectWithoutContext ("ReceivedDatas", MakeCallback (&ReceivedData));
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t flows = 8;
+  double rate = 50;
+  double failAt = 2.5;
+  double upAt = 4.5;
+  double endTime = 7;
+
+  CommandLine cmd;
+  cmd.AddValue ("flows", "Number of consumers started before the failure, and after it", flows);
+  cmd.AddValue ("rate", "Interests per second of each consumer", rate);
+  cmd.AddValue ("failAt", "Second at which the link to the first middle node fails", failAt);
+  cmd.AddValue ("upAt", "Second at which the link comes back", upAt);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (4);
+  Ptr<Node> src = nodes.Get (0);
+  Ptr<Node> first = nodes.Get (1);
+  Ptr<Node> second = nodes.Get (2);
+  Ptr<Node> dst = nodes.Get (3);
+
+  // Both paths alike, so the split only depends on the strategy
+  nnn::FlexPointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  NetDeviceContainer srcFirst = p2p.Install (src, first);
+  NetDeviceContainer srcSecond = p2p.Install (src, second);
+  NetDeviceContainer firstDst = p2p.Install (first, dst);
+  NetDeviceContainer secondDst = p2p.Install (second, dst);
+
+  nnn::NNNStackHelper stack;
+  stack.SetForwardingStrategy ("ns3::nnn::fw::RttMultipath", "Produce3Nnames", "false");
+  stack.SetContentStore ("ns3::ndn::cs::Nocache");
+  stack.SetDefaultRoutes (true);
+  stack.Install (nodes);
+
+  // Fixed 3N names, given once the producer is listening for them
+  const char *names[] = { "a", "b", "c", "d" };
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    Simulator::Schedule (Seconds (0.1), &nnn::ForwardingStrategy::SetNode3NName,
+                         nodes.Get (i)->GetObject<nnn::ForwardingStrategy> (),
+                         Create<const nnn::NNNAddress> (names[i]), Seconds (endTime + 5), true);
+
+  nnn::NNNAddress producerName ("d");
+  Time lease = Seconds (endTime + 5);
+  AddRoute (src, srcFirst, producerName, lease);
+  AddRoute (src, srcSecond, producerName, lease);
+  AddRoute (first, firstDst, producerName, lease);
+  AddRoute (second, secondDst, producerName, lease);
+
+  // The producer answers with its 3N name, the consumers then send DOs to it
+  nnn::AppHelper producerHelper ("ns3::nnn::Producer");
+  producerHelper.SetPrefix ("/");
+  producerHelper.SetAttribute ("PayloadSize", UintegerValue (1024));
+  producerHelper.SetAttribute ("IsMobile", BooleanValue (true));
+  producerHelper.Install (dst);
+
+  InstallConsumers (src, "before", flows, rate, 0.5, upAt + 1.5);
+  InstallConsumers (src, "after", flows, rate, upAt + 0.5, endTime);
+
+  first->GetObject<nnn::ForwardingStrategy> ()
+      ->TraceConnectWithoutContext ("InInterests", MakeBoundCallback (&InInterest, &viaFirst));
+  second->GetObject<nnn::ForwardingStrategy> ()
+      ->TraceConnectWithoutContext ("InInterests", MakeBoundCallback (&InInterest, &viaSecond));
+
+  Simulator::Schedule (Seconds (failAt), &nnn::LinkControlHelper::FailLink, src, first);
+  Simulator::Schedule (Seconds (upAt), &nnn::LinkControlHelper::UpLink, src, first);
+
+  Simulator::Stop (Seconds (endTime));
+  Simulator::Run ();
+
+  // Leave the consumers time to learn the 3N name and the links time to drain
+  double splitFrom = 1, splitTo = failAt;
+  double failedFrom = failAt + 0.1, failedTo = upAt;
+  double recoveredFrom = upAt + 1, recoveredTo = endTime;
+
+  uint32_t split[2] = { Count (viaFirst, splitFrom, splitTo), Count (viaSecond, splitFrom, splitTo) };
+  uint32_t failed[2] = { Count (viaFirst, failedFrom, failedTo), Count (viaSecond, failedFrom, failedTo) };
+  uint32_t recovered[2] = { Count (viaFirst, recoveredFrom, recoveredTo), Count (viaSecond, recoveredFrom, recoveredTo) };
+  uint32_t delivered = Count (data, failedFrom, failedTo);
+  uint32_t expected = flows * rate * (failedTo - failedFrom);
+
+  cout << "Period\tFirst path\tSecond path" << endl;
+  cout << "Both links up\t" << split[0] << "\t" << split[1] << endl;
+  cout << "First link down\t" << failed[0] << "\t" << failed[1] << endl;
+  cout << "First link back\t" << recovered[0] << "\t" << recovered[1] << endl;
+  cout << "Data while down\t" << delivered << " of " << expected << endl;
+  cout << "Flows held\t" << DynamicCast<nnn::fw::RttMultipath> (src->GetObject<nnn::ForwardingStrategy> ())->GetNFlows () << endl;
+
+  uint32_t total = split[0] + split[1];
+  if (total == 0 || split[0] < total / 4 || split[1] < total / 4)
+    {
+      cout << "ERROR: Interests were not split over both paths" << endl;
+      errors++;
+    }
+
+  if (failed[0] != 0 || failed[1] == 0)
+    {
+      cout << "ERROR: Interests did not move to the second path after the failure" << endl;
+      errors++;
+    }
+
+  if (delivered < 0.9 * expected)
+    {
+      cout << "ERROR: the consumers lost Data while the first link was down" << endl;
+      errors++;
+    }
+
+  if (recovered[0] == 0)
+    {
+      cout << "ERROR: no new flow used the first path once it was back" << endl;
+      errors++;
+    }
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "RttMultipath split the flows and recovered from the link failure" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
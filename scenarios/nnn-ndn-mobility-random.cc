@@ -24,6 +24,7 @@
 // Standard C++ modules
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <iterator>
@@ -65,6 +66,7 @@
 #include "nnnSIM/utils/tracers/nnn-l3-rate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-l3-aggregate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-app-delay-tracer.h"
+#include "nnnSIM/utils/tracers/nnn-signalling-tracer.h"
 
 using namespace ns3;
 using namespace boost;
@@ -297,7 +299,9 @@ int main (int argc, char *argv[])
   //double deltaTime = 10;
   std::string nsTFile;                          // Name of the NS Trace file to use
   char nsTDir[250] = "./Waypoints";           // Directory for the waypoint files
+  char wpFile[250] = "";                        // Compiled waypoint file, replaces the NS trace file
   bool use3N = false;
+  bool compact = false;
   bool useNDN = false;
 
   // Variable for buffer
@@ -320,10 +324,14 @@ int main (int argc, char *argv[])
   cmd.AddValue ("size", "Content size in MB (-1 is for no limit)", contentSize);
   cmd.AddValue ("retx", "How frequent Interest retransmission timeouts should be checked in seconds", retxtime);
   cmd.AddValue ("traceFile", "Directory containing Ns2 movement trace files (Usually created by Bonnmotion)", nsTDir);
+  cmd.AddValue ("waypoints", "Compiled waypoint file (created by random/ns2-waypoint-compiler) to use instead of the Ns2 trace", wpFile);
   cmd.AddValue ("3n", "Uses 3N scenario", use3N);
+  cmd.AddValue ("compact", "Uses the compact PoA and name encoding (version B_NNN) for 3N signalling", compact);
   cmd.AddValue ("useNDN", "Uses NDN scenario", useNDN);
   cmd.Parse (argc,argv);
 
+  Config::SetDefault ("ns3::nnn::ForwardingStrategy::CompactSignalling", BooleanValue (compact));
+
   if (! (car || walk))
     {
       cerr << "ERROR: Must choose a speed for random walk!" << endl;
@@ -612,11 +620,22 @@ int main (int argc, char *argv[])
   NS_LOG_INFO ("------Placing mobile node and determining direction and speed------");
   MobilityHelper mobileStations;
 
-  sprintf(buffer, "Reading NS trace file %s", nsTFile.c_str());
-  NS_LOG_INFO(buffer);
+  if (strlen (wpFile) > 0)
+    {
+      sprintf(buffer, "Mapping compiled waypoint file %s", wpFile);
+      NS_LOG_INFO(buffer);
+
+      nnn::WaypointStreamHelper wps = nnn::WaypointStreamHelper (wpFile);
+      wps.Install ();
+    }
+  else
+    {
+      sprintf(buffer, "Reading NS trace file %s", nsTFile.c_str());
+      NS_LOG_INFO(buffer);
 
-  Ns2MobilityHelper ns2 = Ns2MobilityHelper (nsTFile);
-  ns2.Install ();
+      Ns2MobilityHelper ns2 = Ns2MobilityHelper (nsTFile);
+      ns2.Install ();
+    }
 
   // Connect Wireless Nodes to central nodes
   // Because the simulation is using Wifi, PtP connections are 100Mbps
@@ -1049,6 +1068,19 @@ int main (int argc, char *argv[])
   NS_LOG_INFO ("------Ready for execution!------");
 
   Simulator::Stop (Seconds (endTime));
+
+  // Signalling overhead of 3N, to compare runs with and without compact
+  Ptr<nnn::SignallingTracer> signalling;
+  if (use3N)
+    signalling = nnn::SignallingTracer::InstallAll ();
+
   Simulator::Run ();
+
+  if (use3N)
+    {
+      std::cout << "3N signalling bytes on the wire (" << (compact ? "compact" : "full") << " encoding)" << std::endl;
+      signalling->Print (std::cout);
+    }
+
   Simulator::Destroy ();
 }
@@ -64,6 +64,7 @@
 #include "nnnSIM/utils/tracers/nnn-l3-rate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-l3-aggregate-tracer.h"
 #include "nnnSIM/utils/tracers/nnn-app-delay-tracer.h"
+#include "nnnSIM/utils/tracers/nnn-signalling-tracer.h"
 
 using namespace ns3;
 using namespace boost;
@@ -306,6 +307,7 @@ int main (int argc, char *argv[])
   bool smart = false;                   // Tells to run the simulation with SmartFlooding
   bool bestr = false;                   // Tells to run the simulation with BestRoute
   bool use3N = false;                   // Flags use of 3N based scenario
+  bool compact = false;                 // Sends 3N signalling with compact PoA lists and names
   bool useNDN = false;                  // Flags use of NDN based scenario
 
   char results[250] = "results";
@@ -328,11 +330,14 @@ int main (int argc, char *argv[])
   cmd.AddValue ("retx", "How frequent Interest retransmission timeouts should be checked in seconds", retxtime);
   cmd.AddValue ("trace", "Enable trace files", traceFiles);
   cmd.AddValue ("3n", "Uses 3N scenario", use3N);
+  cmd.AddValue ("compact", "Uses the compact PoA and name encoding (version B_NNN) for 3N signalling", compact);
   cmd.AddValue ("ndn", "Uses NDN scenario", useNDN);
   cmd.AddValue ("smart", "Enable SmartFlooding forwarding", smart);
   cmd.AddValue ("bestr", "Enable BestRoute forwarding", bestr);
   cmd.Parse (argc,argv);
 
+  Config::SetDefault ("ns3::nnn::ForwardingStrategy::CompactSignalling", BooleanValue (compact));
+
   if (! (use3N || useNDN))
     {
       std::cerr << "ERROR: Must choose a network type to test!" << std::endl;
@@ -951,6 +956,19 @@ int main (int argc, char *argv[])
   NS_LOG_INFO ("Ready for execution!");
 
   Simulator::Stop (Seconds (28.0));
+
+  // Signalling overhead of 3N, to compare runs with and without compact
+  Ptr<nnn::SignallingTracer> signalling;
+  if (use3N)
+    signalling = nnn::SignallingTracer::InstallAll ();
+
   Simulator::Run ();
+
+  if (use3N)
+    {
+      std::cout << "3N signalling bytes on the wire (" << (compact ? "compact" : "full") << " encoding)" << std::endl;
+      signalling->Print (std::cout);
+    }
+
   Simulator::Destroy ();
 }
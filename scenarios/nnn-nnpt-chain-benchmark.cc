@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-chain-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-chain-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-chain-benchmark.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Measures the cost of resolving the oldest name of a chain of renames
+ *  in the NNPT against the length of the chain, following it one hop at
+ *  a time over the oldname index and with NNPT::findPairedNamePtr, which
+ *  compresses the chain on the way.
+ */
+
+// Standard C++ modules
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-impl.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-entry.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+// Follow the chain one entry at a time, as every lookup used to
+Ptr<const NNNAddress>
+HopByHop (Ptr<nnpt::Ordered> table, Ptr<const NNNAddress> name)
+{
+  nnpt::Ordered::pair_set_by_oldname& pair_index = table->container.get<NNPT::oldname> ();
+  nnpt::Ordered::pair_set_by_oldname::iterator it = pair_index.find (name);
+
+  while (it != pair_index.end ())
+    {
+      name = it->m_newName;
+      it = pair_index.find (name);
+    }
+  return name;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nodes = 1024;
+  uint32_t maxLength = 64;
+  uint32_t lookups = 200000;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of moving nodes, each leaving one chain", nodes);
+  cmd.AddValue ("maxLength", "Longest chain of renames measured", maxLength);
+  cmd.AddValue ("lookups", "Number of lookups for each chain length", lookups);
+  cmd.Parse (argc, argv);
+
+  cout << nodes << " chains, " << lookups << " lookups per length" << endl;
+  cout << "Length\tHop by hop (ns)\tCompressed (ns)" << endl;
+
+  for (uint32_t length = 1; length <= maxLength; length *= 2)
+    {
+      Ptr<nnpt::Ordered> table = Create<nnpt::Ordered> ();
+      vector<Ptr<const NNNAddress> > oldest;
+      uint32_t lease = 0;
+
+      // Names of the form sector.node.move, one chain per node
+      for (uint32_t n = 0; n < nodes; n++)
+	{
+	  vector<Ptr<const NNNAddress> > chain;
+	  for (uint32_t m = 0; m <= length; m++)
+	    {
+	      ostringstream os;
+	      os << hex << (n % 16) << "." << n << "." << m;
+	      chain.push_back (Create<const NNNAddress> (os.str ()));
+	    }
+
+	  // The st_lease index takes only one entry per lease
+	  for (uint32_t m = 0; m < length; m++)
+	    table->addEntry (chain[m], chain[m + 1], Seconds (1000) + NanoSeconds (lease++));
+
+	  oldest.push_back (chain[0]);
+	}
+
+      clock_t start = clock ();
+      for (uint32_t i = 0; i < lookups; i++)
+	HopByHop (table, oldest[i % nodes]);
+      double hop = double (clock () - start) / CLOCKS_PER_SEC;
+
+      start = clock ();
+      for (uint32_t i = 0; i < lookups; i++)
+	table->findPairedNamePtr (oldest[i % nodes]);
+      double compressed = double (clock () - start) / CLOCKS_PER_SEC;
+
+      cout << length << "\t" << 1e9 * hop / lookups << "\t" << 1e9 * compressed / lookups << endl;
+    }
+
+  Simulator::Destroy ();
+
+  return 0;
+}
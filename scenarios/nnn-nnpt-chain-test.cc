@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-chain-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-chain-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-chain-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Builds long chains of renames in the NNPT and checks that every name
+ *  in them resolves to the right latest name, while the chains are
+ *  compressed, extended, cut by deletions and cut by lease expiry, and
+ *  that a deletion keeps the shortcuts of the entries it does not cut.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-entry.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+
+// Every name from first to last (excluded) has to resolve to expected
+void
+CheckChain (Ptr<NNPT> nnpt, const vector<Ptr<const NNNAddress> > &names,
+            uint32_t first, uint32_t last, Ptr<const NNNAddress> expected, const string &step)
+{
+  for (uint32_t i = first; i < last; i++)
+    {
+      Ptr<const NNNAddress> got = nnpt->findPairedNamePtr (names[i]);
+      if (*got != *expected)
+	{
+	  cout << "ERROR: " << step << ": " << *names[i] << " resolved to " << *got << " instead of " << *expected << endl;
+	  errors++;
+	}
+    }
+}
+
+// Run after the entry leaving names[expire] has gone, the chain being
+// already cut at names[cut]
+void
+CheckExpired (Ptr<NNPT> nnpt, const vector<Ptr<const NNNAddress> > *names, uint32_t cut, uint32_t expire)
+{
+  cout << "Checking chain after lease expiry at " << Simulator::Now () << endl;
+
+  CheckChain (nnpt, *names, 0, cut + 1, (*names)[cut], "expiry");
+  // The entries before the expired one now end at it
+  CheckChain (nnpt, *names, cut + 1, expire + 1, (*names)[expire], "expiry");
+  CheckChain (nnpt, *names, expire + 1, names->size () - 1, names->back (), "expiry");
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t length = 64;
+  std::string nnptClass = "ns3::nnn::nnpt::Ordered";
+
+  CommandLine cmd;
+  cmd.AddValue ("length", "Number of renames in the chain", length);
+  cmd.AddValue ("nnpt", "NNPT class to test", nnptClass);
+  cmd.Parse (argc, argv);
+
+  ObjectFactory factory;
+  factory.SetTypeId (nnptClass);
+  Ptr<NNPT> nnpt = factory.Create<NNPT> ();
+
+  vector<Ptr<const NNNAddress> > names;
+  for (uint32_t i = 0; i <= length; i++)
+    {
+      ostringstream os;
+      os << "1." << hex << i;
+      names.push_back (Create<const NNNAddress> (os.str ()));
+    }
+
+  // The st_lease index takes only one entry per lease
+  for (uint32_t i = 0; i < length / 2; i++)
+    nnpt->addEntry (names[i], names[i + 1], Seconds (200 + i));
+
+  cout << "Resolving a chain of " << length / 2 << " renames" << endl;
+  CheckChain (nnpt, names, 0, length / 2, names[length / 2], "first walk");
+  // Now every entry holds a shortcut
+  CheckChain (nnpt, names, 0, length / 2, names[length / 2], "compressed walk");
+
+  cout << "Extending the chain to " << length << " renames" << endl;
+  for (uint32_t i = length / 2; i < length; i++)
+    nnpt->addEntry (names[i], names[i + 1], Seconds (200 + i));
+
+  CheckChain (nnpt, names, 0, length, names[length], "extended walk");
+
+  // Not part of the chain
+  Ptr<const NNNAddress> lone = Create<const NNNAddress> ("2.1");
+  if (*nnpt->findPairedNamePtr (lone) != *lone)
+    {
+      cout << "ERROR: " << *lone << " resolved to something" << endl;
+      errors++;
+    }
+
+  // A second chain, compressed before the first one is cut
+  vector<Ptr<const NNNAddress> > others;
+  for (uint32_t i = 0; i <= 4; i++)
+    {
+      ostringstream os;
+      os << "3." << i;
+      others.push_back (Create<const NNNAddress> (os.str ()));
+    }
+  for (uint32_t i = 0; i < 4; i++)
+    nnpt->addEntry (others[i], others[i + 1], Seconds (300 + i));
+  CheckChain (nnpt, others, 0, 4, others[4], "second chain");
+
+  uint32_t cut = length / 4;
+  cout << "Deleting the rename of " << *names[cut] << endl;
+  nnpt->deleteEntry (names[cut]);
+
+  // Only the entries leading to the deleted one lose their shortcut
+  if (nnpt->findEntry (others[0]).m_latest != others[4] || nnpt->findEntry (names[cut + 1]).m_latest != names[length])
+    {
+      cout << "ERROR: deletion dropped shortcuts that did not go through " << *names[cut] << endl;
+      errors++;
+    }
+
+  CheckChain (nnpt, names, 0, cut + 1, names[cut], "deletion");
+  CheckChain (nnpt, names, cut + 1, length, names[length], "deletion");
+
+  // Give one of the compressed entries a short lease
+  uint32_t expire = 3 * length / 4;
+  nnpt->updateLeaseTime (names[expire], Seconds (100));
+
+  Simulator::Schedule (Seconds (150), &CheckExpired, nnpt, &names, cut, expire);
+  Simulator::Stop (Seconds (160));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "All " << length << " names resolved correctly" << endl;
+  else
+    cout << errors << " names resolved wrongly" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-conformance-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-conformance-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-conformance-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Runs the same checks over every NNPT implementation (ns3::nnn::nnpt::Ordered
+ *  and ns3::nnn::nnpt::Hashed), looking names up through pointers other than
+ *  the ones stored, and checks that all of them print the same table.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-entry.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+
+void
+Check (bool ok, const string &nnptClass, const string &what)
+{
+  if (!ok)
+    {
+      cout << "ERROR: " << nnptClass << ": " << what << endl;
+      errors++;
+    }
+}
+
+// Fresh copy of a name, so lookups never match by pointer
+Ptr<const NNNAddress>
+Name (const string &name)
+{
+  return Create<const NNNAddress> (name);
+}
+
+void
+CheckPairs (Ptr<NNPT> nnpt, const string &nnptClass)
+{
+  nnpt->addEntry (Name ("1.1"), Name ("1.2"), Seconds (50));
+  nnpt->addEntry (Name ("2.1"), Name ("2.2"), Seconds (51));
+
+  Check (nnpt->size () == 2, nnptClass, "size after two insertions");
+  Check (nnpt->foundOldName (Name ("1.1")), nnptClass, "old name 1.1 not found");
+  Check (!nnpt->foundOldName (Name ("1.2")), nnptClass, "new name 1.2 found as old name");
+  Check (nnpt->foundNewName (Name ("2.2")), nnptClass, "new name 2.2 not found");
+  Check (!nnpt->foundNewName (Name ("2.1")), nnptClass, "old name 2.1 found as new name");
+  Check (nnpt->findPairedName (Name ("2.1")) == NNNAddress ("2.2"), nnptClass, "2.1 not paired with 2.2");
+  Check (nnpt->findPairedOldName (Name ("1.2")) == NNNAddress ("1.1"), nnptClass, "1.2 not paired with 1.1");
+  Check (nnpt->findPairedName (Name ("3.1")) == NNNAddress ("3.1"), nnptClass, "unknown name 3.1 not returned as is");
+  Check (nnpt->findNameExpireTime (Name ("2.1")) == Seconds (51), nnptClass, "lease of 2.1");
+
+  // Neither name may already be an old name
+  nnpt->addEntry (Name ("1.1"), Name ("1.3"), Seconds (52));
+  nnpt->addEntry (Name ("3.1"), Name ("2.1"), Seconds (53));
+  Check (nnpt->size () == 2, nnptClass, "rename of a name already renamed accepted");
+
+  nnpt->deleteEntry (Name ("2.1"), Name ("1.2"));
+  Check (nnpt->size () == 2, nnptClass, "deletion of a pair that is not there");
+  nnpt->deleteEntry (Name ("2.1"), Name ("2.2"));
+  Check (!nnpt->foundOldName (Name ("2.1")), nnptClass, "2.1 left after deleting its pair");
+  nnpt->deleteEntry (Name ("1.1"));
+  Check (nnpt->isEmpty (), nnptClass, "not empty after deleting everything");
+}
+
+void
+CheckChains (Ptr<NNPT> nnpt, const string &nnptClass)
+{
+  // 4.0 -> 4.1 -> ... -> 4.8
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      ostringstream from, to;
+      from << "4." << i;
+      to << "4." << i + 1;
+      nnpt->addEntry (Name (from.str ()), Name (to.str ()), Seconds (60 + i));
+    }
+
+  for (uint32_t pass = 0; pass < 2; pass++)
+    Check (nnpt->findPairedName (Name ("4.0")) == NNNAddress ("4.8"), nnptClass, "4.0 not resolved to 4.8");
+  Check (nnpt->findPairedOldName (Name ("4.8")) == NNNAddress ("4.0"), nnptClass, "4.8 not traced back to 4.0");
+
+  nnpt->addEntry (Name ("4.8"), Name ("4.9"), Seconds (68));
+  Check (nnpt->findPairedName (Name ("4.0")) == NNNAddress ("4.9"), nnptClass, "compressed chain not extended to 4.9");
+
+  nnpt->deleteEntry (Name ("4.4"));
+  Check (nnpt->findPairedName (Name ("4.0")) == NNNAddress ("4.4"), nnptClass, "chain not cut at 4.4");
+  Check (nnpt->findPairedName (Name ("4.5")) == NNNAddress ("4.9"), nnptClass, "4.5 not resolved to 4.9");
+}
+
+void
+CheckMaxSize (Ptr<NNPT> nnpt, const string &nnptClass)
+{
+  uint32_t before = nnpt->size ();
+  nnpt->SetMaxSize (before - 2);
+
+  // The two nearest leases were 4.0 and 4.1
+  Check (nnpt->size () == before - 2, nnptClass, "size not brought down to MaxSize");
+  Check (!nnpt->foundOldName (Name ("4.0")) && !nnpt->foundOldName (Name ("4.1")), nnptClass, "evicted other than the nearest leases");
+
+  nnpt->addEntry (Name ("5.1"), Name ("5.2"), Seconds (70));
+  Check (nnpt->size () == before - 2, nnptClass, "insertion over MaxSize");
+  Check (nnpt->foundOldName (Name ("5.1")), nnptClass, "new entry evicted");
+
+  nnpt->SetMaxSize (0);
+}
+
+// Run after 4.2 and 4.3 have expired
+void
+CheckExpired (Ptr<NNPT> nnpt, string nnptClass)
+{
+  Check (!nnpt->foundOldName (Name ("4.2")) && !nnpt->foundOldName (Name ("4.3")), nnptClass, "expired entries left");
+  Check (nnpt->foundOldName (Name ("4.5")), nnptClass, "4.5 expired before its lease");
+  Check (nnpt->findPairedName (Name ("4.5")) == NNNAddress ("4.9"), nnptClass, "4.5 not resolved to 4.9 after expiry");
+}
+
+int main (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.Parse (argc, argv);
+
+  vector<string> classes;
+  classes.push_back ("ns3::nnn::nnpt::Ordered");
+  classes.push_back ("ns3::nnn::nnpt::Hashed");
+
+  vector<Ptr<NNPT> > tables;
+  for (size_t i = 0; i < classes.size (); i++)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (classes[i]);
+      Ptr<NNPT> nnpt = factory.Create<NNPT> ();
+      tables.push_back (nnpt);
+
+      cout << "Testing " << classes[i] << endl;
+      CheckPairs (nnpt, classes[i]);
+      CheckChains (nnpt, classes[i]);
+      CheckMaxSize (nnpt, classes[i]);
+
+      Simulator::Schedule (Seconds (64) + MilliSeconds (500), &CheckExpired, nnpt, classes[i]);
+    }
+
+  Simulator::Stop (Seconds (65));
+  Simulator::Run ();
+
+  ostringstream first;
+  first << *tables[0];
+  for (size_t i = 1; i < tables.size (); i++)
+    {
+      ostringstream other;
+      other << *tables[i];
+      Check (first.str () == other.str (), classes[i], "prints a different table than " + classes[0]);
+    }
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "All " << classes.size () << " NNPT implementations conform" << endl;
+  else
+    cout << errors << " checks failed" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-nnpt-index-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-nnpt-index-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-nnpt-index-benchmark.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Compares the NNPT with ordered name indexes (ns3::nnn::nnpt::Ordered)
+ *  and the one with hashed name indexes (ns3::nnn::nnpt::Hashed) at
+ *  10k, 100k and 1M entries: time to fill the table, and time to look
+ *  names up from pointers other than the stored ones, as the PDUs do.
+ */
+
+// Standard C++ modules
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-entry.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+void
+Measure (const string &nnptClass, const vector<Ptr<const NNNAddress> > &oldNames,
+         const vector<Ptr<const NNNAddress> > &newNames, const vector<Ptr<const NNNAddress> > &probes,
+         uint32_t lookups)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (nnptClass);
+  Ptr<NNPT> nnpt = factory.Create<NNPT> ();
+
+  clock_t start = clock ();
+  for (size_t i = 0; i < oldNames.size (); i++)
+    // The st_lease index takes only one entry per lease
+    nnpt->addEntry (oldNames[i], newNames[i], Seconds (1000) + NanoSeconds (i));
+  double fill = double (clock () - start) / CLOCKS_PER_SEC;
+
+  uint32_t found = 0;
+  start = clock ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      // Every other lookup misses
+      if (nnpt->findPairedNamePtr (probes[i % probes.size ()]) != probes[i % probes.size ()])
+	found++;
+    }
+  double lookup = double (clock () - start) / CLOCKS_PER_SEC;
+
+  if (nnpt->size () != oldNames.size () || found != (lookups + 1) / 2)
+    cout << "ERROR: " << nnptClass << " lost entries" << endl;
+
+  cout << nnptClass << "\t" << oldNames.size () << "\t"
+      << 1e9 * fill / oldNames.size () << "\t" << 1e9 * lookup / lookups << endl;
+
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t maxEntries = 1000000;
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("maxEntries", "Largest table measured (starting at 10k, times 10 each step)", maxEntries);
+  cmd.AddValue ("lookups", "Number of lookups for each table", lookups);
+  cmd.Parse (argc, argv);
+
+  cout << "Class\tEntries\tInsert (ns)\tLookup (ns)" << endl;
+
+  for (uint32_t entries = 10000; entries <= maxEntries; entries *= 10)
+    {
+      // Names of the form sector.subsector.node, each node renamed once
+      vector<Ptr<const NNNAddress> > oldNames, newNames, probes;
+      for (uint32_t n = 0; n < entries; n++)
+	{
+	  ostringstream from, to, unknown;
+	  from << hex << (n % 16) << "." << (n % 256) << "." << n;
+	  to << hex << (n % 16) << "." << (n % 256) << "." << n + entries;
+	  unknown << hex << (n % 16) << "." << (n % 256) << "." << n + 2 * entries;
+	  oldNames.push_back (Create<const NNNAddress> (from.str ()));
+	  newNames.push_back (Create<const NNNAddress> (to.str ()));
+	  probes.push_back (Create<const NNNAddress> (from.str ()));
+	  probes.push_back (Create<const NNNAddress> (unknown.str ()));
+	}
+
+      Measure ("ns3::nnn::nnpt::Ordered", oldNames, newNames, probes, lookups);
+      Measure ("ns3::nnn::nnpt::Hashed", oldNames, newNames, probes, lookups);
+    }
+
+  return 0;
+}
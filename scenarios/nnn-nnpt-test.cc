@@ -22,6 +22,7 @@
 // Extensions
 #include "nnnSIM/nnnSIM-module.h"
 #include "nnnSIM/model/nnpt/nnn-nnpt.h"
+#include "nnnSIM/model/nnpt/nnn-nnpt-impl.h"
 #include "nnnSIM/model/nnpt/nnn-nnpt-entry.h"
 
 using namespace ns3;
@@ -31,7 +32,7 @@ using namespace nnpt;
 
 int main (int argc, char *argv[])
 {
-  Ptr<NNPT> test1 = Create<NNPT> ();
+  Ptr<NNPT> test1 = Create<nnpt::Ordered> ();
 
   Ptr<const NNNAddress> nn_test1 = Create<const NNNAddress> ("be.54.32");
   Ptr<const NNNAddress> nn_test2 = Create<const NNNAddress> ("af.67.31");
@@ -109,4 +110,9 @@ int main (int argc, char *argv[])
 
   std::cout << "\"" << *nn_test1 <<"\"'s New address is \"" << test1->findPairedName(nn_test1) << "\"" << std::endl;
 
+  // Entries with the nearest lease are the first to go
+  std::cout << "Limiting NNPT of size " << test1->size() << " to 1 entry" << std::endl;
+  test1->SetMaxSize (1);
+  std::cout << "Printing ordering by lease expire time" << std::endl;
+  test1->printByLease();
 }
@@ -42,6 +42,22 @@ printNNST(Ptr<NNST> nnst)
   std::cout << *nnst << std::endl;
 }
 
+void
+printEvictions (uint32_t oldValue, uint32_t newValue)
+{
+  std::cout << "NNST evictions went from " << oldValue << " to " << newValue << " at " << Simulator::Now() << std::endl;
+}
+
+void
+limitNNST (Ptr<NNST> nnst, uint32_t maxSize)
+{
+  std::cout << "Limiting NNST of size " << nnst->GetSize () << " to " << maxSize << " entries at " << Simulator::Now() << std::endl;
+
+  nnst->SetMaxSize (maxSize);
+
+  std::cout << *nnst << std::endl;
+}
+
 void
 printAddrs (std::vector<Ptr<const NNNAddress> > ret)
 {
@@ -310,6 +326,10 @@ int main (int argc, char *argv[])
 
   Simulator::Schedule(Seconds(24), &printNNST, ptrn1_nnst);
 
+  // Entries with the nearest lease are the first to go
+  ptrn1_nnst->TraceConnectWithoutContext ("Evictions", MakeCallback (&printEvictions));
+  Simulator::Schedule(Seconds(16), &limitNNST, ptrn1_nnst, 2);
+
   Simulator::Stop (Seconds (25));
   Simulator::Run ();
   Simulator::Destroy ();
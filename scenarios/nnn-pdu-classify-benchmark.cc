@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-pdu-classify-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-pdu-classify-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-pdu-classify-benchmark.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Measures the cost per received PDU of classifying the ten 3N PDU types,
+ *  alone and followed by the decoding Face::Receive does: with the
+ *  classification HeaderHelper had before (4 byte copy, packet streamed to
+ *  the log), reading the bytes of untagged packets, and using the
+ *  PDUTypeTag Wire::From* put on the packets. Run it in optimized and
+ *  debug builds; the build is printed with the results.
+ */
+
+// Standard C++ modules
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+NS_LOG_COMPONENT_DEFINE ("nnn.PDUClassifyBenchmark");
+
+// HeaderHelper::GetNNNHeaderType as it was
+NNN_PDU_TYPE
+LegacyGetNNNHeaderType (Ptr<const Packet> packet)
+{
+  uint8_t type[4];
+  uint32_t read = packet->CopyData (type, 4);
+
+  if (read != 4) throw UnknownHeaderException();
+
+  uint32_t retval = 0;
+  retval |= type[3];
+  retval <<= 8;
+  retval |= type[2];
+  retval <<= 8;
+  retval |= type[1];
+  retval <<= 8;
+  retval |= type[0];
+
+  NS_LOG_DEBUG (*packet);
+
+  if (retval > INF_NNN)
+    throw UnknownHeaderException();
+
+  return static_cast<NNN_PDU_TYPE> (retval);
+}
+
+// What Face::Receive does once the type is known
+bool
+Decode (NNN_PDU_TYPE type, Ptr<Packet> packet)
+{
+  switch (type)
+  {
+    case NULL_NNN:
+      return Wire::ToNULLp (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case SO_NNN:
+      return Wire::ToSO (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case DO_NNN:
+      return Wire::ToDO (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case DU_NNN:
+      return Wire::ToDU (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case EN_NNN:
+      return Wire::ToEN (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case OEN_NNN:
+      return Wire::ToOEN (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case AEN_NNN:
+      return Wire::ToAEN (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case REN_NNN:
+      return Wire::ToREN (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case DEN_NNN:
+      return Wire::ToDEN (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+    case INF_NNN:
+      return Wire::ToINF (packet, Wire::WIRE_FORMAT_NNNSIM) != 0;
+  }
+  return false;
+}
+
+// One packet of every 3N PDU type, as Wire::From* encode them
+vector<Ptr<Packet> >
+Encode ()
+{
+  Address poa = Mac48Address ("01:B2:03:04:05:06");
+  Ptr<NNNAddress> name = Create<NNNAddress> ("ae.34.24");
+  Ptr<NNNAddress> other = Create<NNNAddress> ("45.34.76");
+  Ptr<Packet> payload = Create<Packet> (100);
+  Time ttl = Seconds (20);
+
+  vector<Ptr<Packet> > packets;
+
+  Ptr<NULLp> nullp_p = Create<NULLp> ();
+  nullp_p->SetLifetime (ttl);
+  nullp_p->SetPayload (payload);
+  nullp_p->SetPDUPayloadType (NDN_NNN);
+  packets.push_back (Wire::FromNULLp (nullp_p));
+
+  Ptr<SO> so_p = Create<SO> ();
+  so_p->SetLifetime (ttl);
+  so_p->SetName (name);
+  so_p->SetPayload (payload);
+  so_p->SetPDUPayloadType (NDN_NNN);
+  packets.push_back (Wire::FromSO (so_p));
+
+  Ptr<DO> do_p = Create<DO> ();
+  do_p->SetLifetime (ttl);
+  do_p->SetName (name);
+  do_p->SetPayload (payload);
+  do_p->SetPDUPayloadType (NDN_NNN);
+  packets.push_back (Wire::FromDO (do_p));
+
+  Ptr<DU> du_p = Create<DU> ();
+  du_p->SetLifetime (ttl);
+  du_p->SetSrcName (name);
+  du_p->SetDstName (other);
+  du_p->SetPayload (payload);
+  du_p->SetPDUPayloadType (NDN_NNN);
+  packets.push_back (Wire::FromDU (du_p));
+
+  Ptr<EN> en_p = Create<EN> ();
+  en_p->SetLifetime (ttl);
+  en_p->AddPoa (poa);
+  packets.push_back (Wire::FromEN (en_p));
+
+  Ptr<OEN> oen_p = Create<OEN> ();
+  oen_p->SetLifetime (ttl);
+  oen_p->SetName (name);
+  oen_p->SetLeasetime (Seconds (120));
+  oen_p->AddPoa (poa);
+  oen_p->SetSrcName (other);
+  oen_p->AddPersonalPoa (poa);
+  packets.push_back (Wire::FromOEN (oen_p));
+
+  Ptr<AEN> aen_p = Create<AEN> ();
+  aen_p->SetLifetime (ttl);
+  aen_p->SetName (name);
+  aen_p->SetLeasetime (Seconds (120));
+  aen_p->AddPoa (poa);
+  packets.push_back (Wire::FromAEN (aen_p));
+
+  Ptr<REN> ren_p = Create<REN> ();
+  ren_p->SetLifetime (ttl);
+  ren_p->SetName (name);
+  ren_p->SetRemainLease (Seconds (30));
+  ren_p->AddPoa (poa);
+  packets.push_back (Wire::FromREN (ren_p));
+
+  Ptr<DEN> den_p = Create<DEN> ();
+  den_p->SetLifetime (ttl);
+  den_p->SetName (name);
+  den_p->AddPoa (poa);
+  packets.push_back (Wire::FromDEN (den_p));
+
+  Ptr<INF> inf_p = Create<INF> ();
+  inf_p->SetLifetime (ttl);
+  inf_p->SetOldName (name);
+  inf_p->SetNewName (other);
+  inf_p->SetRemainLease (Seconds (30));
+  packets.push_back (Wire::FromINF (inf_p));
+
+  return packets;
+}
+
+// Received copies of the packets, untagged unless tagged is set
+vector<Ptr<Packet> >
+Receive (const vector<Ptr<Packet> > &packets, uint32_t count, bool tagged)
+{
+  vector<Ptr<Packet> > received;
+  for (uint32_t i = 0; i < count; i++)
+    {
+      Ptr<Packet> packet = packets[i % packets.size ()]->Copy ();
+      if (!tagged)
+	HeaderHelper::UntagNNNHeader (packet);
+      received.push_back (packet);
+    }
+  return received;
+}
+
+enum Method { LEGACY, PEEK, TAG };
+
+// Nanoseconds per PDU to classify, and to classify and decode, the packets
+void
+Measure (const string &what, Method method, const vector<Ptr<Packet> > &packets, uint32_t count)
+{
+  vector<Ptr<Packet> > received = Receive (packets, count, method == TAG);
+  uint32_t types[INF_NNN + 1] = { 0 };
+
+  clock_t start = clock ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      if (method == LEGACY)
+	types[LegacyGetNNNHeaderType (received[i])]++;
+      else
+	types[HeaderHelper::GetNNNHeaderType (received[i])]++;
+    }
+  double classify = double (clock () - start) / CLOCKS_PER_SEC;
+
+  received = Receive (packets, count, method == TAG);
+  uint32_t decoded = 0;
+
+  start = clock ();
+  for (uint32_t i = 0; i < count; i++)
+    {
+      NNN_PDU_TYPE type;
+      if (method == LEGACY)
+	type = LegacyGetNNNHeaderType (received[i]);
+      else
+	{
+	  type = HeaderHelper::GetNNNHeaderType (received[i]);
+	  HeaderHelper::UntagNNNHeader (received[i]);
+	}
+
+      if (Decode (type, received[i]))
+	decoded++;
+    }
+  double receive = double (clock () - start) / CLOCKS_PER_SEC;
+
+  for (uint32_t t = 0; t <= INF_NNN; t++)
+    {
+      if (types[t] != count / packets.size ())
+	cout << "ERROR: " << what << " classified " << types[t] << " PDUs as type " << t << endl;
+    }
+  if (decoded != count)
+    cout << "ERROR: " << what << " decoded " << decoded << " of " << count << " PDUs" << endl;
+
+  cout << what << "\t" << 1e9 * classify / count << "\t" << 1e9 * receive / count << endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t count = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("count", "Number of received PDUs measured, a multiple of 10", count);
+  cmd.Parse (argc, argv);
+
+  vector<Ptr<Packet> > packets = Encode ();
+
+#ifdef NS3_LOG_ENABLE
+  cout << "Debug build (NS_LOG compiled in)" << endl;
+#else
+  cout << "Optimized build (NS_LOG compiled out)" << endl;
+#endif
+
+  cout << "Classification\tClassify (ns)\tClassify and decode (ns)" << endl;
+
+  Measure ("Legacy 4 byte copy", LEGACY, packets, count);
+  Measure ("Peek untagged", PEEK, packets, count);
+  Measure ("PDUTypeTag", TAG, packets, count);
+
+  Simulator::Destroy ();
+
+  return 0;
+}
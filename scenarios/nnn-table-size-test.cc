@@ -0,0 +1,315 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-table-size-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-table-size-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-table-size-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Fills and empties the NNST, NNPT, PIT, PDUBuffer and NamesContainer,
+ *  checking that their Entries and Bytes trace sources follow every
+ *  change and come back to 0, and that the PIT counts the 3N names on
+ *  its incoming faces once each, in every tier, and only counts the
+ *  entries still in it. Then installs a TableSizeTracer on a node with
+ *  the 3N stack and checks that it sees the tables of the node and of
+ *  its ForwardingStrategy, including what they held before.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+#include <ns3-dev/ns3/ndn-interest.h>
+#include <ns3-dev/ns3/ndn-name.h>
+
+#include <boost/shared_ptr.hpp>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/utils/tracers/nnn-table-size-tracer.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+
+void
+Check (bool ok, const string &table, const string &what)
+{
+  if (!ok)
+    {
+      cout << "ERROR: " << table << ": " << what << endl;
+      errors++;
+    }
+}
+
+// Last values of the trace sources of a table
+struct Size
+{
+  uint32_t entries;
+  uint64_t bytes;
+};
+
+void
+Entries (Size *size, uint32_t oldValue, uint32_t newValue)
+{
+  size->entries = newValue;
+}
+
+void
+Bytes (Size *size, uint64_t oldValue, uint64_t newValue)
+{
+  size->bytes = newValue;
+}
+
+void
+Follow (Ptr<Object> table, const string &name, Size *size,
+        const string &entries = "Entries", const string &bytes = "Bytes")
+{
+  size->entries = 0;
+  size->bytes = 0;
+  Check (table->TraceConnectWithoutContext (entries, MakeBoundCallback (&Entries, size)), name, "no " + entries + " trace source");
+  Check (table->TraceConnectWithoutContext (bytes, MakeBoundCallback (&Bytes, size)), name, "no " + bytes + " trace source");
+}
+
+Ptr<const NNNAddress>
+Name (uint32_t n)
+{
+  ostringstream name;
+  name << hex << (n % 4) << "." << n;
+  return Create<const NNNAddress> (name.str ());
+}
+
+Ptr<Face>
+MakeFace ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+  device->SetAddress (Mac48Address::Allocate ());
+  node->AddDevice (device);
+  return CreateObject<NetDeviceFace> (node, device);
+}
+
+void
+CheckNNST (Ptr<Face> face)
+{
+  Ptr<NNST> nnst = CreateObject<NNST> ();
+  Size size;
+  Follow (nnst, "NNST", &size);
+
+  for (uint32_t n = 0; n < 3; n++)
+    nnst->Add (*Name (n), face, Mac48Address::Allocate (), Seconds (100), 1);
+  Check (size.entries == 3 && size.bytes > 0, "NNST", "3 entries not traced");
+  uint64_t three = size.bytes;
+
+  nnst->Remove (Name (0));
+  Check (size.entries == 2 && size.bytes * 3 == three * 2, "NNST", "removal not traced");
+
+  nnst->RemoveFromAll (face);
+  Check (size.entries == 0 && size.bytes == 0, "NNST", "not back to 0 after removing the Face");
+}
+
+void
+CheckNNPT ()
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::nnn::nnpt::Hashed");
+  Ptr<NNPT> nnpt = factory.Create<NNPT> ();
+  Size size;
+  Follow (nnpt, "NNPT", &size);
+
+  nnpt->addEntry (Name (1), Name (2), Seconds (100));
+  nnpt->addEntry (Name (3), Name (4), Seconds (101));
+  Check (size.entries == 2 && size.bytes > 0, "NNPT", "2 entries not traced");
+
+  nnpt->SetMaxSize (1);
+  Check (size.entries == 1, "NNPT", "eviction not traced");
+
+  nnpt->deleteEntry (Name (3));
+  Check (size.entries == 0 && size.bytes == 0, "NNPT", "not back to 0");
+}
+
+void
+CheckNamesContainer ()
+{
+  Ptr<NamesContainer> names = CreateObject<NamesContainer> ();
+  Size size;
+  Follow (names, "NamesContainer", &size);
+
+  names->addEntry (Name (1), Seconds (100), true);
+  names->addEntry (Name (2), Seconds (100), true);
+  Check (size.entries == 2 && size.bytes > 0, "NamesContainer", "2 names not traced");
+
+  names->deleteEntry (Name (1));
+  names->deleteEntry (Name (2));
+  Check (size.entries == 0 && size.bytes == 0, "NamesContainer", "not back to 0");
+}
+
+void
+CheckPDUBuffer ()
+{
+  Ptr<PDUBuffer> buffer = CreateObject<PDUBuffer> ();
+  Size size;
+  Follow (buffer, "PDUBuffer", &size);
+
+  Ptr<NNNAddress> name = ConstCast<NNNAddress> (Name (1));
+  buffer->AddDestination (name);
+  Check (size.entries == 1 && size.bytes > 0, "PDUBuffer", "destination not traced");
+  uint64_t empty = size.bytes;
+
+  Ptr<DO> do_p = Create<DO> ();
+  do_p->SetName (*name);
+  do_p->SetPayload (Create<Packet> (1024));
+  buffer->PushDO (name, do_p);
+  Check (size.bytes > empty + 1024, "PDUBuffer", "bytes of the PDU not traced");
+  uint64_t one = size.bytes;
+
+  buffer->PushDO (name, do_p);
+  Check (size.bytes - one == one - empty, "PDUBuffer", "second PDU not traced as the first one");
+
+  // Reading the queue leaves the PDUs in the buffer
+  buffer->PopQueue (name);
+  Check (size.bytes - one == one - empty, "PDUBuffer", "PopQueue changed the bytes");
+
+  buffer->RemoveDestination (name);
+  Check (size.entries == 0 && size.bytes == 0, "PDUBuffer", "not back to 0");
+}
+
+void
+CheckPit (Ptr<Face> face, Ptr<Face> other)
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::nnn::pit::Persistent");
+  Ptr<Pit> pit = factory.Create<Pit> ();
+  factory.SetTypeId ("ns3::nnn::fib::Default");
+  Ptr<Fib> fib = factory.Create<Fib> ();
+  fib->Add (ndn::Name ("/"), face, 1);
+  pit->AggregateObject (fib);
+  Size entries, names;
+  Follow (pit, "PIT", &entries);
+  Follow (pit, "PIT", &names, "AggregatedNames", "AggregatedBytes");
+
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> ("/table/size"));
+  interest->SetInterestLifetime (Seconds (1));
+
+  Ptr<pit::Entry> entry = pit->Create (interest);
+  Check (entry != 0 && entries.entries == 1 && entries.bytes > 0, "PIT", "entry not traced");
+
+  // Past the inline and flat tiers, into the NNNAddrAggregator
+  uint32_t count = 2 * pit::IncomingFace::FlatSize;
+  for (uint32_t n = 0; n < count; n++)
+    entry->AddIncoming (face, Name (n));
+  entry->AddIncoming (face, Name (0));
+  entry->AddIncoming (other, Name (0));
+  Check (names.entries == count + 1 && names.bytes > 0, "PIT", "3N names not counted once per face");
+
+  for (uint32_t n = 0; n < count; n += 2)
+    entry->RemoveIncoming (face, Name (n));
+  Check (names.entries == count / 2 + 1, "PIT", "removed 3N names not traced");
+
+  entry->RemoveAllReferencesToFace (other);
+  Check (names.entries == count / 2, "PIT", "3N names of a removed Face not traced");
+
+  entry->ClearIncoming ();
+  Check (names.entries == 0 && names.bytes == 0, "PIT", "3N names not back to 0");
+
+  // An entry still referenced after it left the PIT is no longer counted,
+  // the 3N names it holds are until it is gone
+  entry->AddIncoming (face, Name (0));
+  pit->MarkErased (entry);
+  Check (entries.entries == 0 && entries.bytes == 0, "PIT", "erased entry still counted");
+  Check (names.entries == 1, "PIT", "3N names of an erased entry not counted while it is held");
+
+  entry = 0;
+  Check (names.entries == 0 && names.bytes == 0, "PIT", "not back to 0 once the entry is gone");
+}
+
+// The tracer writes to a stream it does not own
+void
+NullDeleter (std::ostream *os)
+{
+}
+
+// Tables of a node with the 3N stack, seen by its TableSizeTracer
+void
+CheckTracer (Ptr<Node> node, Ptr<TableSizeTracer> tracer)
+{
+  Check (tracer->GetEntries ("NodeNames") == 1 && tracer->GetBytes ("NodeNames") > 0, "TableSizeTracer", "3N name of the node not seen");
+  Check (tracer->GetEntries ("NNST") == node->GetObject<NNST> ()->GetSize (), "TableSizeTracer", "NNST route not seen");
+  Check (tracer->GetEntries ("PDUBuffer") == 1, "TableSizeTracer", "PDUBuffer destination added before the tracer not seen");
+  Check (tracer->GetEntries ("LeasedNames") == 0, "TableSizeTracer", "leased names seen on a node that leased none");
+}
+
+int main (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.Parse (argc, argv);
+
+  Ptr<Face> face = MakeFace ();
+  Ptr<Face> other = MakeFace ();
+
+  CheckNNST (face);
+  CheckNNPT ();
+  CheckNamesContainer ();
+  CheckPDUBuffer ();
+  CheckPit (face, other);
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  FlexPointToPointHelper p2p;
+  NetDeviceContainer link = p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  NNNStackHelper stack;
+  stack.SetForwardingStrategy ("ns3::nnn::ForwardingStrategy", "Produce3Nnames", "false");
+  stack.Install (nodes);
+
+  Ptr<Node> node = nodes.Get (0);
+  Ptr<ForwardingStrategy> fw = node->GetObject<ForwardingStrategy> ();
+  Ptr<Face> linkFace = node->GetObject<L3Protocol> ()->GetFaceByNetDevice (link.Get (0));
+
+  // Filled before the tracer is connected
+  fw->GetPDUBuffer ()->AddDestination (NNNAddress ("c"));
+
+  ostringstream trace;
+  boost::shared_ptr<std::ostream> stream (&trace, NullDeleter);
+  Ptr<TableSizeTracer> tracer = TableSizeTracer::Install (node, stream, Seconds (0.5));
+
+  // Filled once the tracer is connected
+  fw->SetNode3NName (Create<const NNNAddress> ("a"), Seconds (10), true);
+  node->GetObject<NNST> ()->Add (NNNAddress ("b"), linkFace, link.Get (1)->GetAddress (), Seconds (10), 1);
+
+  Simulator::Schedule (Seconds (0.9), &CheckTracer, node, tracer);
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+
+  Check (trace.str ().find ("\tPDUBuffer\t1\t") != string::npos, "TableSizeTracer", "PDUBuffer not written");
+  Check (trace.str ().find ("\tPITNames\t0\t0\n") != string::npos, "TableSizeTracer", "PIT 3N names not written");
+
+  // The tracer outlives the tables, which trace their sizes as they are disposed
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "All tables traced their entries and bytes" << endl;
+  else
+    cout << errors << " checks failed" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-trie-alloc-benchmark.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-trie-alloc-benchmark.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-trie-alloc-benchmark.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Compares the insert/erase throughput of nnnSIM::trie with the global heap
+ *  and with the per table slab allocator, using 3N names like the ones the
+ *  NNST and the PDU buffers hold.
+ */
+
+// Standard C++ modules
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+#include "nnnSIM/utils/trie/trie-with-policy.h"
+#include "nnnSIM/utils/trie/counting-policy.h"
+#include "nnnSIM/utils/trie/trie-allocator.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+template<class Allocator>
+double
+Churn (const vector<NNNAddress> &names, uint32_t rounds)
+{
+  typedef nnnSIM::trie_with_policy<
+      NNNAddress,
+      nnnSIM::pointer_payload_traits<uint32_t>,
+      nnnSIM::counting_policy_traits,
+      Allocator> table;
+
+  table t;
+  vector<uint32_t> payloads (names.size ());
+
+  clock_t start = clock ();
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      for (size_t i = 0; i < names.size (); i++)
+	t.insert (names[i], &payloads[i]);
+
+      // Expire every other name, then the rest, so prune runs on partially used levels
+      for (size_t i = 0; i < names.size (); i += 2)
+	t.erase (names[i]);
+      for (size_t i = 1; i < names.size (); i += 2)
+	t.erase (names[i]);
+    }
+  double secs = double (clock () - start) / CLOCKS_PER_SEC;
+
+  if (t.getPolicy ().size () != 0)
+    cout << "ERROR: " << Allocator::GetName () << " table not empty after churn" << endl;
+
+  return secs;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t sectors = 16;
+  uint32_t nodes = 4096;
+  uint32_t rounds = 20;
+
+  CommandLine cmd;
+  cmd.AddValue ("sectors", "Number of first level sectors", sectors);
+  cmd.AddValue ("nodes", "Number of names under each sector", nodes);
+  cmd.AddValue ("rounds", "Number of insert/erase rounds", rounds);
+  cmd.Parse (argc, argv);
+
+  // Names of the form sector.subsector.node, as given out by the producers
+  vector<NNNAddress> names;
+  for (uint32_t s = 0; s < sectors; s++)
+    for (uint32_t n = 0; n < nodes; n++)
+      {
+	ostringstream os;
+	os << hex << s << "." << (n % 64) << "." << n;
+	names.push_back (NNNAddress (os.str ()));
+      }
+
+  uint64_t ops = 2 * uint64_t (names.size ()) * rounds;
+
+  double heap = Churn<nnnSIM::trie_heap_allocator> (names, rounds);
+  double slab = Churn<nnnSIM::trie_slab_allocator> (names, rounds);
+
+  cout << names.size () << " names, " << rounds << " rounds, " << ops << " operations" << endl;
+  cout << "Heap: " << heap << " s (" << ops / heap << " ops/s)" << endl;
+  cout << "Slab: " << slab << " s (" << ops / slab << " ops/s)" << endl;
+
+  return 0;
+}
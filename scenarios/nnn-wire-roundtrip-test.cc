@@ -0,0 +1,452 @@
+/* -*- Mode:C++; c-file-style:"gnu" -*- */
+/*
+ * Copyright 2015 Waseda University, Sato Laboratory
+ *   Author: Jairo Eduardo Lopez <jairo@ruri.waseda.jp>
+ *
+ *  nnn-wire-roundtrip-test.cc is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  nnn-wire-roundtrip-test.cc is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero Public License
+ *  along with nnn-wire-roundtrip-test.cc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  Encodes every 3N PDU type, with no, one and two PoAs, names of
+ *  different lengths and payloads, through the nnnSIM wire codecs and
+ *  compares the bytes with an encoder written out field by field, as
+ *  the per PDU codecs did before the wire format was described by
+ *  schema entries. Decoding the bytes has to give back a PDU that
+ *  encodes the same, and a codec given a PDU of another type has to
+ *  throw.
+ */
+
+// Standard C++ modules
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ns3 modules
+#include <ns3-dev/ns3/core-module.h>
+#include <ns3-dev/ns3/network-module.h>
+
+// Extensions
+#include "nnnSIM/nnnSIM-module.h"
+
+using namespace ns3;
+using namespace std;
+using namespace nnn;
+
+uint32_t errors = 0;
+uint32_t checks = 0;
+
+/**
+ * Little endian nnnSIM encoding of a PDU, one field at a time
+ */
+class Reference
+{
+public:
+  Reference (Ptr<const NNNPDU> pdu)
+  {
+    U32 (pdu->GetPacketId ());
+    U16 (static_cast<uint16_t> (pdu->GetLifetime ().ToInteger (Time::S)));
+    U16 (pdu->GetVersion ());
+    // Packet length, known once all the fields are in
+    U16 (0);
+  }
+
+  void
+  U8 (uint8_t value)
+  {
+    m_bytes.push_back (value);
+  }
+
+  void
+  U16 (uint16_t value)
+  {
+    U8 (value & 0xff);
+    U8 (value >> 8);
+  }
+
+  void
+  U32 (uint32_t value)
+  {
+    U16 (value & 0xffff);
+    U16 (value >> 16);
+  }
+
+  void
+  U64 (uint64_t value)
+  {
+    U32 (value & 0xffffffff);
+    U32 (value >> 32);
+  }
+
+  void
+  Lease (Time lease)
+  {
+    U64 (static_cast<uint64_t> (lease.ToInteger (Time::S)));
+  }
+
+  void
+  Name (const NNNAddress &name)
+  {
+    uint16_t size = 0;
+    for (NNNAddress::const_iterator item = name.begin (); item != name.end (); item++)
+      size += 2 + item->size ();
+
+    U16 (size);
+    for (NNNAddress::const_iterator item = name.begin (); item != name.end (); item++)
+      {
+	U16 (item->size ());
+	const uint8_t *buf = reinterpret_cast<const uint8_t*> (item->buf ());
+	m_bytes.insert (m_bytes.end (), buf, buf + item->size ());
+      }
+  }
+
+  void
+  Poas (const vector<Address> &poas)
+  {
+    U16 (poas.size ());
+    for (size_t k = 0; k < poas.size (); k++)
+      {
+	uint8_t buffer[Address::MAX_SIZE + 2];
+	uint32_t size = poas[k].CopyAllTo (buffer, sizeof (buffer));
+	m_bytes.insert (m_bytes.end (), buffer, buffer + size);
+      }
+  }
+
+  vector<uint8_t>
+  Finish (Ptr<const Packet> payload = 0)
+  {
+    // The packet length covers the header, not the payload
+    m_bytes[8] = m_bytes.size () & 0xff;
+    m_bytes[9] = m_bytes.size () >> 8;
+
+    if (payload)
+      {
+	vector<uint8_t> data (payload->GetSize ());
+	if (!data.empty ())
+	  payload->CopyData (&data[0], data.size ());
+	m_bytes.insert (m_bytes.end (), data.begin (), data.end ());
+      }
+
+    return m_bytes;
+  }
+
+private:
+  vector<uint8_t> m_bytes;
+};
+
+template <class T>
+vector<Address>
+GetPoas (Ptr<const T> pdu)
+{
+  vector<Address> poas;
+  for (uint32_t k = 0; k < pdu->GetNumPoa (); k++)
+    poas.push_back (pdu->GetOnePoa (k));
+  return poas;
+}
+
+vector<Address>
+GetPersonalPoas (Ptr<const OEN> pdu)
+{
+  vector<Address> poas;
+  for (uint32_t k = 0; k < pdu->GetPersonalNumPoa (); k++)
+    poas.push_back (pdu->GetPersonalOnePoa (k));
+  return poas;
+}
+
+// The fields of each PDU type, in the order the per PDU codecs wrote them
+
+vector<uint8_t>
+Expected (Ptr<const NULLp> pdu)
+{
+  Reference r (pdu);
+  r.U16 (pdu->GetPDUPayloadType ());
+  return r.Finish (pdu->GetPayload ());
+}
+
+vector<uint8_t>
+Expected (Ptr<const SO> pdu)
+{
+  Reference r (pdu);
+  r.U16 (pdu->GetPDUPayloadType ());
+  r.Name (pdu->GetName ());
+  return r.Finish (pdu->GetPayload ());
+}
+
+vector<uint8_t>
+Expected (Ptr<const DO> pdu)
+{
+  Reference r (pdu);
+  r.U16 (pdu->GetPDUPayloadType ());
+  r.Name (pdu->GetName ());
+  return r.Finish (pdu->GetPayload ());
+}
+
+vector<uint8_t>
+Expected (Ptr<const DU> pdu)
+{
+  Reference r (pdu);
+  r.U16 (pdu->GetPDUPayloadType ());
+  r.Name (pdu->GetSrcName ());
+  r.Name (pdu->GetDstName ());
+  return r.Finish (pdu->GetPayload ());
+}
+
+vector<uint8_t>
+Expected (Ptr<const EN> pdu)
+{
+  Reference r (pdu);
+  r.Poas (GetPoas (pdu));
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Expected (Ptr<const AEN> pdu)
+{
+  Reference r (pdu);
+  r.Poas (GetPoas (pdu));
+  r.Lease (pdu->GetLeasetime ());
+  r.Name (pdu->GetName ());
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Expected (Ptr<const REN> pdu)
+{
+  Reference r (pdu);
+  r.Poas (GetPoas (pdu));
+  r.Lease (pdu->GetRemainLease ());
+  r.Name (pdu->GetName ());
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Expected (Ptr<const DEN> pdu)
+{
+  Reference r (pdu);
+  r.Poas (GetPoas (pdu));
+  r.Name (pdu->GetName ());
+  // Only a DEN with a predicted next sector carries it
+  if (pdu->HasNextSector ())
+    r.Name (pdu->GetNextSector ());
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Expected (Ptr<const OEN> pdu)
+{
+  Reference r (pdu);
+  r.Poas (GetPoas (pdu));
+  r.Lease (pdu->GetLeasetime ());
+  r.Name (pdu->GetName ());
+  r.Poas (GetPersonalPoas (pdu));
+  r.Name (pdu->GetSrcName ());
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Expected (Ptr<const INF> pdu)
+{
+  Reference r (pdu);
+  r.Lease (pdu->GetRemainLease ());
+  r.Name (pdu->GetOldName ());
+  r.Name (pdu->GetNewName ());
+  return r.Finish ();
+}
+
+vector<uint8_t>
+Bytes (Ptr<const Packet> packet)
+{
+  vector<uint8_t> bytes (packet->GetSize ());
+  packet->CopyData (&bytes[0], bytes.size ());
+  return bytes;
+}
+
+void
+Compare (const string &what, const vector<uint8_t> &got, const vector<uint8_t> &expected)
+{
+  checks++;
+  if (got == expected)
+    return;
+
+  errors++;
+  cout << "ERROR: " << what << ": " << got.size () << " bytes, expected " << expected.size () << endl;
+  for (size_t k = 0; k < got.size () && k < expected.size (); k++)
+    {
+      if (got[k] != expected[k])
+	{
+	  cout << "  first difference at byte " << k << ": " << uint32_t (got[k])
+	      << " instead of " << uint32_t (expected[k]) << endl;
+	  break;
+	}
+    }
+}
+
+// Encodes pdu with Codec, checks the bytes and decodes them back
+template <class Codec>
+void
+Check (const string &what, Ptr<typename Codec::PDU> pdu)
+{
+  Ptr<const typename Codec::PDU> original = pdu;
+  vector<uint8_t> expected = Expected (original);
+
+  Ptr<Packet> packet = Codec::ToWire (pdu);
+  Compare (what + " encoding", Bytes (packet), expected);
+
+  // Encoded twice from the cached wire
+  Compare (what + " cached encoding", Bytes (Codec::ToWire (pdu)), expected);
+
+  Ptr<const typename Codec::PDU> decoded = Codec::FromWire (packet);
+  Compare (what + " decoding", Expected (decoded), expected);
+}
+
+int main (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.Parse (argc, argv);
+
+  vector<Ptr<NNNAddress> > names;
+  names.push_back (Create<NNNAddress> ("1"));
+  names.push_back (Create<NNNAddress> ("ae.34.24"));
+  names.push_back (Create<NNNAddress> ("45.34.76.1f.3.ffff"));
+
+  vector<Address> poas;
+  poas.push_back (Mac48Address ("01:B2:03:04:05:06"));
+  poas.push_back (Mac48Address ("0a:0b:0c:0d:0e:0f"));
+
+  uint8_t bytes[300];
+  for (uint32_t k = 0; k < sizeof (bytes); k++)
+    bytes[k] = k * 7;
+
+  vector<Ptr<Packet> > payloads;
+  payloads.push_back (Create<Packet> ());
+  payloads.push_back (Create<Packet> (bytes, 1));
+  payloads.push_back (Create<Packet> (bytes, sizeof (bytes)));
+
+  // Variant v has v PoAs, name v, payload v, and different times
+  for (uint32_t v = 0; v < 3; v++)
+    {
+      Ptr<NNNAddress> name = names[v];
+      Ptr<NNNAddress> other = names[(v + 1) % names.size ()];
+      Time ttl = Seconds (5 + 10 * v);
+      Time lease = Seconds (100 * v + 1);
+      uint16_t payloadType = (v % 2 == 0) ? NDN_NNN : 0x1234;
+
+      ostringstream variant;
+      variant << " with " << v << " PoAs";
+      string with = variant.str ();
+
+      Ptr<NULLp> nullp_p = Create<NULLp> ();
+      nullp_p->SetLifetime (ttl);
+      nullp_p->SetPayload (payloads[v]);
+      nullp_p->SetPDUPayloadType (payloadType);
+      Check<wire::nnnSIM::NULLp> ("NULLp" + with, nullp_p);
+
+      Ptr<SO> so_p = Create<SO> ();
+      so_p->SetLifetime (ttl);
+      so_p->SetName (name);
+      so_p->SetPayload (payloads[v]);
+      so_p->SetPDUPayloadType (payloadType);
+      Check<wire::nnnSIM::SO> ("SO" + with, so_p);
+
+      Ptr<DO> do_p = Create<DO> ();
+      do_p->SetLifetime (ttl);
+      do_p->SetName (name);
+      do_p->SetPayload (payloads[v]);
+      do_p->SetPDUPayloadType (payloadType);
+      Check<wire::nnnSIM::DO> ("DO" + with, do_p);
+
+      Ptr<DU> du_p = Create<DU> ();
+      du_p->SetLifetime (ttl);
+      du_p->SetSrcName (name);
+      du_p->SetDstName (other);
+      du_p->SetPayload (payloads[v]);
+      du_p->SetPDUPayloadType (payloadType);
+      Check<wire::nnnSIM::DU> ("DU" + with, du_p);
+
+      Ptr<EN> en_p = Create<EN> ();
+      en_p->SetLifetime (ttl);
+      for (uint32_t k = 0; k < v && k < poas.size (); k++)
+	en_p->AddPoa (poas[k]);
+      Check<wire::nnnSIM::EN> ("EN" + with, en_p);
+
+      Ptr<AEN> aen_p = Create<AEN> ();
+      aen_p->SetLifetime (ttl);
+      aen_p->SetName (name);
+      aen_p->SetLeasetime (lease);
+      for (uint32_t k = 0; k < v && k < poas.size (); k++)
+	aen_p->AddPoa (poas[k]);
+      Check<wire::nnnSIM::AEN> ("AEN" + with, aen_p);
+
+      Ptr<REN> ren_p = Create<REN> ();
+      ren_p->SetLifetime (ttl);
+      ren_p->SetName (name);
+      ren_p->SetRemainLease (lease);
+      for (uint32_t k = 0; k < v && k < poas.size (); k++)
+	ren_p->AddPoa (poas[k]);
+      Check<wire::nnnSIM::REN> ("REN" + with, ren_p);
+
+      Ptr<DEN> den_p = Create<DEN> ();
+      den_p->SetLifetime (ttl);
+      den_p->SetName (name);
+      for (uint32_t k = 0; k < v && k < poas.size (); k++)
+	den_p->AddPoa (poas[k]);
+      // Without a predicted next sector the DEN is encoded as it always was
+      if (v > 0)
+	den_p->SetNextSector (other);
+      Check<wire::nnnSIM::DEN> ("DEN" + with, den_p);
+
+      // Personal PoAs in the other order, so both lists are checked
+      Ptr<OEN> oen_p = Create<OEN> ();
+      oen_p->SetLifetime (ttl);
+      oen_p->SetName (name);
+      oen_p->SetSrcName (other);
+      oen_p->SetLeasetime (lease);
+      for (uint32_t k = 0; k < v && k < poas.size (); k++)
+	{
+	  oen_p->AddPoa (poas[k]);
+	  oen_p->AddPersonalPoa (poas[poas.size () - 1 - k]);
+	}
+      Check<wire::nnnSIM::OEN> ("OEN" + with, oen_p);
+
+      Ptr<INF> inf_p = Create<INF> ();
+      inf_p->SetLifetime (ttl);
+      inf_p->SetOldName (name);
+      inf_p->SetNewName (other);
+      inf_p->SetRemainLease (lease);
+      Check<wire::nnnSIM::INF> ("INF" + with, inf_p);
+    }
+
+  // A codec has to refuse a PDU of another type
+  Ptr<DO> do_p = Create<DO> ();
+  do_p->SetName (names[1]);
+  do_p->SetPayload (payloads[1]);
+  checks++;
+  try
+    {
+      wire::nnnSIM::SO::FromWire (wire::nnnSIM::DO::ToWire (do_p));
+      cout << "ERROR: SO codec decoded a DO" << endl;
+      errors++;
+    }
+  catch (SOException *e)
+    {
+      delete e;
+    }
+
+  Simulator::Destroy ();
+
+  if (errors == 0)
+    cout << "All " << checks << " wire encoding checks passed" << endl;
+  else
+    cout << errors << " of " << checks << " checks failed" << endl;
+
+  return errors == 0 ? 0 : 1;
+}
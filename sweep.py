@@ -0,0 +1,298 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Parameter sweep driver for the scenarios in ./scenarios
+#
+# A sweep is described by a JSON spec such as:
+#
+# {
+#     "scenario": "nnn-icc-mobility",
+#     "mode": "grid",
+#     "params": {
+#         "speed": [1.40, 2.80, 5.60, 11.20],
+#         "3n": [true],
+#         "producer": [true, false]
+#     },
+#     "fixed": { "trace": true },
+#     "runs": [1, 2, 3]
+# }
+#
+# "mode" can be "grid" (full cartesian product, default) or "random" in
+# which case "samples" combinations are drawn from the grid using "seed".
+# "runs" are the ns-3 RNG run numbers (passed as --RngRun) to use for
+# every combination.
+#
+# Every run gets its own directory under the output directory, which is
+# passed to the scenario as --results. Completed runs are appended to
+# manifest.jsonl, so an interrupted sweep can be restarted with the same
+# spec and only the missing runs will be executed. Once all runs have
+# finished, index.csv merges the manifest into one table.
+
+from __future__ import print_function
+
+import argparse
+import csv
+import hashlib
+import itertools
+import json
+import multiprocessing
+import os
+import random
+import subprocess
+import sys
+import threading
+import time
+
+try:
+    import Queue as queue
+except ImportError:
+    import queue
+
+######################################################################
+######################################################################
+######################################################################
+
+parser = argparse.ArgumentParser(description='Simulation parameter sweep runner')
+parser.add_argument('spec', metavar='spec', type=str,
+                    help='JSON file describing the sweep')
+
+parser.add_argument('-o', '--output', dest="output", type=str, default="results/sweep",
+                    help='Directory in which to place the per run directories (results/sweep by default)')
+
+parser.add_argument('-j', '--jobs', dest="jobs", type=int, default=multiprocessing.cpu_count (),
+                    help='Number of simultaneous simulations (number of cores by default)')
+
+parser.add_argument('-q', '--queue', dest="queue", type=int, default=0,
+                    help='Maximum number of queued runs (2 x jobs by default)')
+
+parser.add_argument('-b', '--build', dest="build", type=str, default="./build",
+                    help='Directory containing the compiled scenarios (./build by default)')
+
+parser.add_argument('-n', '--dry-run', dest="dry", action='store_true', default=False,
+                    help='Only print the command lines that would be executed')
+
+parser.add_argument('-r', '--retry-failed', dest="retry", action='store_true', default=False,
+                    help='Execute again runs that are recorded as failed in the manifest')
+
+args = parser.parse_args()
+
+######################################################################
+######################################################################
+######################################################################
+
+class Sweep:
+    "Expands a sweep specification into the list of runs to execute"
+    def __init__ (self, spec):
+        self.scenario = spec["scenario"]
+        self.mode = spec.get ("mode", "grid")
+        self.params = spec.get ("params", {})
+        self.fixed = spec.get ("fixed", {})
+        self.runs = spec.get ("runs", [1])
+        self.samples = spec.get ("samples", 0)
+        self.seed = spec.get ("seed", 0)
+
+        if self.mode not in ("grid", "random"):
+            raise ValueError ("Unknown sweep mode: %s" % self.mode)
+
+        if self.mode == "random" and self.samples <= 0:
+            raise ValueError ("A random sweep needs a positive number of samples")
+
+    def combinations (self):
+        keys = sorted (self.params.keys ())
+        values = [self.params[k] for k in keys]
+        grid = [dict (zip (keys, combo)) for combo in itertools.product (*values)]
+
+        if self.mode == "random" and self.samples < len (grid):
+            rng = random.Random (self.seed)
+            grid = rng.sample (grid, self.samples)
+
+        return grid
+
+    def expand (self):
+        jobs = []
+        for combo in self.combinations ():
+            for run in self.runs:
+                params = dict (self.fixed)
+                params.update (combo)
+                jobs.append (Run (self.scenario, params, run))
+        return jobs
+
+class Run:
+    "A single execution of a scenario with a set of parameters"
+    def __init__ (self, scenario, params, run):
+        self.scenario = scenario
+        self.params = params
+        self.run = run
+
+    def key (self):
+        # Stable identifier, independent of dictionary ordering
+        desc = json.dumps ([self.scenario, self.params, self.run], sort_keys=True)
+        return hashlib.sha1 (desc.encode ("utf-8")).hexdigest ()[:12]
+
+    def directory (self, output):
+        return os.path.join (output, "%s-run%03d-%s" % (self.scenario, self.run, self.key ()))
+
+    def cmdline (self, build, output):
+        cmdline = [os.path.join (build, self.scenario)]
+        for name in sorted (self.params.keys ()):
+            value = self.params[name]
+            # ns-3 CommandLine boolean flags are enabled with just --flag,
+            # and need an explicit value to turn off those that default to true
+            if value is True:
+                cmdline.append ("--%s" % name)
+            elif value is False:
+                cmdline.append ("--%s=false" % name)
+            else:
+                cmdline.append ("--%s=%s" % (name, value))
+        cmdline.append ("--RngRun=%d" % self.run)
+        cmdline.append ("--results=%s" % self.directory (output))
+        return cmdline
+
+class Manifest:
+    "Append only record of the runs of a sweep, used to resume"
+    def __init__ (self, path):
+        self.path = path
+        self.lock = threading.Lock ()
+        self.entries = {}
+
+        if os.path.exists (path):
+            with open (path) as f:
+                for line in f:
+                    line = line.strip ()
+                    if not line:
+                        continue
+                    try:
+                        entry = json.loads (line)
+                    except ValueError:
+                        # Partially written line from an interrupted sweep
+                        continue
+                    self.entries[entry["key"]] = entry
+
+    def done (self, run, retry):
+        entry = self.entries.get (run.key ())
+        if entry is None:
+            return False
+        return entry["status"] == 0 or not retry
+
+    def record (self, entry):
+        with self.lock:
+            self.entries[entry["key"]] = entry
+            with open (self.path, "a") as f:
+                f.write (json.dumps (entry, sort_keys=True) + "\n")
+                f.flush ()
+                os.fsync (f.fileno ())
+
+    def write_index (self, path):
+        params = set ()
+        for entry in self.entries.values ():
+            params.update (entry["params"].keys ())
+        params = sorted (params)
+
+        with open (path, "w") as f:
+            writer = csv.writer (f)
+            writer.writerow (["key", "scenario", "run"] + params + ["status", "seconds", "directory"])
+            for entry in sorted (self.entries.values (), key=lambda e: (e["scenario"], e["run"], e["key"])):
+                row = [entry["key"], entry["scenario"], entry["run"]]
+                row += [entry["params"].get (p, "") for p in params]
+                row += [entry["status"], "%.3f" % entry["seconds"], entry["directory"]]
+                writer.writerow (row)
+
+######################################################################
+######################################################################
+######################################################################
+
+class Worker (threading.Thread):
+    "Pulls runs from the bounded queue and executes them one at a time"
+    def __init__ (self, work, manifest):
+        threading.Thread.__init__ (self)
+        self.daemon = True
+        self.work = work
+        self.manifest = manifest
+
+    def run (self):
+        while True:
+            run = self.work.get ()
+            try:
+                if run is None:
+                    return
+                self.simulate (run)
+            finally:
+                self.work.task_done ()
+
+    def simulate (self, run):
+        directory = run.directory (args.output)
+        if not os.path.isdir (directory):
+            os.makedirs (directory)
+
+        cmdline = run.cmdline (args.build, args.output)
+        print (" ".join (cmdline))
+
+        with open (os.path.join (directory, "params.json"), "w") as f:
+            json.dump ({"scenario": run.scenario, "params": run.params, "run": run.run,
+                        "cmdline": cmdline}, f, sort_keys=True, indent=2)
+
+        start = time.time ()
+        with open (os.path.join (directory, "stdout.log"), "w") as out:
+            with open (os.path.join (directory, "stderr.log"), "w") as err:
+                try:
+                    status = subprocess.call (cmdline, stdout=out, stderr=err)
+                except OSError as e:
+                    err.write ("%s\n" % e)
+                    status = -1
+        elapsed = time.time () - start
+
+        if status != 0:
+            print ("FAILED (%d): %s" % (status, directory))
+
+        self.manifest.record ({"key": run.key (), "scenario": run.scenario,
+                               "params": run.params, "run": run.run,
+                               "status": status, "seconds": elapsed,
+                               "directory": directory})
+
+######################################################################
+######################################################################
+######################################################################
+
+with open (args.spec) as f:
+    sweep = Sweep (json.load (f))
+
+runs = sweep.expand ()
+
+if args.dry:
+    for run in runs:
+        print (" ".join (run.cmdline (args.build, args.output)))
+    exit (0)
+
+if not os.path.isdir (args.output):
+    os.makedirs (args.output)
+
+manifest = Manifest (os.path.join (args.output, "manifest.jsonl"))
+pending = [run for run in runs if not manifest.done (run, args.retry)]
+
+print ("Sweep of %s: %d runs, %d already done, %d to execute with %d jobs" %
+       (sweep.scenario, len (runs), len (runs) - len (pending), len (pending), args.jobs))
+
+jobs = max (1, args.jobs)
+# Bounded queue so huge sweeps do not build all their jobs in memory at once
+work = queue.Queue (maxsize = args.queue if args.queue > 0 else 2 * jobs)
+workers = [Worker (work, manifest) for i in range (jobs)]
+
+for worker in workers:
+    worker.start ()
+
+try:
+    for run in pending:
+        work.put (run)
+    for worker in workers:
+        work.put (None)
+    for worker in workers:
+        # Poll so that Ctrl-C is delivered to the main thread
+        while worker.is_alive ():
+            worker.join (1)
+finally:
+    manifest.write_index (os.path.join (args.output, "index.csv"))
+
+failed = [e for e in manifest.entries.values () if e["status"] != 0]
+if failed:
+    print ("%d runs failed, see %s" % (len (failed), os.path.join (args.output, "index.csv")))
+    sys.exit (1)